@@ -0,0 +1,134 @@
+/**
+ * @file Tests/CommandOptimizer.cpp
+ * @brief Unit tests for CommandOptimizer
+ * @date 2026-10-16
+ */
+
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_test_macros.hpp>
+#include <Vkd/Buffer/Buffer.hpp>
+#include <Vkd/CommandBuffer/CommandBuffer.hpp>
+#include <Vkd/CommandBuffer/CommandOptimizer.hpp>
+#include <Vkd/CommandPool/CommandArena.hpp>
+#include <Vkd/DeviceMemory/DeviceMemory.hpp>
+#include <mimalloc.h>
+
+using namespace vkd;
+
+namespace
+{
+	void* VKAPI_PTR TestAllocation(void* /*userData*/, std::size_t size, std::size_t alignment, VkSystemAllocationScope /*scope*/)
+	{
+		return mi_malloc_aligned(size, alignment);
+	}
+
+	void VKAPI_PTR TestFree(void* /*userData*/, void* memory)
+	{
+		mi_free(memory);
+	}
+
+	constexpr VkAllocationCallbacks TestAllocationCallbacks = {
+		.pUserData = nullptr,
+		.pfnAllocation = TestAllocation,
+		.pfnReallocation = nullptr,
+		.pfnFree = TestFree,
+		.pfnInternalAllocation = nullptr,
+		.pfnInternalFree = nullptr};
+
+	class TestMemory : public DeviceMemory
+	{
+	public:
+		VkResult Map(VkDeviceSize /*offset*/, VkDeviceSize /*size*/, void** /*ppData*/) override
+		{
+			return VK_ERROR_MEMORY_MAP_FAILED;
+		}
+
+		void Unmap() override
+		{
+		}
+	};
+
+	/// Two buffers in separate allocations and a stream recording copies between them
+	struct CopyStream
+	{
+		CopyStream()
+		{
+			Arena.SetAllocationCallbacks(TestAllocationCallbacks);
+			Stream.SetArena(Arena);
+			Src.BindBufferMemory(SrcMemory, 0);
+			Dst.BindBufferMemory(DstMemory, 0);
+		}
+
+		void PushCopy(VkDeviceSize offset, VkDeviceSize size)
+		{
+			const VkBufferCopy region = {.srcOffset = offset, .dstOffset = offset, .size = size};
+			auto op = Stream.Emplace<Buffer::OpCopy>(CommandBuffer::OpType<Buffer::OpCopy>, CommandStream::InlineSize<VkBufferCopy>(1));
+			REQUIRE(static_cast<bool>(op));
+			op->src = &Src;
+			op->dst = &Dst;
+			op->regions = op.Append(&region, 1);
+		}
+
+		template<typename T>
+		void Push(const T& value)
+		{
+			auto op = Stream.Emplace<T>(CommandBuffer::OpType<T>);
+			REQUIRE(static_cast<bool>(op));
+			*op = value;
+		}
+
+		TestMemory SrcMemory;
+		TestMemory DstMemory;
+		Buffer Src;
+		Buffer Dst;
+		CommandArena Arena;
+		CommandStream Stream;
+	};
+} // namespace
+
+TEST_CASE("CommandOptimizer - Merges contiguous copies across binds", "[commandoptimizer]")
+{
+	CopyStream copies;
+	copies.PushCopy(0, 64);
+	copies.Push(OpBindPipeline{.BindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS, .PipelineObject = nullptr});
+	copies.PushCopy(64, 64);
+
+	CommandOptimizer optimizer;
+	optimizer.Run(copies.Stream);
+
+	REQUIRE(optimizer.GetStats().MergedCopies == 1);
+	REQUIRE(copies.Stream.GetCommandCount() == 2);
+
+	const CommandHeader& first = *copies.Stream.begin();
+	REQUIRE(first.Type == CommandBuffer::OpType<Buffer::OpCopy>);
+	const auto& copy = *static_cast<const Buffer::OpCopy*>(first.GetPayload());
+	REQUIRE(copy.regions.size() == 1);
+	REQUIRE(copy.regions[0].size == 128);
+}
+
+TEST_CASE("CommandOptimizer - Keeps copies split by event commands", "[commandoptimizer]")
+{
+	CopyStream copies;
+	copies.PushCopy(0, 64);
+
+	SECTION("WaitEvents")
+	{
+		// The second copy may read data the host writes before setting the event
+		copies.Push(OpWaitEvents{.Events = {}, .SrcStageMask = VK_PIPELINE_STAGE_HOST_BIT, .DstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT});
+	}
+
+	SECTION("SetEvent")
+	{
+		// The host may read the first copy as soon as the event is set, not the second
+		copies.Push(OpSetEvent{.EventObject = nullptr, .StageMask = VK_PIPELINE_STAGE_TRANSFER_BIT});
+	}
+
+	copies.PushCopy(64, 64);
+
+	CommandOptimizer optimizer;
+	optimizer.Run(copies.Stream);
+
+	REQUIRE(optimizer.GetStats().MergedCopies == 0);
+	REQUIRE(optimizer.GetStats().MergedRegions == 0);
+	REQUIRE(copies.Stream.GetCommandCount() == 3);
+}
@@ -0,0 +1,65 @@
+/**
+ * @file Tests/Futex.cpp
+ * @brief Unit tests for Futex
+ * @date 2026-10-16
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_test_macros.hpp>
+#include <VkdUtils/Futex/Futex.hpp>
+
+using namespace vkd;
+
+TEST_CASE("Futex - Returns at once when the value differs", "[futex]")
+{
+	std::atomic<UInt32> word = 1;
+	REQUIRE(Futex::Wait(word, 0, Futex::Clock::now() + std::chrono::seconds(10)));
+}
+
+TEST_CASE("Futex - Times out", "[futex]")
+{
+	std::atomic<UInt32> word = 0;
+	const auto start = Futex::Clock::now();
+	const auto deadline = start + std::chrono::milliseconds(20);
+
+	while (Futex::Wait(word, 0, deadline))
+	{
+	}
+
+	REQUIRE(Futex::Clock::now() >= deadline);
+	REQUIRE_FALSE(Futex::Wait(word, 0, start));
+}
+
+TEST_CASE("Futex - Wakes a sleeping thread", "[futex]")
+{
+	std::atomic<UInt32> word = 0;
+	std::atomic<bool> woken = false;
+
+	std::thread waiter([&]()
+	{
+		while (word.load() == 0)
+			Futex::Wait(word, 0);
+		woken = true;
+	});
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	word.store(1);
+	Futex::WakeAll(word);
+	waiter.join();
+
+	REQUIRE(woken);
+}
+
+TEST_CASE("Futex - Deadline of a Vulkan timeout", "[futex]")
+{
+	REQUIRE(Futex::GetDeadline(UINT64_MAX) == Futex::Clock::time_point::max());
+
+	const auto before = Futex::Clock::now();
+	const auto deadline = Futex::GetDeadline(1'000'000);
+	REQUIRE(deadline >= before + std::chrono::milliseconds(1));
+	REQUIRE(deadline < Futex::Clock::time_point::max());
+}
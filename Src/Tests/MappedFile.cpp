@@ -0,0 +1,95 @@
+/**
+ * @file Tests/MappedFile.cpp
+ * @brief Unit tests for MappedFile
+ * @date 2026-10-16
+ */
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_test_macros.hpp>
+#include <VkdUtils/MappedFile/MappedFile.hpp>
+
+using namespace vkd;
+
+namespace
+{
+	std::string GetTestPath(const char* name)
+	{
+		return (std::filesystem::temp_directory_path() / name).string();
+	}
+} // namespace
+
+TEST_CASE("MappedFile - Create and reopen", "[mappedfile]")
+{
+	const std::string path = GetTestPath("vkd-mappedfile-test.bin");
+	const char message[] = "vkd mapped file";
+
+	{
+		MappedFile file;
+		REQUIRE(file.Create(path, 4096));
+		REQUIRE(file.IsOpen());
+		REQUIRE(file.IsWritable());
+		REQUIRE(file.GetSize() == 4096);
+
+		std::memcpy(file.GetData(), message, sizeof(message));
+		file.Close(sizeof(message));
+		REQUIRE_FALSE(file.IsOpen());
+	}
+
+	MappedFile file;
+	REQUIRE(file.Open(path));
+	REQUIRE_FALSE(file.IsWritable());
+	REQUIRE(file.GetSize() == sizeof(message));
+	REQUIRE(std::memcmp(file.GetData(), message, sizeof(message)) == 0);
+
+	file.Close();
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("MappedFile - Resize keeps contents", "[mappedfile]")
+{
+	const std::string path = GetTestPath("vkd-mappedfile-resize.bin");
+
+	MappedFile file;
+	REQUIRE(file.Create(path, 64));
+	for (std::size_t i = 0; i < 64; ++i)
+		file.GetData()[i] = static_cast<std::byte>(i);
+
+	REQUIRE(file.Resize(1024 * 1024));
+	REQUIRE(file.GetSize() == 1024 * 1024);
+	for (std::size_t i = 0; i < 64; ++i)
+		REQUIRE(file.GetData()[i] == static_cast<std::byte>(i));
+
+	file.GetData()[file.GetSize() - 1] = std::byte{0x42};
+	file.Close(file.GetSize());
+
+	REQUIRE(file.Open(path));
+	REQUIRE(file.GetSize() == 1024 * 1024);
+	REQUIRE(file.GetData()[file.GetSize() - 1] == std::byte{0x42});
+
+	file.Close();
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("MappedFile - Failure cases", "[mappedfile]")
+{
+	MappedFile file;
+	REQUIRE_FALSE(file.Open(GetTestPath("vkd-mappedfile-does-not-exist.bin")));
+	REQUIRE_FALSE(file.IsOpen());
+	REQUIRE_FALSE(file.Resize(16));
+
+	const std::string path = GetTestPath("vkd-mappedfile-empty.bin");
+	REQUIRE(file.Create(path, 0));
+	REQUIRE(file.GetSize() == 0);
+	file.Close(0);
+
+	REQUIRE(file.Open(path));
+	REQUIRE(file.GetSize() == 0);
+	REQUIRE_FALSE(file.Resize(16));
+
+	file.Close();
+	std::filesystem::remove(path);
+}
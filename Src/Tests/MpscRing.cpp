@@ -0,0 +1,83 @@
+/**
+ * @file Tests/MpscRing.cpp
+ * @brief Unit tests for MpscRing
+ * @date 2026-10-16
+ */
+
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_test_macros.hpp>
+#include <VkdUtils/MpscRing/MpscRing.hpp>
+
+using namespace vkd;
+
+TEST_CASE("MpscRing - Capacity is rounded up", "[mpscring]")
+{
+	MpscRing<int> ring(5);
+	REQUIRE(ring.GetCapacity() == 8);
+}
+
+TEST_CASE("MpscRing - Pops in push order and reports full", "[mpscring]")
+{
+	MpscRing<int> ring(4);
+	int value = 0;
+	REQUIRE_FALSE(ring.TryPop(value));
+
+	for (int lap = 0; lap < 3; ++lap)
+	{
+		for (int i = 0; i < 4; ++i)
+			REQUIRE(ring.TryPush(lap * 4 + i));
+		REQUIRE_FALSE(ring.TryPush(-1));
+
+		for (int i = 0; i < 4; ++i)
+		{
+			REQUIRE(ring.TryPop(value));
+			REQUIRE(value == lap * 4 + i);
+		}
+		REQUIRE_FALSE(ring.TryPop(value));
+	}
+}
+
+TEST_CASE("MpscRing - Concurrent producers", "[mpscring]")
+{
+	constexpr int ProducerCount = 4;
+	constexpr int ValuesPerProducer = 10000;
+
+	MpscRing<int> ring(64);
+	std::vector<std::thread> producers;
+	for (int producer = 0; producer < ProducerCount; ++producer)
+	{
+		producers.emplace_back([&ring, producer]()
+		{
+			for (int i = 0; i < ValuesPerProducer; ++i)
+			{
+				while (!ring.TryPush(producer * ValuesPerProducer + i))
+					std::this_thread::yield();
+			}
+		});
+	}
+
+	// Values of a given producer must come out in the order it pushed them
+	std::vector<int> next(ProducerCount, 0);
+	int received = 0;
+	while (received < ProducerCount * ValuesPerProducer)
+	{
+		int value;
+		if (!ring.TryPop(value))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		const int producer = value / ValuesPerProducer;
+		REQUIRE(value % ValuesPerProducer == next[producer]);
+		++next[producer];
+		++received;
+	}
+
+	for (std::thread& thread : producers)
+		thread.join();
+	int value;
+	REQUIRE_FALSE(ring.TryPop(value));
+}
@@ -0,0 +1,72 @@
+/**
+ * @file Tests/ScratchArena.cpp
+ * @brief Unit tests for ScratchArena
+ * @date 2026-10-16
+ */
+
+#include <cstdint>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_test_macros.hpp>
+#include <VkdUtils/ScratchArena/ScratchArena.hpp>
+
+using namespace vkd;
+
+TEST_CASE("ScratchArena - Aligned allocations", "[scratcharena]")
+{
+	ScratchArena arena(1024);
+	REQUIRE(arena.GetCapacity() == 1024);
+
+	void* a = arena.Allocate(3, 1);
+	void* b = arena.Allocate(16, 16);
+	REQUIRE(a != nullptr);
+	REQUIRE(b != nullptr);
+	REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 16 == 0);
+	REQUIRE(arena.GetUsed() == 32);
+
+	REQUIRE(arena.Allocate(8, 3) == nullptr);
+	REQUIRE(arena.Allocate(8, ScratchArena::BlockAlignment * 2) == nullptr);
+
+	std::span<UInt64> values = arena.AllocateArray<UInt64>(4);
+	REQUIRE(values.size() == 4);
+	REQUIRE(reinterpret_cast<std::uintptr_t>(values.data()) % alignof(UInt64) == 0);
+	REQUIRE(arena.AllocateArray<UInt64>(0).empty());
+}
+
+TEST_CASE("ScratchArena - Grows and merges blocks on reset", "[scratcharena]")
+{
+	ScratchArena arena;
+	REQUIRE(arena.GetBlockCount() == 0);
+
+	for (int i = 0; i < 4; ++i)
+		REQUIRE(arena.Allocate(ScratchArena::MinBlockSize) != nullptr);
+	REQUIRE(arena.GetBlockCount() > 1);
+	REQUIRE(arena.GetUsed() == 4 * ScratchArena::MinBlockSize);
+
+	const std::size_t capacity = arena.GetCapacity();
+	arena.Reset();
+	REQUIRE(arena.GetBlockCount() == 1);
+	REQUIRE(arena.GetCapacity() == capacity);
+	REQUIRE(arena.GetUsed() == 0);
+
+	// The same workload now fits in the merged block
+	for (int i = 0; i < 4; ++i)
+		REQUIRE(arena.Allocate(ScratchArena::MinBlockSize) != nullptr);
+	REQUIRE(arena.GetBlockCount() == 1);
+	REQUIRE(arena.GetCapacity() == capacity);
+}
+
+TEST_CASE("ScratchArena - Move", "[scratcharena]")
+{
+	ScratchArena arena(256);
+	REQUIRE(arena.Allocate(64) != nullptr);
+
+	ScratchArena moved(std::move(arena));
+	REQUIRE(moved.GetCapacity() == 256);
+	REQUIRE(moved.GetUsed() == 64);
+	REQUIRE(arena.GetCapacity() == 0);
+	REQUIRE(arena.GetBlockCount() == 0);
+
+	REQUIRE(arena.Allocate(16) != nullptr);
+	REQUIRE(arena.GetCapacity() == ScratchArena::MinBlockSize);
+}
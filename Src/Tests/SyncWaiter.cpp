@@ -0,0 +1,213 @@
+/**
+ * @file Tests/SyncWaiter.cpp
+ * @brief Unit tests for SyncWaiter
+ * @date 2026-10-16
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <ranges>
+#include <thread>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_test_macros.hpp>
+#include <VkdUtils/SyncWaiter/SyncWaiter.hpp>
+
+using namespace vkd;
+
+namespace
+{
+	struct TestObject
+	{
+		std::atomic<bool> Signaled = false;
+		SyncWaiterList Waiters;
+
+		void Signal()
+		{
+			Signaled.store(true);
+			Waiters.NotifyAll();
+		}
+	};
+
+	struct CallbackWaiter : SyncWaiter
+	{
+		explicit CallbackWaiter(TestObject& object) :
+			SyncWaiter(Callbacks),
+			Object(&object)
+		{
+		}
+
+		static bool IsReady(SyncWaiter& waiter)
+		{
+			CallbackWaiter& self = static_cast<CallbackWaiter&>(waiter);
+			++self.Evaluations;
+			return self.Object->Signaled.load();
+		}
+
+		static void Resume(SyncWaiter& waiter)
+		{
+			CallbackWaiter& self = static_cast<CallbackWaiter&>(waiter);
+			++self.Resumes;
+			// Outside of the lock, registering again does not deadlock
+			self.Object->Waiters.Add(self);
+			self.Object->Waiters.Remove(self);
+		}
+
+		static constexpr SyncWaiterCallbacks Callbacks = {&IsReady, &Resume};
+
+		TestObject* Object;
+		int Evaluations = 0;
+		int Resumes = 0;
+	};
+} // namespace
+
+TEST_CASE("SyncWaiter - Wait any wakes on the first signal", "[syncwaiter]")
+{
+	std::array<TestObject, 4> objects;
+	SyncWaiter waiter;
+	for (TestObject& object : objects)
+		object.Waiters.Add(waiter);
+
+	std::thread signaler([&]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		objects[2].Signal();
+	});
+
+	bool any = false;
+	while (!any)
+	{
+		const UInt32 epoch = waiter.GetEpoch();
+		for (const TestObject& object : objects)
+			any |= object.Signaled.load();
+		if (!any)
+			REQUIRE(waiter.Wait(epoch, Futex::Clock::now() + std::chrono::seconds(10)));
+	}
+	signaler.join();
+
+	for (TestObject& object : objects)
+		object.Waiters.Remove(waiter);
+	REQUIRE(objects[2].Signaled);
+}
+
+TEST_CASE("SyncWaiter - Wait all across threads", "[syncwaiter]")
+{
+	std::array<TestObject, 8> objects;
+	SyncWaiter waiter;
+	for (TestObject& object : objects)
+		object.Waiters.Add(waiter);
+
+	std::array<std::thread, 8> signalers;
+	for (std::size_t i = 0; i < signalers.size(); ++i)
+		signalers[i] = std::thread([&objects, i]() { objects[i].Signal(); });
+
+	while (true)
+	{
+		const UInt32 epoch = waiter.GetEpoch();
+		bool all = true;
+		for (const TestObject& object : objects)
+			all &= object.Signaled.load();
+		if (all)
+			break;
+		REQUIRE(waiter.Wait(epoch, Futex::Clock::now() + std::chrono::seconds(10)));
+	}
+
+	for (std::thread& signaler : signalers)
+		signaler.join();
+	for (TestObject& object : objects)
+		object.Waiters.Remove(waiter);
+}
+
+TEST_CASE("SyncWaiter - Times out without notification", "[syncwaiter]")
+{
+	TestObject object;
+	SyncWaiter waiter;
+	object.Waiters.Add(waiter);
+
+	const auto deadline = Futex::Clock::now() + std::chrono::milliseconds(10);
+	const UInt32 epoch = waiter.GetEpoch();
+	while (waiter.Wait(epoch, deadline))
+	{
+	}
+	REQUIRE(Futex::Clock::now() >= deadline);
+
+	object.Waiters.Remove(waiter);
+	object.Signal();
+	REQUIRE(waiter.GetEpoch() == epoch);
+}
+
+TEST_CASE("SyncWaiter - Callback waiters are unregistered once ready", "[syncwaiter]")
+{
+	TestObject object;
+	CallbackWaiter waiter(object);
+	object.Waiters.Add(waiter);
+
+	object.Waiters.NotifyAll();
+	REQUIRE(waiter.Evaluations == 1);
+	REQUIRE(waiter.Resumes == 0);
+
+	object.Signal();
+	REQUIRE(waiter.Evaluations == 2);
+	REQUIRE(waiter.Resumes == 1);
+
+	// No longer registered
+	object.Signal();
+	REQUIRE(waiter.Evaluations == 2);
+	REQUIRE(waiter.Resumes == 1);
+}
+
+TEST_CASE("SyncWaiter - WaitForSignalers waits for signal scopes", "[syncwaiter]")
+{
+	TestObject object;
+	std::atomic<bool> inScope = false;
+	std::atomic<bool> left = false;
+
+	std::thread signaler([&]()
+	{
+		SyncWaiterList::SignalScope scope(object.Waiters);
+		inScope.store(true);
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		left.store(true);
+	});
+
+	while (!inScope.load())
+		std::this_thread::yield();
+	object.Waiters.WaitForSignalers();
+	REQUIRE(left.load());
+
+	signaler.join();
+}
+
+TEST_CASE("SyncWaiter - WaitUntil over several lists", "[syncwaiter]")
+{
+	std::array<TestObject, 3> objects;
+	auto lists = objects | std::views::transform([](TestObject& object) -> SyncWaiterList&
+												 { return object.Waiters; });
+	auto anySignaled = [&objects]()
+	{
+		return std::ranges::any_of(objects, [](const TestObject& object)
+								   { return object.Signaled.load(); });
+	};
+
+	SECTION("Wakes on any of them")
+	{
+		std::thread signaler([&]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			objects[1].Signal();
+		});
+
+		REQUIRE(SyncWaiter::WaitUntil(lists, Futex::Clock::now() + std::chrono::seconds(5), anySignaled));
+		signaler.join();
+	}
+
+	SECTION("Times out")
+	{
+		REQUIRE_FALSE(SyncWaiter::WaitUntil(lists, Futex::Clock::now() + std::chrono::milliseconds(10), anySignaled));
+	}
+
+	// Every waiter was removed, a signal notifies nobody
+	objects[2].Signal();
+}
@@ -0,0 +1,103 @@
+/**
+ * @file Tests/System.cpp
+ * @brief Unit tests for System CPU topology discovery
+ * @date 2026-10-16
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <VkdUtils/System/System.hpp>
+
+using namespace vkd;
+
+namespace
+{
+	void WriteFile(const std::filesystem::path& path, const std::string& content)
+	{
+		std::filesystem::create_directories(path.parent_path());
+		std::ofstream(path) << content << '\n';
+	}
+} // namespace
+
+TEST_CASE("System - ParseCpuList", "[system]")
+{
+	REQUIRE(System::ParseCpuList("0-3,8,10-11") == std::vector<UInt32>{0, 1, 2, 3, 8, 10, 11});
+	REQUIRE(System::ParseCpuList("5") == std::vector<UInt32>{5});
+	REQUIRE(System::ParseCpuList("4,0-1\n") == std::vector<UInt32>{0, 1, 4});
+	REQUIRE(System::ParseCpuList("").empty());
+	REQUIRE(System::ParseCpuList("3-1").empty());
+	REQUIRE(System::ParseCpuList("a").empty());
+}
+
+TEST_CASE("System - ReadCpuTopology", "[system]")
+{
+	// Two packages of two cores with two hardware threads each, one NUMA node per package,
+	// core_id restarting at 0 in each package and the L2 shared by the SMT siblings
+	const std::filesystem::path root = std::filesystem::temp_directory_path() / "vkd-sysfs-test";
+	std::filesystem::remove_all(root);
+
+	for (UInt32 id = 0; id < 8; ++id)
+	{
+		const UInt32 package = id % 4 / 2;
+		const UInt32 firstSibling = id % 4;
+		const std::filesystem::path cpu = root / "cpu" / ("cpu" + std::to_string(id));
+
+		WriteFile(cpu / "topology" / "core_id", std::to_string(id % 2));
+		WriteFile(cpu / "topology" / "physical_package_id", std::to_string(package));
+		WriteFile(cpu / "topology" / "thread_siblings_list", std::to_string(firstSibling) + "," + std::to_string(firstSibling + 4));
+		std::filesystem::create_directories(cpu / ("node" + std::to_string(package)));
+
+		WriteFile(cpu / "cache" / "index0" / "level", "1");
+		WriteFile(cpu / "cache" / "index0" / "shared_cpu_list", std::to_string(firstSibling) + "," + std::to_string(firstSibling + 4));
+		WriteFile(cpu / "cache" / "index1" / "level", "2");
+		WriteFile(cpu / "cache" / "index1" / "shared_cpu_list", std::to_string(firstSibling) + "," + std::to_string(firstSibling + 4));
+		WriteFile(cpu / "cache" / "index2" / "level", "3");
+		WriteFile(cpu / "cache" / "index2" / "shared_cpu_list", package == 0 ? "0-1,4-5" : "2-3,6-7");
+	}
+
+	const std::vector<UInt32> cpus = {7, 0, 1, 2, 3, 4, 5, 6};
+	const CpuTopology topology = System::ReadCpuTopology(root, cpus);
+	std::filesystem::remove_all(root);
+
+	REQUIRE(topology.Cpus.size() == 8);
+	REQUIRE(topology.CoreCount == 4);
+	REQUIRE(topology.NumaNodes == std::vector<UInt32>{0, 1});
+
+	for (UInt32 id = 0; id < 8; ++id)
+	{
+		const CpuInfo& cpu = topology.Cpus[id];
+		REQUIRE(cpu.Id == id);
+		REQUIRE(cpu.PackageId == id % 4 / 2);
+		REQUIRE(cpu.NumaNode == id % 4 / 2);
+		REQUIRE(cpu.SmtIndex == id / 4);
+		REQUIRE(cpu.L2Group == id % 4);
+		REQUIRE(cpu.L3Group == (id % 4 < 2 ? 0u : 2u));
+		// SMT siblings share their core, cores of both packages are distinct
+		REQUIRE(cpu.CoreId == topology.Cpus[id % 4].CoreId);
+	}
+	REQUIRE(topology.Cpus[0].CoreId != topology.Cpus[2].CoreId);
+}
+
+TEST_CASE("System - ReadCpuTopology without sysfs", "[system]")
+{
+	const std::vector<UInt32> cpus = {0, 1};
+	const CpuTopology topology = System::ReadCpuTopology({}, cpus);
+
+	REQUIRE(topology.Cpus.size() == 2);
+	REQUIRE(topology.CoreCount == 2);
+	REQUIRE(topology.NumaNodes == std::vector<UInt32>{0});
+}
+
+TEST_CASE("System - QueryCpuTopology", "[system]")
+{
+	const CpuTopology topology = System::QueryCpuTopology();
+
+	REQUIRE_FALSE(topology.Cpus.empty());
+	REQUIRE(topology.CoreCount > 0);
+	REQUIRE(topology.CoreCount <= topology.Cpus.size());
+	REQUIRE_FALSE(topology.NumaNodes.empty());
+}
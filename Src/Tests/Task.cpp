@@ -0,0 +1,212 @@
+/**
+ * @file Tests/Task.cpp
+ * @brief Unit tests for coroutine tasks
+ * @date 2026-10-16
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_test_macros.hpp>
+#include <VkdUtils/Task/SyncAwaiter.hpp>
+#include <VkdUtils/Task/Task.hpp>
+
+using namespace vkd;
+
+namespace
+{
+	struct TestObject
+	{
+		std::atomic<UInt64> Value = 0;
+		SyncWaiterList Waiters;
+
+		void Signal(UInt64 value)
+		{
+			Value.store(value);
+			Waiters.NotifyAll();
+		}
+	};
+
+	Task<int> Add(int lhs, int rhs)
+	{
+		co_return lhs + rhs;
+	}
+
+	Task<int> Sum(int count)
+	{
+		int sum = 0;
+		for (int i = 0; i < count; ++i)
+			sum += co_await Add(i, 1);
+		co_return sum;
+	}
+
+	Task<int> Throw()
+	{
+		throw std::runtime_error("task failed");
+		co_return 0;
+	}
+} // namespace
+
+TEST_CASE("Task - Awaiting tasks", "[task]")
+{
+	ThreadPool pool(2);
+	TaskCounter counter;
+
+	SECTION("Results are returned to the awaiting coroutine")
+	{
+		int result = 0;
+		Spawn(pool, [](int& out) -> Task<void>
+		{
+			out = co_await Sum(1000);
+		}(result), counter);
+		pool.Wait(counter);
+		REQUIRE(result == 1000 * 1001 / 2);
+	}
+
+	SECTION("Exceptions are rethrown by co_await")
+	{
+		bool caught = false;
+		Spawn(pool, [](bool& out) -> Task<void>
+		{
+			try
+			{
+				co_await Throw();
+			}
+			catch (const std::runtime_error&)
+			{
+				out = true;
+			}
+		}(caught), counter);
+		pool.Wait(counter);
+		REQUIRE(caught);
+	}
+
+	SECTION("Tasks start lazily")
+	{
+		bool started = false;
+		Task<void> task = [](bool& out) -> Task<void>
+		{
+			out = true;
+			co_return;
+		}(started);
+		REQUIRE(task.IsValid());
+		REQUIRE_FALSE(task.IsDone());
+		REQUIRE_FALSE(started);
+
+		Spawn(pool, std::move(task), counter);
+		pool.Wait(counter);
+		REQUIRE(started);
+	}
+}
+
+TEST_CASE("Task - ResumeOn moves to a worker", "[task]")
+{
+	// A stopped pool starts the task on the calling thread, ResumeOn then hands it to the other one
+	ThreadPool stopped(1);
+	stopped.RequestStop();
+	ThreadPool pool(2);
+
+	TaskCounter counter;
+	std::thread::id before;
+	std::thread::id after;
+	Spawn(stopped, [](ThreadPool& p, std::thread::id& first, std::thread::id& second) -> Task<void>
+	{
+		first = std::this_thread::get_id();
+		co_await ResumeOn(p, ThreadPool::Priority::Realtime);
+		second = std::this_thread::get_id();
+	}(pool, before, after), counter);
+	// Blocks without helping, the caller would otherwise run the resumed coroutine itself
+	counter.Wait();
+
+	REQUIRE(before == std::this_thread::get_id());
+	REQUIRE(after != std::thread::id());
+	REQUIRE(after != std::this_thread::get_id());
+}
+
+TEST_CASE("Task - Awaiting synchronization objects", "[task]")
+{
+	ThreadPool pool(2);
+	TaskCounter counter;
+	TestObject object;
+
+	SECTION("Resumes once the condition holds, without holding a worker")
+	{
+		std::atomic<int> resumed = 0;
+		for (UInt64 value = 1; value <= 8; ++value)
+		{
+			Spawn(pool, [](ThreadPool& p, TestObject& o, UInt64 v, std::atomic<int>& out) -> Task<void>
+			{
+				co_await WaitUntil(p, o.Waiters, [&o, v]()
+								   { return o.Value.load() >= v; });
+				out.fetch_add(1);
+			}(pool, object, value, resumed), counter);
+		}
+
+		// More waiters than workers, a blocking wait would deadlock the pool
+		TaskCounter probe;
+		pool.AddTask(probe, []() {});
+		pool.Wait(probe);
+		REQUIRE(resumed.load() == 0);
+
+		object.Signal(4);
+		while (resumed.load() < 4)
+			std::this_thread::yield();
+		REQUIRE(resumed.load() == 4);
+
+		object.Signal(8);
+		pool.Wait(counter);
+		REQUIRE(resumed.load() == 8);
+	}
+
+	SECTION("Already satisfied conditions do not suspend")
+	{
+		object.Signal(1);
+		bool done = false;
+		Spawn(pool, [](ThreadPool& p, TestObject& o, bool& out) -> Task<void>
+		{
+			co_await WaitUntil(p, o.Waiters, [&o]()
+							   { return o.Value.load() >= 1; });
+			out = true;
+		}(pool, object, done), counter);
+		pool.Wait(counter);
+		REQUIRE(done);
+	}
+
+	SECTION("Signals racing with suspension")
+	{
+		constexpr int Rounds = 500;
+		for (int round = 1; round <= Rounds; ++round)
+		{
+			Spawn(pool, [](ThreadPool& p, TestObject& o, UInt64 v) -> Task<void>
+			{
+				co_await WaitUntil(p, o.Waiters, [&o, v]()
+								   { return o.Value.load() >= v; });
+			}(pool, object, static_cast<UInt64>(round)), counter);
+			object.Signal(static_cast<UInt64>(round));
+		}
+		pool.Wait(counter);
+		REQUIRE(counter.IsDone());
+	}
+}
+
+TEST_CASE("Task - Spawn after RequestStop runs on the caller", "[task]")
+{
+	ThreadPool pool(1);
+	pool.RequestStop();
+
+	TaskCounter counter;
+	std::thread::id ranOn;
+	Spawn(pool, [](std::thread::id& out) -> Task<void>
+	{
+		out = std::this_thread::get_id();
+		co_return;
+	}(ranOn), counter);
+
+	REQUIRE(counter.IsDone());
+	REQUIRE(ranOn == std::this_thread::get_id());
+}
@@ -0,0 +1,53 @@
+/**
+ * @file Tests/TaskCounter.cpp
+ * @brief Unit tests for TaskCounter
+ * @date 2026-10-16
+ */
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_test_macros.hpp>
+#include <VkdUtils/TaskCounter/TaskCounter.hpp>
+
+using namespace vkd;
+using namespace std::chrono_literals;
+
+TEST_CASE("TaskCounter - Completes once every task is done", "[taskcounter]")
+{
+	TaskCounter counter;
+	REQUIRE(counter.IsDone());
+	counter.Wait();
+
+	counter.Add(2);
+	REQUIRE_FALSE(counter.IsDone());
+	REQUIRE_FALSE(counter.Wait(Futex::Clock::now() + 10ms));
+
+	counter.Done();
+	REQUIRE_FALSE(counter.IsDone());
+	counter.Done();
+	REQUIRE(counter.IsDone());
+	REQUIRE(counter.Wait(Futex::Clock::now() + 10ms));
+}
+
+TEST_CASE("TaskCounter - Wakes waiting threads", "[taskcounter]")
+{
+	constexpr int TaskCount = 8;
+	TaskCounter counter(TaskCount);
+
+	std::vector<std::thread> waiters;
+	for (int i = 0; i < 3; ++i)
+		waiters.emplace_back([&counter]() { counter.Wait(); });
+
+	std::vector<std::thread> tasks;
+	for (int i = 0; i < TaskCount; ++i)
+		tasks.emplace_back([&counter]() { counter.Done(); });
+
+	for (auto& task : tasks)
+		task.join();
+	for (auto& waiter : waiters)
+		waiter.join();
+	REQUIRE(counter.IsDone());
+}
@@ -0,0 +1,69 @@
+/**
+ * @file Tests/TaskFunction.cpp
+ * @brief Unit tests for TaskFunction
+ * @date 2026-10-16
+ */
+
+#include <array>
+#include <memory>
+#include <utility>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_test_macros.hpp>
+#include <VkdUtils/TaskFunction/TaskFunction.hpp>
+
+using namespace vkd;
+
+TEST_CASE("TaskFunction - Small callables are stored inline", "[taskfunction]")
+{
+	int value = 0;
+	auto small = [&value]() { ++value; };
+	auto large = [array = std::array<char, TaskFunction::InlineSize + 1>{}]() { (void)array; };
+
+	STATIC_REQUIRE(TaskFunction::IsStoredInline<decltype(small)>);
+	STATIC_REQUIRE_FALSE(TaskFunction::IsStoredInline<decltype(large)>);
+
+	TaskFunction task(small);
+	REQUIRE(task);
+	task();
+	task();
+	REQUIRE(value == 2);
+}
+
+TEST_CASE("TaskFunction - Owns move-only captures", "[taskfunction]")
+{
+	auto owned = std::make_shared<int>(7);
+	std::weak_ptr<int> observer = owned;
+	int result = 0;
+
+	SECTION("Inline")
+	{
+		TaskFunction task([pointer = std::make_unique<std::shared_ptr<int>>(std::move(owned)), &result]() { result = **pointer; });
+		TaskFunction moved(std::move(task));
+		REQUIRE_FALSE(task);
+		moved();
+		REQUIRE(result == 7);
+		REQUIRE_FALSE(observer.expired());
+
+		moved.Reset();
+		REQUIRE_FALSE(moved);
+		REQUIRE(observer.expired());
+	}
+
+	SECTION("Heap")
+	{
+		TaskFunction task([pointer = std::make_unique<std::shared_ptr<int>>(std::move(owned)), &result, padding = std::array<char, TaskFunction::InlineSize>{}]()
+		{
+			(void)padding;
+			result = **pointer;
+		});
+		TaskFunction assigned;
+		assigned = std::move(task);
+		REQUIRE_FALSE(task);
+		assigned();
+		REQUIRE(result == 7);
+
+		assigned = TaskFunction([]() {});
+		REQUIRE(observer.expired());
+	}
+}
@@ -0,0 +1,111 @@
+/**
+ * @file Tests/TaskGraph.cpp
+ * @brief Unit tests for TaskGraph
+ * @date 2026-10-16
+ */
+
+#include <atomic>
+#include <vector>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_test_macros.hpp>
+#include <VkdUtils/TaskGraph/TaskGraph.hpp>
+
+using namespace vkd;
+
+TEST_CASE("TaskGraph - Runs nodes after their predecessors", "[taskgraph]")
+{
+	ThreadPool pool(4);
+	TaskGraph graph(pool);
+
+	// Fan-out from a root to a layer of nodes, fan-in into a resolve node
+	constexpr int LayerSize = 16;
+	std::atomic<int> order = 0;
+	int rootOrder = -1;
+	int resolveOrder = -1;
+	std::vector<int> layerOrder(LayerSize, -1);
+
+	const TaskGraph::NodeId root = graph.AddNode([&]() { rootOrder = order.fetch_add(1); });
+	const TaskGraph::NodeId resolve = graph.AddNode([&]() { resolveOrder = order.fetch_add(1); });
+	for (int i = 0; i < LayerSize; ++i)
+	{
+		const TaskGraph::NodeId node = graph.AddNode([&, i]() { layerOrder[i] = order.fetch_add(1); });
+		graph.AddDependency(root, node);
+		graph.AddDependency(node, resolve);
+	}
+
+	for (int run = 0; run < 3; ++run)
+	{
+		order = 0;
+		REQUIRE(graph.Run());
+		graph.Wait();
+		REQUIRE(graph.IsDone());
+
+		REQUIRE(rootOrder == 0);
+		REQUIRE(resolveOrder == LayerSize + 1);
+		for (int value : layerOrder)
+		{
+			REQUIRE(value > rootOrder);
+			REQUIRE(value < resolveOrder);
+		}
+	}
+}
+
+TEST_CASE("TaskGraph - Rejects cycles", "[taskgraph]")
+{
+	ThreadPool pool(2);
+	TaskGraph graph(pool);
+
+	const TaskGraph::NodeId a = graph.AddNode([]() {});
+	const TaskGraph::NodeId b = graph.AddNode([]() {});
+	graph.AddDependency(a, b);
+	graph.AddDependency(b, a);
+
+	REQUIRE_FALSE(graph.Run());
+	REQUIRE(graph.IsDone());
+}
+
+TEST_CASE("TaskGraph - Cancel skips the nodes not started yet", "[taskgraph]")
+{
+	ThreadPool pool(2);
+	TaskGraph graph(pool);
+
+	std::atomic<int> ran = 0;
+	TaskGraph::NodeId previous = graph.AddNode([&]()
+	{
+		ran.fetch_add(1);
+		graph.Cancel();
+	});
+	for (int i = 0; i < 10; ++i)
+	{
+		const TaskGraph::NodeId node = graph.AddNode([&]() { ran.fetch_add(1); });
+		graph.AddDependency(previous, node);
+		previous = node;
+	}
+
+	REQUIRE(graph.Run());
+	graph.Wait();
+	REQUIRE(graph.IsCancelled());
+	REQUIRE(ran.load() == 1);
+
+	// A new run clears the cancellation
+	REQUIRE(graph.Run());
+	graph.Wait();
+	REQUIRE(ran.load() == 2);
+}
+
+TEST_CASE("TaskGraph - Nodes run on the caller once the pool stopped", "[taskgraph]")
+{
+	ThreadPool pool(2);
+	pool.RequestStop();
+
+	TaskGraph graph(pool);
+	std::atomic<int> ran = 0;
+	const TaskGraph::NodeId a = graph.AddNode([&]() { ran.fetch_add(1); });
+	const TaskGraph::NodeId b = graph.AddNode([&]() { ran.fetch_add(1); });
+	graph.AddDependency(a, b);
+
+	REQUIRE(graph.Run());
+	REQUIRE(graph.IsDone());
+	REQUIRE(ran.load() == 2);
+}
@@ -0,0 +1,68 @@
+/**
+ * @file Tests/TaskGroup.cpp
+ * @brief Unit tests for TaskGroup
+ * @date 2026-10-16
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_test_macros.hpp>
+#include <VkdUtils/TaskGroup/TaskGroup.hpp>
+
+using namespace vkd;
+using namespace std::chrono_literals;
+
+TEST_CASE("TaskGroup - Waits only for its own tasks", "[taskgroup]")
+{
+	ThreadPool pool(2);
+	std::atomic<bool> started = false;
+	std::atomic<bool> release = false;
+	pool.AddTask([&started, &release]()
+				 {
+		started.store(true, std::memory_order_release);
+		while (!release.load(std::memory_order_acquire))
+			std::this_thread::sleep_for(1ms); });
+
+	// Running on a worker already, a waiting thread could otherwise pick it up while helping
+	while (!started.load(std::memory_order_acquire))
+		std::this_thread::sleep_for(1ms);
+
+	std::atomic<int> counter = 0;
+	{
+		TaskGroup group(pool);
+		for (int i = 0; i < 100; ++i)
+			group.Run([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+		group.Wait();
+		REQUIRE(counter.load() == 100);
+
+		group.Run([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+	}
+	REQUIRE(counter.load() == 101);
+
+	release.store(true, std::memory_order_release);
+	REQUIRE(pool.WaitFor(5000ms));
+}
+
+TEST_CASE("TaskGroup - Nested groups on a single worker", "[taskgroup]")
+{
+	ThreadPool pool(1);
+	std::atomic<int> counter = 0;
+
+	TaskGroup outer(pool);
+	for (int i = 0; i < 8; ++i)
+	{
+		outer.Run([&pool, &counter]()
+		{
+			// Waiting inside the only worker runs the inner tasks instead of deadlocking
+			TaskGroup inner(pool);
+			for (int j = 0; j < 8; ++j)
+				inner.Run([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+		});
+	}
+	outer.Wait();
+
+	REQUIRE(counter.load() == 64);
+}
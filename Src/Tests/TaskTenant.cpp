@@ -0,0 +1,221 @@
+/**
+ * @file Tests/TaskTenant.cpp
+ * @brief Unit tests for TaskTenant
+ * @date 2026-10-16
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_test_macros.hpp>
+#include <VkdUtils/TaskTenant/TaskTenant.hpp>
+
+using namespace vkd;
+using namespace std::chrono_literals;
+
+namespace
+{
+	/// Tracks how many tasks run at once
+	struct ConcurrencyProbe
+	{
+		std::atomic<int> Running = 0;
+		std::atomic<int> MaxRunning = 0;
+
+		void Run()
+		{
+			const int running = Running.fetch_add(1) + 1;
+			int max = MaxRunning.load();
+			while (running > max && !MaxRunning.compare_exchange_weak(max, running))
+			{
+			}
+			std::this_thread::sleep_for(1ms);
+			Running.fetch_sub(1);
+		}
+	};
+} // namespace
+
+TEST_CASE("TaskTenant - Runs its tasks", "[tasktenant]")
+{
+	auto pool = std::make_shared<ThreadPool>(2);
+	TaskTenant tenant(pool);
+	REQUIRE(tenant.GetQuota() == 2);
+	REQUIRE(&tenant.GetPool() == pool.get());
+
+	TaskCounter counter;
+	std::atomic<int> sum = 0;
+	for (int i = 1; i <= 1000; ++i)
+		tenant.AddTask(counter, [&sum, i]()
+					   { sum.fetch_add(i, std::memory_order_relaxed); }, static_cast<ThreadPool::Priority>(i % ThreadPool::PriorityCount));
+	tenant.Wait(counter);
+
+	REQUIRE(counter.IsDone());
+	REQUIRE(sum.load() == 1000 * 1001 / 2);
+}
+
+TEST_CASE("TaskTenant - Quota bounds the workers in use", "[tasktenant]")
+{
+	auto pool = std::make_shared<ThreadPool>(4);
+	TaskTenant tenant(pool, 2);
+	REQUIRE(tenant.GetQuota() == 2);
+	REQUIRE(TaskTenant(pool, 16).GetQuota() == 4);
+
+	ConcurrencyProbe probe;
+	TaskCounter counter;
+	for (int i = 0; i < 32; ++i)
+		tenant.AddTask(counter, [&probe]()
+					   { probe.Run(); });
+
+	// Blocks without helping, the calling thread would otherwise add to the count
+	counter.Wait();
+	REQUIRE(probe.MaxRunning.load() <= 2);
+}
+
+TEST_CASE("TaskTenant - Busy tenants take turns", "[tasktenant]")
+{
+	auto pool = std::make_shared<ThreadPool>(2);
+	TaskTenant busy(pool);
+	TaskTenant other(pool);
+
+	constexpr int BusyTasks = 200;
+	std::atomic<int> busyDone = 0;
+	TaskCounter busyCounter;
+	for (int i = 0; i < BusyTasks; ++i)
+	{
+		busy.AddTask(busyCounter, [&busyDone]()
+					 {
+			const auto end = std::chrono::steady_clock::now() + 1ms;
+			while (std::chrono::steady_clock::now() < end)
+			{
+			}
+			busyDone.fetch_add(1); });
+	}
+
+	// Queued behind nothing but the busy runners' next slices
+	TaskCounter otherCounter;
+	int busyDoneBefore = BusyTasks;
+	other.AddTask(otherCounter, [&busyDone, &busyDoneBefore]()
+				  { busyDoneBefore = busyDone.load(); });
+	otherCounter.Wait();
+	busyCounter.Wait();
+
+	REQUIRE(busyDone.load() == BusyTasks);
+	REQUIRE(busyDoneBefore < BusyTasks);
+}
+
+TEST_CASE("TaskTenant - Background tasks progress under realtime ones", "[tasktenant]")
+{
+	auto pool = std::make_shared<ThreadPool>(1);
+	TaskTenant tenant(pool, 1);
+
+	// Every realtime task queues the next one, the realtime lane never empties until stopped
+	std::atomic<bool> stop = false;
+	std::atomic<int> realtimeRan = 0;
+	TaskCounter counter;
+	std::function<void()> realtime = [&]()
+	{
+		realtimeRan.fetch_add(1);
+		if (!stop.load())
+			tenant.AddTask(counter, realtime, ThreadPool::Priority::Realtime);
+	};
+	for (int i = 0; i < 4; ++i)
+		tenant.AddTask(counter, realtime, ThreadPool::Priority::Realtime);
+
+	// Realtime tasks run ahead of it until a pick starts at a lower lane
+	std::atomic<int> realtimeBefore = -1;
+	const int realtimeQueued = realtimeRan.load();
+	tenant.AddTask(counter, [&realtimeBefore, &realtimeRan, realtimeQueued]()
+				   { realtimeBefore = realtimeRan.load() - realtimeQueued; }, ThreadPool::Priority::Background);
+
+	const auto deadline = std::chrono::steady_clock::now() + 10s;
+	while (realtimeBefore.load() < 0 && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(1ms);
+	stop.store(true);
+	tenant.Wait(counter);
+
+	REQUIRE(realtimeBefore.load() >= 0);
+	REQUIRE(realtimeBefore.load() <= 2 * static_cast<int>(ThreadPool::StarvationInterval) + 1);
+}
+
+TEST_CASE("TaskTenant - ParallelFor", "[tasktenant]")
+{
+	auto pool = std::make_shared<ThreadPool>(4);
+	TaskTenant tenant(pool, 2);
+
+	SECTION("Covers the range once")
+	{
+		std::vector<std::atomic<int>> hits(10007);
+		std::atomic<int> shortChunks = 0;
+		tenant.ParallelFor(7, hits.size(), 16, [&hits, &shortChunks](std::size_t begin, std::size_t end)
+		{
+			if (end - begin < 16 && end != hits.size())
+				shortChunks.fetch_add(1, std::memory_order_relaxed);
+			for (std::size_t i = begin; i < end; ++i)
+				hits[i].fetch_add(1, std::memory_order_relaxed);
+		});
+
+		REQUIRE(shortChunks.load() == 0);
+		for (std::size_t i = 0; i < hits.size(); ++i)
+			REQUIRE(hits[i].load() == (i < 7 ? 0 : 1));
+	}
+
+	SECTION("Runs on the calling thread and at most quota workers")
+	{
+		ConcurrencyProbe probe;
+		tenant.ParallelFor(0, 64, 1, [&probe](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+				probe.Run();
+		});
+		REQUIRE(probe.MaxRunning.load() <= 3);
+	}
+
+	SECTION("Empty range")
+	{
+		bool called = false;
+		tenant.ParallelFor(5, 5, 1, [&called](std::size_t, std::size_t)
+						   { called = true; });
+		REQUIRE_FALSE(called);
+	}
+}
+
+TEST_CASE("TaskTenant - Tasks run on the caller once the pool stopped", "[tasktenant]")
+{
+	auto pool = std::make_shared<ThreadPool>(1);
+	TaskTenant tenant(pool);
+	pool->RequestStop();
+
+	TaskCounter counter;
+	std::thread::id ranOn;
+	tenant.AddTask(counter, [&ranOn]()
+				   { ranOn = std::this_thread::get_id(); });
+
+	REQUIRE(counter.IsDone());
+	REQUIRE(ranOn == std::this_thread::get_id());
+}
+
+TEST_CASE("TaskTenant - The last tenant releases the pool", "[tasktenant]")
+{
+	// The tenant holds the pool, the last tenant destroyed stops it
+	std::weak_ptr<ThreadPool> weak;
+	std::atomic<int> ran = 0;
+	{
+		auto pool = std::make_shared<ThreadPool>(2);
+		weak = pool;
+		TaskTenant tenant(std::move(pool));
+
+		TaskCounter counter;
+		for (int i = 0; i < 64; ++i)
+			tenant.AddTask(counter, [&ran]()
+						   { ran.fetch_add(1); });
+		counter.Wait();
+		REQUIRE_FALSE(weak.expired());
+	}
+	REQUIRE(weak.expired());
+	REQUIRE(ran.load() == 64);
+}
@@ -4,8 +4,11 @@
  * @date 2025-10-31
  */
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
@@ -611,3 +614,414 @@ TEST_CASE("ThreadPool - Thread Safety", "[threadpool][thread-safety]")
 			thread.join();
 	}
 }
+
+TEST_CASE("ThreadPool - Task Counters", "[threadpool][counter]")
+{
+	SECTION("Counter completes after its tasks ran")
+	{
+		ThreadPool pool(4);
+		TaskCounter counter;
+		std::atomic<int> ran{0};
+
+		for (int i = 0; i < 100; ++i)
+		{
+			pool.AddTask(counter, [&ran]()
+						 { ran.fetch_add(1, std::memory_order_relaxed); });
+		}
+
+		pool.Wait(counter);
+		REQUIRE(counter.IsDone());
+		REQUIRE(ran.load() == 100);
+	}
+
+	SECTION("Worker waiting on its own tasks runs them")
+	{
+		ThreadPool pool(1);
+		std::atomic<int> ran{0};
+
+		auto future = pool.Submit([&pool, &ran]()
+								  {
+				TaskCounter counter;
+				for (int i = 0; i < 10; ++i)
+					pool.AddTask(counter, [&ran]() { ran.fetch_add(1, std::memory_order_relaxed); });
+				pool.Wait(counter);
+				return ran.load(); });
+
+		REQUIRE(future.get() == 10);
+	}
+
+	SECTION("Refused task completes the counter")
+	{
+		ThreadPool pool(2);
+		pool.RequestStop();
+
+		TaskCounter counter;
+		bool ran = false;
+		pool.AddTask(counter, [&ran]()
+					 { ran = true; });
+
+		REQUIRE(counter.IsDone());
+		REQUIRE_FALSE(ran);
+	}
+
+	SECTION("Submit accepts move-only callables")
+	{
+		ThreadPool pool(2);
+		auto future = pool.Submit([value = std::make_unique<int>(42)]()
+								  { return *value; });
+		REQUIRE(future.get() == 42);
+	}
+}
+
+TEST_CASE("ThreadPool - ParallelFor", "[threadpool][parallelfor]")
+{
+	auto checkCoverage = [](ThreadPool& pool, std::size_t begin, std::size_t end, std::size_t grain)
+	{
+		std::vector<std::atomic<int>> visits(end);
+		std::atomic<bool> chunkTooSmall = false;
+		pool.ParallelFor(begin, end, grain, [&](std::size_t chunkBegin, std::size_t chunkEnd)
+		{
+			if (chunkEnd - chunkBegin < grain && chunkEnd - chunkBegin != end - begin)
+				chunkTooSmall.store(true);
+			for (std::size_t i = chunkBegin; i < chunkEnd; ++i)
+				visits[i].fetch_add(1, std::memory_order_relaxed);
+		});
+
+		REQUIRE_FALSE(chunkTooSmall.load());
+		for (std::size_t i = 0; i < end; ++i)
+			REQUIRE(visits[i].load() == (i >= begin ? 1 : 0));
+	};
+
+	SECTION("Every index is visited once")
+	{
+		ThreadPool pool(4);
+		checkCoverage(pool, 0, 10000, 1);
+		checkCoverage(pool, 17, 1001, 64);
+		checkCoverage(pool, 3, 5, 16);
+		checkCoverage(pool, 5, 5, 1);
+	}
+
+	SECTION("Nested inside workers")
+	{
+		ThreadPool pool(2);
+		std::atomic<int> counter{0};
+		pool.ParallelFor(0, 16, 1, [&](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+				pool.ParallelFor(0, 100, 8, [&](std::size_t innerBegin, std::size_t innerEnd)
+				{ counter.fetch_add(static_cast<int>(innerEnd - innerBegin), std::memory_order_relaxed); });
+		});
+		REQUIRE(counter.load() == 1600);
+	}
+
+	SECTION("Runs on the caller after RequestStop")
+	{
+		ThreadPool pool(2);
+		pool.RequestStop();
+
+		std::atomic<int> counter{0};
+		pool.ParallelFor(0, 100, 1, [&](std::size_t begin, std::size_t end)
+		{ counter.fetch_add(static_cast<int>(end - begin), std::memory_order_relaxed); });
+		REQUIRE(counter.load() == 100);
+	}
+}
+
+TEST_CASE("ThreadPool - Topology Placement", "[threadpool][topology]")
+{
+	// Two nodes of two cores with two hardware threads each, ids do not exist on the host
+	// so pinning is refused and the workers simply run unpinned
+	CpuTopology topology;
+	for (UInt32 id = 0; id < 8; ++id)
+		topology.Cpus.push_back({.Id = 1000 + id, .CoreId = id % 4, .PackageId = id % 4 / 2, .NumaNode = id % 4 / 2, .SmtIndex = id / 4});
+	topology.CoreCount = 4;
+	topology.NumaNodes = {0, 1};
+
+	// CPUs of the pool workers, in worker order
+	auto workerCpus = [](const ThreadPool& pool)
+	{
+		std::vector<UInt32> cpus;
+		for (std::size_t i = 0; i < pool.GetWorkerCount(); ++i)
+		{
+			REQUIRE(pool.GetWorkerCpus(i).size() == 1);
+			cpus.push_back(pool.GetWorkerCpus(i).front());
+		}
+		return cpus;
+	};
+
+	SECTION("Workers are grouped per node")
+	{
+		// Interleaved over the nodes before being grouped, the second node gets a worker too
+		ThreadPool pool(ThreadPool::Options{.WorkerCount = 3, .Topology = &topology});
+		REQUIRE(pool.GetWorkerCount() == 3);
+		REQUIRE(pool.GetNumaNodes() == std::vector<UInt32>{0, 1});
+		REQUIRE(pool.GetNodeWorkers(0) == std::pair<std::size_t, std::size_t>{0, 2});
+		REQUIRE(pool.GetNodeWorkers(1) == std::pair<std::size_t, std::size_t>{2, 3});
+		REQUIRE(workerCpus(pool) == std::vector<UInt32>{1000, 1001, 1002});
+	}
+
+	SECTION("Cores before their SMT siblings")
+	{
+		ThreadPool pool(ThreadPool::Options{.WorkerCount = 6, .Topology = &topology});
+		REQUIRE(pool.GetNodeWorkers(0) == std::pair<std::size_t, std::size_t>{0, 3});
+		REQUIRE(pool.GetNodeWorkers(1) == std::pair<std::size_t, std::size_t>{3, 6});
+		REQUIRE(workerCpus(pool) == std::vector<UInt32>{1000, 1001, 1004, 1002, 1003, 1006});
+	}
+
+	SECTION("More workers than CPUs wrap around")
+	{
+		ThreadPool pool(ThreadPool::Options{.WorkerCount = 10, .Topology = &topology});
+		REQUIRE(pool.GetNodeWorkers(0) == std::pair<std::size_t, std::size_t>{0, 5});
+		REQUIRE(pool.GetNodeWorkers(1) == std::pair<std::size_t, std::size_t>{5, 10});
+		REQUIRE(workerCpus(pool) == std::vector<UInt32>{1000, 1001, 1004, 1005, 1000, 1002, 1003, 1006, 1007, 1002});
+	}
+
+	SECTION("One worker per CPU by default")
+	{
+		ThreadPool pool(ThreadPool::Options{.Topology = &topology, .Pinning = ThreadPool::Affinity::NumaNode});
+		REQUIRE(pool.GetWorkerCount() == 8);
+		REQUIRE(pool.GetNodeWorkers(0) == std::pair<std::size_t, std::size_t>{0, 4});
+		REQUIRE(pool.GetNodeWorkers(1) == std::pair<std::size_t, std::size_t>{4, 8});
+
+		// Each worker may run on any CPU of its node, cores first
+		for (std::size_t i = 0; i < 8; ++i)
+			REQUIRE(pool.GetWorkerCpus(i) == (i < 4 ? std::vector<UInt32>{1000, 1001, 1004, 1005} : std::vector<UInt32>{1002, 1003, 1006, 1007}));
+	}
+
+	SECTION("Unpinned workers")
+	{
+		ThreadPool pool(ThreadPool::Options{.WorkerCount = 2, .Topology = &topology, .Pinning = ThreadPool::Affinity::None});
+		REQUIRE(pool.GetNodeWorkers(0) == std::pair<std::size_t, std::size_t>{0, 1});
+		REQUIRE(pool.GetNodeWorkers(1) == std::pair<std::size_t, std::size_t>{1, 2});
+		REQUIRE(pool.GetWorkerCpus(0).empty());
+		REQUIRE(pool.GetWorkerCpus(1).empty());
+	}
+
+	SECTION("Without topology a single node is served")
+	{
+		ThreadPool pool(2);
+		REQUIRE(pool.GetNumaNodes() == std::vector<UInt32>{0});
+		REQUIRE(pool.GetNodeWorkers(0) == std::pair<std::size_t, std::size_t>{0, 2});
+		REQUIRE(pool.GetWorkerCpus(0).empty());
+	}
+
+	SECTION("Tasks hinted to any node all run")
+	{
+		ThreadPool pool(ThreadPool::Options{.WorkerCount = 4, .Topology = &topology});
+		std::atomic<int> counter{0};
+		TaskCounter done;
+
+		for (int i = 0; i < 200; ++i)
+		{
+			pool.AddTaskOnNode(i % 3 == 2 ? ThreadPool::AnyNode : static_cast<std::size_t>(i % 3), [&pool, &counter, &done, i]()
+			{
+				counter.fetch_add(1, std::memory_order_relaxed);
+				if (i % 10 == 0)
+					pool.AddTask(done, [&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+			});
+		}
+
+		REQUIRE(pool.WaitFor(5000ms));
+		pool.Wait(done);
+		REQUIRE(counter.load() == 220);
+	}
+
+	SECTION("Node of host memory")
+	{
+		ThreadPool pool(1);
+		const auto value = std::make_unique<int>(1);
+		const std::size_t node = pool.GetNumaNodeIndex(value.get());
+		REQUIRE((node == 0 || node == ThreadPool::AnyNode));
+	}
+}
+
+TEST_CASE("ThreadPool - Priorities", "[threadpool][priority]")
+{
+	// A single worker held by a blocker while every lane fills up, so the order it
+	// then picks tasks in only depends on the lanes
+	ThreadPool pool(1);
+	std::atomic<bool> blockerStarted{false};
+	std::atomic<bool> release{false};
+	pool.AddTask([&]()
+	{
+		blockerStarted.store(true);
+		while (!release.load())
+			std::this_thread::yield();
+	});
+	while (!blockerStarted.load())
+		std::this_thread::yield();
+
+	constexpr int TaskCount = 64;
+	std::mutex orderMutex;
+	std::vector<ThreadPool::Priority> order;
+	auto addTasks = [&](ThreadPool::Priority priority)
+	{
+		for (int i = 0; i < TaskCount; ++i)
+		{
+			pool.AddTask([&orderMutex, &order, priority]()
+			{
+				std::lock_guard lock(orderMutex);
+				order.push_back(priority);
+			}, priority);
+		}
+	};
+
+	SECTION("Higher lanes run first")
+	{
+		addTasks(ThreadPool::Priority::Background);
+		addTasks(ThreadPool::Priority::Normal);
+		addTasks(ThreadPool::Priority::Realtime);
+		release.store(true);
+		REQUIRE(pool.WaitFor(5000ms));
+
+		REQUIRE(order.size() == 3 * TaskCount);
+		double averagePosition[ThreadPool::PriorityCount] = {};
+		for (std::size_t i = 0; i < order.size(); ++i)
+			averagePosition[static_cast<std::size_t>(order[i])] += static_cast<double>(i) / TaskCount;
+		REQUIRE(averagePosition[0] < averagePosition[1]);
+		REQUIRE(averagePosition[1] < averagePosition[2]);
+	}
+
+	SECTION("Background is not starved")
+	{
+		addTasks(ThreadPool::Priority::Background);
+		addTasks(ThreadPool::Priority::Realtime);
+		addTasks(ThreadPool::Priority::Realtime);
+		release.store(true);
+		REQUIRE(pool.WaitFor(5000ms));
+
+		REQUIRE(order.size() == 3 * TaskCount);
+		const auto lastRealtime = std::find(order.rbegin(), order.rend(), ThreadPool::Priority::Realtime);
+		const auto backgroundFirst = std::count(lastRealtime, order.rend(), ThreadPool::Priority::Background);
+		REQUIRE(backgroundFirst >= 1);
+		REQUIRE(backgroundFirst <= 2 * TaskCount / static_cast<int>(ThreadPool::StarvationInterval) + 1);
+	}
+}
+
+TEST_CASE("ThreadPool - Priority Submission", "[threadpool][priority]")
+{
+	ThreadPool pool(2);
+
+	auto future = pool.Submit([]() { return 7; }, ThreadPool::Priority::Background);
+	REQUIRE(future.get() == 7);
+
+	TaskCounter counter;
+	std::atomic<int> sum{0};
+	pool.AddTask(counter, [&sum]() { sum.fetch_add(1); }, ThreadPool::Priority::Realtime);
+	pool.ParallelFor(0, 100, 1, [&sum](std::size_t begin, std::size_t end)
+	{
+		sum.fetch_add(static_cast<int>(end - begin));
+	}, ThreadPool::Priority::Realtime);
+	pool.Wait(counter);
+	REQUIRE(sum.load() == 101);
+}
+
+TEST_CASE("ThreadPool - Idle Workers", "[threadpool][spin]")
+{
+	// Tasks arrive in bursts separated by gaps, shorter and longer than the spin budget
+	auto runBursts = [](ThreadPool& pool)
+	{
+		std::atomic<int> counter{0};
+		for (int burst = 0; burst < 20; ++burst)
+		{
+			for (int i = 0; i < 10; ++i)
+				pool.AddTask([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+			std::this_thread::sleep_for(burst % 2 == 0 ? 10us : 2ms);
+		}
+		REQUIRE(pool.WaitFor(5000ms));
+		return counter.load();
+	};
+
+	SECTION("Spinning before parking")
+	{
+		ThreadPool pool(ThreadPool::Options{.WorkerCount = 2});
+		REQUIRE(runBursts(pool) == 200);
+	}
+
+	SECTION("Parking right away")
+	{
+		ThreadPool pool(ThreadPool::Options{.WorkerCount = 2, .MaxSpin = 0ns});
+		REQUIRE(runBursts(pool) == 200);
+	}
+
+	SECTION("Stop while spinning")
+	{
+		ThreadPool pool(ThreadPool::Options{.WorkerCount = 2, .MaxSpin = 10ms});
+		REQUIRE(runBursts(pool) == 200);
+		pool.RequestStop();
+	}
+}
+
+TEST_CASE("ThreadPool - Wake-up Latency Benchmark", "[.][threadpool][benchmark]")
+{
+	// Round trips of a single task, the worker being idle in between
+	auto measure = [](std::chrono::nanoseconds maxSpin)
+	{
+		ThreadPool pool(ThreadPool::Options{.WorkerCount = 1, .MaxSpin = maxSpin});
+		static constexpr int RoundTrips = 2000;
+		const auto start = std::chrono::steady_clock::now();
+		for (int i = 0; i < RoundTrips; ++i)
+		{
+			TaskCounter counter;
+			pool.AddTask(counter, []() {});
+			counter.Wait();
+		}
+		return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / RoundTrips;
+	};
+
+	const double parkedUs = measure(0ns);
+	const double spinningUs = measure(50us);
+	WARN(parkedUs << " us per round trip parking right away, " << spinningUs << " us spinning first");
+}
+
+// Hidden by default, run with "[benchmark]". Reports throughput of fine grained tasks
+// added concurrently from outside the pool and fanned out from inside it.
+TEST_CASE("ThreadPool - Contention Benchmark", "[.][threadpool][benchmark]")
+{
+	static constexpr int producerCount = 4;
+	static constexpr int tasksPerProducer = 50000;
+	static constexpr int fanOut = 64;
+
+	ThreadPool pool;
+	std::atomic<int> counter{0};
+
+	auto measure = [&pool](auto&& addTasks)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		addTasks();
+		REQUIRE(pool.WaitFor(60000ms));
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	const double externalMs = measure([&]()
+	{
+		std::vector<std::thread> producers;
+		for (int p = 0; p < producerCount; ++p)
+		{
+			producers.emplace_back([&pool, &counter]()
+			{
+				for (int i = 0; i < tasksPerProducer; ++i)
+					pool.AddTask([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+			});
+		}
+		for (auto& producer : producers)
+			producer.join();
+	});
+	REQUIRE(counter.load() == producerCount * tasksPerProducer);
+
+	counter.store(0);
+	const double nestedMs = measure([&]()
+	{
+		for (int p = 0; p < producerCount * tasksPerProducer / fanOut; ++p)
+		{
+			pool.AddTask([&pool, &counter]()
+			{
+				for (int i = 0; i < fanOut; ++i)
+					pool.AddTask([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+			});
+		}
+	});
+	REQUIRE(counter.load() == producerCount * tasksPerProducer / fanOut * fanOut);
+
+	WARN(pool.GetWorkerCount() << " workers, " << producerCount * tasksPerProducer << " tasks: "
+		 << externalMs << " ms from " << producerCount << " producers, " << nestedMs << " ms fanned out from workers");
+}
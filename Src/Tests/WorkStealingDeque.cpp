@@ -0,0 +1,101 @@
+/**
+ * @file Tests/WorkStealingDeque.cpp
+ * @brief Unit tests for WorkStealingDeque
+ * @date 2026-10-16
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch_test_macros.hpp>
+#include <VkdUtils/WorkStealingDeque/WorkStealingDeque.hpp>
+
+using namespace vkd;
+
+TEST_CASE("WorkStealingDeque - Owner pops newest, thieves steal oldest", "[workstealingdeque]")
+{
+	WorkStealingDeque<int> deque(4);
+	int value = 0;
+	REQUIRE(deque.IsEmpty());
+	REQUIRE_FALSE(deque.TryPop(value));
+	REQUIRE_FALSE(deque.TrySteal(value));
+
+	for (int i = 0; i < 3; ++i)
+		deque.Push(i);
+
+	REQUIRE(deque.TrySteal(value));
+	REQUIRE(value == 0);
+	REQUIRE(deque.TryPop(value));
+	REQUIRE(value == 2);
+	REQUIRE(deque.TryPop(value));
+	REQUIRE(value == 1);
+	REQUIRE_FALSE(deque.TryPop(value));
+	REQUIRE(deque.IsEmpty());
+}
+
+TEST_CASE("WorkStealingDeque - Grows past its capacity", "[workstealingdeque]")
+{
+	WorkStealingDeque<int> deque(2);
+	for (int i = 0; i < 100; ++i)
+		deque.Push(i);
+	REQUIRE(deque.GetCapacity() >= 100);
+
+	int value = 0;
+	for (int i = 0; i < 50; ++i)
+	{
+		REQUIRE(deque.TrySteal(value));
+		REQUIRE(value == i);
+	}
+	for (int i = 99; i >= 50; --i)
+	{
+		REQUIRE(deque.TryPop(value));
+		REQUIRE(value == i);
+	}
+	REQUIRE(deque.IsEmpty());
+}
+
+TEST_CASE("WorkStealingDeque - Every value is taken exactly once", "[workstealingdeque]")
+{
+	constexpr int ThiefCount = 3;
+	constexpr int ValueCount = 20000;
+
+	WorkStealingDeque<int> deque(16);
+	std::vector<std::atomic<int>> taken(ValueCount);
+	std::atomic<bool> done = false;
+
+	std::vector<std::thread> thieves;
+	for (int thief = 0; thief < ThiefCount; ++thief)
+	{
+		thieves.emplace_back([&]()
+		{
+			int value = 0;
+			while (!done.load(std::memory_order_acquire) || !deque.IsEmpty())
+			{
+				if (deque.TrySteal(value))
+					taken[value].fetch_add(1, std::memory_order_relaxed);
+				else
+					std::this_thread::yield();
+			}
+		});
+	}
+
+	int value = 0;
+	for (int i = 0; i < ValueCount; ++i)
+	{
+		deque.Push(i);
+		// Pops part of what was pushed so the owner races the thieves for the last values
+		if (i % 3 == 0 && deque.TryPop(value))
+			taken[value].fetch_add(1, std::memory_order_relaxed);
+	}
+	while (deque.TryPop(value))
+		taken[value].fetch_add(1, std::memory_order_relaxed);
+	done.store(true, std::memory_order_release);
+
+	for (auto& thief : thieves)
+		thief.join();
+
+	for (int i = 0; i < ValueCount; ++i)
+		REQUIRE(taken[i].load() == 1);
+}
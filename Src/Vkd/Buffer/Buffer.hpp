@@ -8,7 +8,7 @@
 
 #pragma once
 
-#include <vector>
+#include <span>
 
 #include "Vkd/ObjectBase/ObjectBase.hpp"
 
@@ -35,21 +35,21 @@ namespace vkd
 		{
 			Buffer* src;
 			Buffer* dst;
-			std::vector<VkBufferCopy> regions;
+			std::span<const VkBufferCopy> regions;
 		};
 
 		struct OpCopy2
 		{
 			Buffer* src;
 			Buffer* dst;
-			std::vector<VkBufferCopy2> regions;
+			std::span<const VkBufferCopy2> regions;
 		};
 
 		struct OpUpdate
 		{
 			Buffer* dst;
 			VkDeviceSize offset;
-			std::vector<UInt8> data;
+			std::span<const UInt8> data;
 		};
 
 		struct OpCopyBufferToImage
@@ -57,7 +57,7 @@ namespace vkd
 			Buffer* src;
 			Image* dst;
 			VkImageLayout dstLayout;
-			std::vector<VkBufferImageCopy> regions;
+			std::span<const VkBufferImageCopy> regions;
 		};
 
 		struct OpCopyImageToBuffer
@@ -65,7 +65,7 @@ namespace vkd
 			Image* src;
 			VkImageLayout srcLayout;
 			Buffer* dst;
-			std::vector<VkBufferImageCopy> regions;
+			std::span<const VkBufferImageCopy> regions;
 		};
 
 		using Op = Nz::TypeList<OpFill, OpCopy, OpCopy2, OpUpdate, OpCopyBufferToImage, OpCopyImageToBuffer>;
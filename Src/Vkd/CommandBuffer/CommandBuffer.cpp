@@ -8,6 +8,8 @@
 
 namespace vkd
 {
+	std::atomic<UInt64> CommandBuffer::s_nextRecordingId = 0;
+
 	VkResult CommandBuffer::BeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo* pBeginInfo)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
@@ -138,6 +140,38 @@ namespace vkd
 	void VKAPI_CALL CommandBuffer::CmdPipelineBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkDependencyFlags dependencyFlags, uint32_t memoryBarrierCount, const VkMemoryBarrier* pMemoryBarriers, uint32_t bufferMemoryBarrierCount, const VkBufferMemoryBarrier* pBufferMemoryBarriers, uint32_t imageMemoryBarrierCount, const VkImageMemoryBarrier* pImageMemoryBarriers)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
+
+		VKD_FROM_HANDLE(CommandBuffer, commandBufferObj, commandBuffer);
+
+		commandBufferObj->PushPipelineBarrier(srcStageMask, dstStageMask, dependencyFlags);
+	}
+
+	void VKAPI_CALL CommandBuffer::CmdSetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags stageMask)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		VKD_FROM_HANDLE(CommandBuffer, commandBufferObj, commandBuffer);
+
+		commandBufferObj->PushSetEvent(event, stageMask);
+	}
+
+	void VKAPI_CALL CommandBuffer::CmdResetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags stageMask)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		VKD_FROM_HANDLE(CommandBuffer, commandBufferObj, commandBuffer);
+
+		commandBufferObj->PushResetEvent(event, stageMask);
+	}
+
+	void VKAPI_CALL CommandBuffer::CmdWaitEvents(VkCommandBuffer commandBuffer, uint32_t eventCount, const VkEvent* pEvents, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, uint32_t memoryBarrierCount, const VkMemoryBarrier* pMemoryBarriers, uint32_t bufferMemoryBarrierCount, const VkBufferMemoryBarrier* pBufferMemoryBarriers, uint32_t imageMemoryBarrierCount, const VkImageMemoryBarrier* pImageMemoryBarriers)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		VKD_FROM_HANDLE(CommandBuffer, commandBufferObj, commandBuffer);
+		VKD_CHECK(pEvents && eventCount != 0);
+
+		commandBufferObj->PushWaitEvents(std::span(pEvents, eventCount), srcStageMask, dstStageMask);
 	}
 
 	void CommandBuffer::CmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
@@ -237,5 +271,10 @@ namespace vkd
 	void VKAPI_CALL CommandBuffer::CmdExecuteCommands(VkCommandBuffer commandBuffer, uint32_t commandBufferCount, const VkCommandBuffer* pCommandBuffers)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
+
+		VKD_FROM_HANDLE(CommandBuffer, commandBufferObj, commandBuffer);
+		VKD_CHECK(pCommandBuffers);
+
+		commandBufferObj->PushExecuteCommands(std::span(pCommandBuffers, commandBufferCount));
 	}
 } // namespace vkd
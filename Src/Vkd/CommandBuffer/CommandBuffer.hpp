@@ -8,9 +8,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <span>
 
 #include "Vkd/Buffer/Buffer.hpp"
+#include "Vkd/CommandBuffer/CommandOptimizer.hpp"
+#include "Vkd/CommandBuffer/CommandStream.hpp"
 #include "Vkd/CommandBuffer/Ops.hpp"
 #include "Vkd/Image/Image.hpp"
 #include "Vkd/ObjectBase/ObjectBase.hpp"
@@ -34,7 +37,9 @@ namespace vkd
 		};
 		using BufferImageOps = Nz::TypeListConcat<Buffer::Op, Image::Op>;
 		using AllOps = Nz::TypeListConcat<BufferImageOps, vkd::Op>;
-		using Op = Nz::TypeListInstantiate<AllOps, std::variant>;
+
+		template<typename T>
+		static constexpr UInt32 OpType = OpIndex<AllOps, T>::Value;
 
 		static constexpr VkObjectType ObjectType = VK_OBJECT_TYPE_COMMAND_BUFFER;
 		VKD_DISPATCHABLE_HANDLE(CommandBuffer);
@@ -46,6 +51,8 @@ namespace vkd
 
 		[[nodiscard]] inline CommandPool* GetOwner() const;
 		[[nodiscard]] inline VkCommandBufferLevel GetLevel() const;
+		[[nodiscard]] inline VkCommandBufferUsageFlags GetUsageFlags() const;
+		[[nodiscard]] inline const VkCommandBufferInheritanceInfo& GetInheritanceInfo() const;
 
 		// Vulkan API entry points
 		static VkResult VKAPI_CALL BeginCommandBuffer(VkCommandBuffer commandBuffer, const VkCommandBufferBeginInfo* pBeginInfo);
@@ -65,6 +72,9 @@ namespace vkd
 		static void VKAPI_CALL CmdBindDescriptorSets(VkCommandBuffer commandBuffer, VkPipelineBindPoint pipelineBindPoint, VkPipelineLayout layout, uint32_t firstSet, uint32_t descriptorSetCount, const VkDescriptorSet* pDescriptorSets, uint32_t dynamicOffsetCount, const uint32_t* pDynamicOffsets);
 		static void VKAPI_CALL CmdPushConstants(VkCommandBuffer commandBuffer, VkPipelineLayout layout, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* pValues);
 		static void VKAPI_CALL CmdPipelineBarrier(VkCommandBuffer commandBuffer, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkDependencyFlags dependencyFlags, uint32_t memoryBarrierCount, const VkMemoryBarrier* pMemoryBarriers, uint32_t bufferMemoryBarrierCount, const VkBufferMemoryBarrier* pBufferMemoryBarriers, uint32_t imageMemoryBarrierCount, const VkImageMemoryBarrier* pImageMemoryBarriers);
+		static void VKAPI_CALL CmdSetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags stageMask);
+		static void VKAPI_CALL CmdResetEvent(VkCommandBuffer commandBuffer, VkEvent event, VkPipelineStageFlags stageMask);
+		static void VKAPI_CALL CmdWaitEvents(VkCommandBuffer commandBuffer, uint32_t eventCount, const VkEvent* pEvents, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, uint32_t memoryBarrierCount, const VkMemoryBarrier* pMemoryBarriers, uint32_t bufferMemoryBarrierCount, const VkBufferMemoryBarrier* pBufferMemoryBarriers, uint32_t imageMemoryBarrierCount, const VkImageMemoryBarrier* pImageMemoryBarriers);
 		static void VKAPI_CALL CmdDraw(VkCommandBuffer commandBuffer, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
 		static void VKAPI_CALL CmdDrawIndexed(VkCommandBuffer commandBuffer, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
 		static void VKAPI_CALL CmdDrawIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, uint32_t drawCount, uint32_t stride);
@@ -88,6 +98,8 @@ namespace vkd
 		inline VkResult Begin(const VkCommandBufferBeginInfo& beginInfo);
 		inline VkResult End();
 		inline VkResult Reset(VkCommandBufferResetFlags flags);
+		/// Drops the recorded commands and returns to the initial state, used when recycling the command buffer.
+		inline void ReleaseCommands();
 		inline void PushFillBuffer(VkBuffer dst, VkDeviceSize off, VkDeviceSize size, UInt32 data);
 		inline void PushCopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, UInt32 regionCount, const VkBufferCopy* pRegions);
 		inline void PushCopyBuffer2(VkBuffer srcBuffer, VkBuffer dstBuffer, UInt32 regionCount, const VkBufferCopy2* pRegions);
@@ -99,21 +111,52 @@ namespace vkd
 		inline void PushBindPipeline(VkPipelineBindPoint pipelineBindPoint, VkPipeline pipeline);
 		inline void PushBindVertexBuffer(std::span<const VkBuffer> pBuffers, std::span<const VkDeviceSize> pOffsets, UInt32 firstBinding);
 		inline void PushDraw(UInt32 vertexCount, UInt32 instanceCount, UInt32 firstVertex, UInt32 firstInstance);
-
+		inline void PushExecuteCommands(std::span<const VkCommandBuffer> commandBuffers);
+		inline void PushPipelineBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkDependencyFlags dependencyFlags);
+		inline void PushSetEvent(VkEvent event, VkPipelineStageFlags stageMask);
+		inline void PushResetEvent(VkEvent event, VkPipelineStageFlags stageMask);
+		inline void PushWaitEvents(std::span<const VkEvent> events, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask);
+
+		/// Counts one more submission in flight, several are only allowed with VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT.
+		/// The recorded commands and their compiled form are immutable while pending and shared by every execution.
 		inline VkResult MarkSubmitted();
+		/// Takes back a MarkSubmitted whose submission failed before anything executed, the state is left unchanged.
+		inline void UnmarkSubmitted();
+		/// Called by the queue once an execution finished, may run on any thread.
 		inline VkResult MarkComplete();
 
-		[[nodiscard]] inline std::span<const Op> GetOps() const;
+		[[nodiscard]] inline const CommandStream& GetCommands() const;
+		/// Commands removed by the optimizer during the last vkEndCommandBuffer
+		[[nodiscard]] inline const CommandOptimizer::Stats& GetOptimizerStats() const;
+		/// Executable or pending, i.e. the recorded commands can be executed
 		[[nodiscard]] inline bool IsSealed() const;
+		[[nodiscard]] inline bool IsPending() const;
+		[[nodiscard]] inline State GetState() const;
+		/// Identifies the current recording, unique across the process and renewed by every vkBeginCommandBuffer
+		[[nodiscard]] inline UInt64 GetRecordingId() const;
 
 	protected:
+		/// Called by End once recording succeeded, lets the backend lower the recorded commands
+		virtual VkResult Compile();
 		inline VkResult Transition(State to, std::initializer_list<State> allowed);
 
 	private:
+		template<typename T>
+		inline CommandStream::Packet<T> Emplace(std::size_t inlineSize = 0);
+		inline void SyncWithPool();
+
 		CommandPool* m_owner;
 		VkCommandBufferLevel m_level;
-		State m_state;
-		std::vector<Op> m_ops;
+		VkCommandBufferUsageFlags m_usageFlags;
+		VkCommandBufferInheritanceInfo m_inheritanceInfo;
+		State m_state; ///< Never Pending, the pending state is derived from m_pendingCount
+		std::atomic<UInt32> m_pendingCount;
+		CommandStream m_stream;
+		CommandOptimizer m_optimizer;
+		UInt64 m_poolGeneration;
+		UInt64 m_recordingId;
+
+		static std::atomic<UInt64> s_nextRecordingId;
 	};
 } // namespace vkd
 
@@ -9,6 +9,7 @@
 #include "Vkd/CommandBuffer/CommandBuffer.hpp"
 #include "Vkd/CommandPool/CommandPool.hpp"
 #include "Vkd/Pipeline/Pipeline.hpp"
+#include "Vkd/Synchronization/Event/Event.hpp"
 
 namespace vkd
 {
@@ -16,7 +17,12 @@ namespace vkd
 		ObjectBase(ObjectType),
 		m_owner(nullptr),
 		m_level(VK_COMMAND_BUFFER_LEVEL_PRIMARY),
-		m_state(State::Initial)
+		m_usageFlags(0),
+		m_inheritanceInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO},
+		m_state(State::Initial),
+		m_pendingCount(0),
+		m_poolGeneration(0),
+		m_recordingId(0)
 	{
 	}
 
@@ -26,6 +32,7 @@ namespace vkd
 		m_level = level;
 
 		SetAllocationCallbacks(m_owner->GetAllocationCallbacks());
+		m_stream.SetArena(m_owner->GetCommandArena());
 
 		m_createResult = VK_SUCCESS;
 		return m_createResult;
@@ -43,10 +50,49 @@ namespace vkd
 		return m_level;
 	}
 
+	inline VkCommandBufferUsageFlags CommandBuffer::GetUsageFlags() const
+	{
+		AssertValid();
+		return m_usageFlags;
+	}
+
+	inline const VkCommandBufferInheritanceInfo& CommandBuffer::GetInheritanceInfo() const
+	{
+		AssertValid();
+		return m_inheritanceInfo;
+	}
+
 	inline VkResult CommandBuffer::Begin(const VkCommandBufferBeginInfo& beginInfo)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
-		Transition(State::Recording, {State::Initial});
+		SyncWithPool();
+
+		if (IsPending())
+		{
+			CCT_ASSERT_FALSE("Cannot begin a command buffer that is pending execution");
+			return VK_ERROR_VALIDATION_FAILED_EXT;
+		}
+
+		// Beginning an executable or invalid command buffer implicitly resets it
+		if ((m_state == State::Executable || m_state == State::Invalid) && (m_owner->GetFlags() & VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT))
+			ReleaseCommands();
+
+		VkResult result = Transition(State::Recording, {State::Initial});
+		if (result != VK_SUCCESS)
+			return result;
+
+		m_stream.Reset();
+		m_poolGeneration = m_owner->GetCommandArena().GetGeneration();
+		m_recordingId = s_nextRecordingId.fetch_add(1, std::memory_order_relaxed) + 1;
+		m_usageFlags = beginInfo.flags;
+
+		// Inheritance info is ignored for primary command buffers
+		m_inheritanceInfo = VkCommandBufferInheritanceInfo{.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
+		if (m_level == VK_COMMAND_BUFFER_LEVEL_SECONDARY && beginInfo.pInheritanceInfo)
+		{
+			m_inheritanceInfo = *beginInfo.pInheritanceInfo;
+			m_inheritanceInfo.pNext = nullptr;
+		}
 
 		return VK_SUCCESS;
 	}
@@ -54,7 +100,27 @@ namespace vkd
 	inline VkResult CommandBuffer::End()
 	{
 		VKD_AUTO_PROFILER_SCOPE();
-		Transition(State::Executable, {State::Recording});
+		SyncWithPool();
+
+		if (m_stream.HasFailed())
+		{
+			m_state = State::Invalid;
+			return VK_ERROR_OUT_OF_HOST_MEMORY;
+		}
+
+		VkResult result = Transition(State::Executable, {State::Recording});
+		if (result != VK_SUCCESS)
+			return result;
+
+		if (m_owner->GetOwner()->IsCommandOptimizationEnabled())
+			m_optimizer.Run(m_stream);
+
+		result = Compile();
+		if (result != VK_SUCCESS)
+		{
+			m_state = State::Invalid;
+			return result;
+		}
 
 		return VK_SUCCESS;
 	}
@@ -62,15 +128,42 @@ namespace vkd
 	inline VkResult CommandBuffer::Reset(VkCommandBufferResetFlags flags)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
-		Transition(State::Initial, {State::Executable, State::Pending});
+		SyncWithPool();
 
-		return VK_SUCCESS;
+		if (!(m_owner->GetFlags() & VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT))
+		{
+			CCT_ASSERT_FALSE("Command buffers can only be reset individually when their pool was created with VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT");
+			return VK_ERROR_VALIDATION_FAILED_EXT;
+		}
+
+		if (IsPending())
+		{
+			CCT_ASSERT_FALSE("Cannot reset a command buffer that is pending execution");
+			return VK_ERROR_VALIDATION_FAILED_EXT;
+		}
+
+		VkResult result = Transition(State::Initial, {State::Initial, State::Recording, State::Executable, State::Invalid});
+		m_stream.Reset();
+
+		return result;
+	}
+
+	inline void CommandBuffer::ReleaseCommands()
+	{
+		CCT_ASSERT(!IsPending(), "Command buffer released while pending execution");
+		m_stream.Reset();
+		m_state = State::Initial;
 	}
 
 	inline void CommandBuffer::PushFillBuffer(VkBuffer dst, VkDeviceSize off, VkDeviceSize size, uint32_t data)
 	{
 		VKD_FROM_HANDLE(Buffer, bufferObj, dst);
-		m_ops.emplace_back(Buffer::OpFill{bufferObj, off, size, data});
+
+		auto op = Emplace<Buffer::OpFill>();
+		if (!op)
+			return;
+
+		*op = Buffer::OpFill{bufferObj, off, size, data};
 	}
 
 	inline void CommandBuffer::PushCopyBuffer(VkBuffer srcBuffer, VkBuffer dstBuffer, uint32_t regionCount, const VkBufferCopy* pRegions)
@@ -78,10 +171,13 @@ namespace vkd
 		VKD_FROM_HANDLE(Buffer, srcBufferObj, srcBuffer);
 		VKD_FROM_HANDLE(Buffer, dstBufferObj, dstBuffer);
 
-		std::vector<VkBufferCopy> regions;
-		regions.resize(regionCount);
-		std::memcpy(regions.data(), pRegions, regions.size() * sizeof(VkBufferCopy));
-		m_ops.emplace_back(Buffer::OpCopy{srcBufferObj, dstBufferObj, std::move(regions)});
+		auto op = Emplace<Buffer::OpCopy>(CommandStream::InlineSize<VkBufferCopy>(regionCount));
+		if (!op)
+			return;
+
+		op->src = srcBufferObj;
+		op->dst = dstBufferObj;
+		op->regions = op.Append(pRegions, regionCount);
 	}
 
 	inline void CommandBuffer::PushCopyBuffer2(VkBuffer srcBuffer, VkBuffer dstBuffer, uint32_t regionCount, const VkBufferCopy2* pRegions)
@@ -89,20 +185,26 @@ namespace vkd
 		VKD_FROM_HANDLE(Buffer, srcBufferObj, srcBuffer);
 		VKD_FROM_HANDLE(Buffer, dstBufferObj, dstBuffer);
 
-		std::vector<VkBufferCopy2> regions;
-		regions.resize(regionCount);
-		std::memcpy(regions.data(), pRegions, regions.size() * sizeof(VkBufferCopy2));
-		m_ops.emplace_back(Buffer::OpCopy2{srcBufferObj, dstBufferObj, std::move(regions)});
+		auto op = Emplace<Buffer::OpCopy2>(CommandStream::InlineSize<VkBufferCopy2>(regionCount));
+		if (!op)
+			return;
+
+		op->src = srcBufferObj;
+		op->dst = dstBufferObj;
+		op->regions = op.Append(pRegions, regionCount);
 	}
 
 	inline void CommandBuffer::PushUpdateBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, VkDeviceSize dataSize, const void* pData)
 	{
 		VKD_FROM_HANDLE(Buffer, dstBufferObj, dstBuffer);
 
-		std::vector<UInt8> data;
-		data.resize(dataSize);
-		std::memcpy(data.data(), pData, dataSize);
-		m_ops.emplace_back(Buffer::OpUpdate{dstBufferObj, dstOffset, std::move(data)});
+		auto op = Emplace<Buffer::OpUpdate>(CommandStream::InlineSize<UInt8>(dataSize));
+		if (!op)
+			return;
+
+		op->dst = dstBufferObj;
+		op->offset = dstOffset;
+		op->data = op.Append(static_cast<const UInt8*>(pData), dataSize);
 	}
 
 	inline void CommandBuffer::PushCopyImage(VkImage srcImage, VkImageLayout srcImageLayout, VkImage dstImage, VkImageLayout dstImageLayout, UInt32 regionCount, const VkImageCopy* pRegions)
@@ -110,10 +212,13 @@ namespace vkd
 		VKD_FROM_HANDLE(Image, srcImageObj, srcImage);
 		VKD_FROM_HANDLE(Image, dstImageObj, dstImage);
 
-		std::vector<VkImageCopy> regions;
-		regions.resize(regionCount);
-		std::memcpy(regions.data(), pRegions, regions.size() * sizeof(VkImageCopy));
-		m_ops.emplace_back(Image::OpCopy{srcImageObj, dstImageObj, std::move(regions)});
+		auto op = Emplace<Image::OpCopy>(CommandStream::InlineSize<VkImageCopy>(regionCount));
+		if (!op)
+			return;
+
+		op->src = srcImageObj;
+		op->dst = dstImageObj;
+		op->regions = op.Append(pRegions, regionCount);
 	}
 
 	inline void CommandBuffer::PushCopyBufferToImage(VkBuffer srcBuffer, VkImage dstImage, VkImageLayout dstImageLayout, UInt32 regionCount, const VkBufferImageCopy* pRegions)
@@ -121,10 +226,14 @@ namespace vkd
 		VKD_FROM_HANDLE(Buffer, srcBufferObj, srcBuffer);
 		VKD_FROM_HANDLE(Image, dstImageObj, dstImage);
 
-		std::vector<VkBufferImageCopy> regions;
-		regions.resize(regionCount);
-		std::memcpy(regions.data(), pRegions, regions.size() * sizeof(VkBufferImageCopy));
-		m_ops.emplace_back(Buffer::OpCopyBufferToImage{srcBufferObj, dstImageObj, dstImageLayout, std::move(regions)});
+		auto op = Emplace<Buffer::OpCopyBufferToImage>(CommandStream::InlineSize<VkBufferImageCopy>(regionCount));
+		if (!op)
+			return;
+
+		op->src = srcBufferObj;
+		op->dst = dstImageObj;
+		op->dstLayout = dstImageLayout;
+		op->regions = op.Append(pRegions, regionCount);
 	}
 
 	inline void CommandBuffer::PushCopyImageToBuffer(VkImage srcImage, VkImageLayout srcImageLayout, VkBuffer dstBuffer, UInt32 regionCount, const VkBufferImageCopy* pRegions)
@@ -132,81 +241,252 @@ namespace vkd
 		VKD_FROM_HANDLE(Image, srcImageObj, srcImage);
 		VKD_FROM_HANDLE(Buffer, dstBufferObj, dstBuffer);
 
-		std::vector<VkBufferImageCopy> regions;
-		regions.resize(regionCount);
-		std::memcpy(regions.data(), pRegions, regions.size() * sizeof(VkBufferImageCopy));
-		m_ops.emplace_back(Buffer::OpCopyImageToBuffer{srcImageObj, srcImageLayout, dstBufferObj, std::move(regions)});
+		auto op = Emplace<Buffer::OpCopyImageToBuffer>(CommandStream::InlineSize<VkBufferImageCopy>(regionCount));
+		if (!op)
+			return;
+
+		op->src = srcImageObj;
+		op->srcLayout = srcImageLayout;
+		op->dst = dstBufferObj;
+		op->regions = op.Append(pRegions, regionCount);
 	}
 
 	inline void CommandBuffer::PushClearColorImage(VkImage image, VkImageLayout imageLayout, const VkClearColorValue* pColor, UInt32 rangeCount, const VkImageSubresourceRange* pRanges)
 	{
 		VKD_FROM_HANDLE(Image, imageObj, image);
 
-		std::vector<VkImageSubresourceRange> ranges;
-		ranges.resize(rangeCount);
-		std::memcpy(ranges.data(), pRanges, ranges.size() * sizeof(VkImageSubresourceRange));
-		m_ops.emplace_back(Image::OpClearColorImage{imageObj, imageLayout, *pColor, std::move(ranges)});
+		auto op = Emplace<Image::OpClearColorImage>(CommandStream::InlineSize<VkImageSubresourceRange>(rangeCount));
+		if (!op)
+			return;
+
+		op->image = imageObj;
+		op->layout = imageLayout;
+		op->clearColor = *pColor;
+		op->ranges = op.Append(pRanges, rangeCount);
 	}
 
 	inline void CommandBuffer::PushBindPipeline(VkPipelineBindPoint pipelineBindPoint, VkPipeline pipeline)
 	{
 		VKD_FROM_HANDLE(Pipeline, pipelineObject, pipeline);
 
-		m_ops.emplace_back(OpBindPipeline{
+		auto op = Emplace<OpBindPipeline>();
+		if (!op)
+			return;
+
+		*op = OpBindPipeline{
 			.BindPoint = pipelineBindPoint,
 			.PipelineObject = pipelineObject,
-		});
+		};
 	}
 
 	inline void CommandBuffer::PushBindVertexBuffer(std::span<const VkBuffer> pBuffers, std::span<const VkDeviceSize> pOffsets, UInt32 firstBinding)
 	{
-		std::vector<Buffer*> buffers;
-		std::vector<VkDeviceSize> offsets;
-		buffers.resize(pBuffers.size());
-		offsets.resize(pBuffers.size());
+		const std::size_t count = pBuffers.size();
+		auto op = Emplace<OpBindVertexBuffer>(CommandStream::InlineSize<Buffer*>(count) + CommandStream::InlineSize<VkDeviceSize>(count));
+		if (!op)
+			return;
 
-		for (std::size_t i = 0; i < pBuffers.size(); ++i)
+		std::span<Buffer*> buffers = op.Reserve<Buffer*>(count);
+		for (std::size_t i = 0; i < count; ++i)
 		{
 			VKD_FROM_HANDLE(Buffer, bufferObject, pBuffers[i]);
 			buffers[i] = bufferObject;
-			offsets[i] = pOffsets[i];
 		}
 
-		m_ops.emplace_back(OpBindVertexBuffer{
-			.Buffers = std::move(buffers),
-			.Offsets = std::move(offsets),
-			.FirstBinding = firstBinding,
-		});
+		op->Buffers = buffers;
+		op->Offsets = op.Append(pOffsets.data(), count);
+		op->FirstBinding = firstBinding;
 	}
 
 	inline void CommandBuffer::PushDraw(UInt32 vertexCount, UInt32 instanceCount, UInt32 firstVertex, UInt32 firstInstance)
 	{
-		m_ops.emplace_back(OpDraw{
+		auto op = Emplace<OpDraw>();
+		if (!op)
+			return;
+
+		*op = OpDraw{
 			.VertexCount = vertexCount,
 			.InstanceCount = instanceCount,
 			.FirstVertex = firstVertex,
 			.FirstInstance = firstInstance,
-		});
+		};
+	}
+
+	inline void CommandBuffer::PushExecuteCommands(std::span<const VkCommandBuffer> commandBuffers)
+	{
+		const std::size_t count = commandBuffers.size();
+		auto op = Emplace<OpExecuteCommands>(CommandStream::InlineSize<CommandBuffer*>(count));
+		if (!op)
+			return;
+
+		std::span<CommandBuffer*> secondaries = op.Reserve<CommandBuffer*>(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			VKD_FROM_HANDLE(CommandBuffer, secondary, commandBuffers[i]);
+			CCT_ASSERT(secondary->GetLevel() == VK_COMMAND_BUFFER_LEVEL_SECONDARY, "vkCmdExecuteCommands expects secondary command buffers");
+			CCT_ASSERT(secondary->IsSealed(), "Secondary command buffers must be in the executable state");
+			secondaries[i] = secondary;
+		}
+
+		op->CommandBuffers = secondaries;
+	}
+
+	inline void CommandBuffer::PushPipelineBarrier(VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask, VkDependencyFlags dependencyFlags)
+	{
+		auto op = Emplace<OpPipelineBarrier>();
+		if (!op)
+			return;
+
+		*op = OpPipelineBarrier{
+			.SrcStageMask = srcStageMask,
+			.DstStageMask = dstStageMask,
+			.DependencyFlags = dependencyFlags,
+		};
+	}
+
+	inline void CommandBuffer::PushSetEvent(VkEvent event, VkPipelineStageFlags stageMask)
+	{
+		VKD_FROM_HANDLE(Event, eventObj, event);
+
+		auto op = Emplace<OpSetEvent>();
+		if (!op)
+			return;
+
+		*op = OpSetEvent{
+			.EventObject = eventObj,
+			.StageMask = stageMask,
+		};
+	}
+
+	inline void CommandBuffer::PushResetEvent(VkEvent event, VkPipelineStageFlags stageMask)
+	{
+		VKD_FROM_HANDLE(Event, eventObj, event);
+
+		auto op = Emplace<OpResetEvent>();
+		if (!op)
+			return;
+
+		*op = OpResetEvent{
+			.EventObject = eventObj,
+			.StageMask = stageMask,
+		};
+	}
+
+	inline void CommandBuffer::PushWaitEvents(std::span<const VkEvent> events, VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask)
+	{
+		const std::size_t count = events.size();
+		auto op = Emplace<OpWaitEvents>(CommandStream::InlineSize<Event*>(count));
+		if (!op)
+			return;
+
+		std::span<Event*> eventObjs = op.Reserve<Event*>(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			VKD_FROM_HANDLE(Event, eventObj, events[i]);
+			eventObjs[i] = eventObj;
+		}
+
+		op->Events = eventObjs;
+		op->SrcStageMask = srcStageMask;
+		op->DstStageMask = dstStageMask;
 	}
 
 	inline VkResult CommandBuffer::MarkSubmitted()
 	{
-		return Transition(State::Pending, {State::Executable});
+		SyncWithPool();
+
+		if (m_state != State::Executable)
+		{
+			CCT_ASSERT_FALSE("Only executable command buffers can be submitted, state is {}", static_cast<int>(m_state));
+			return VK_ERROR_VALIDATION_FAILED_EXT;
+		}
+
+		if (!(m_usageFlags & VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT))
+		{
+			UInt32 expected = 0;
+			if (!m_pendingCount.compare_exchange_strong(expected, 1, std::memory_order_acq_rel))
+			{
+				CCT_ASSERT_FALSE("Command buffer is already pending, it must be recorded with VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT to be submitted again");
+				return VK_ERROR_VALIDATION_FAILED_EXT;
+			}
+			return VK_SUCCESS;
+		}
+
+		m_pendingCount.fetch_add(1, std::memory_order_acq_rel);
+		return VK_SUCCESS;
+	}
+
+	inline void CommandBuffer::UnmarkSubmitted()
+	{
+		const UInt32 previous = m_pendingCount.fetch_sub(1, std::memory_order_acq_rel);
+		CCT_ASSERT(previous != 0, "Command buffer unmarked more times than it was submitted");
 	}
 
 	inline VkResult CommandBuffer::MarkComplete()
 	{
-		return Transition(State::Executable, {State::Pending});
+		const UInt32 previous = m_pendingCount.fetch_sub(1, std::memory_order_acq_rel);
+		CCT_ASSERT(previous != 0, "Command buffer completed more times than it was submitted");
+
+		// The application cannot touch the command buffer before this completion is signaled
+		if (previous == 1 && (m_usageFlags & VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT))
+			m_state = State::Invalid;
+
+		return VK_SUCCESS;
+	}
+
+	inline const CommandStream& CommandBuffer::GetCommands() const
+	{
+		return m_stream;
 	}
 
-	inline std::span<const CommandBuffer::Op> CommandBuffer::GetOps() const
+	inline const CommandOptimizer::Stats& CommandBuffer::GetOptimizerStats() const
 	{
-		return m_ops;
+		return m_optimizer.GetStats();
 	}
 
 	inline bool CommandBuffer::IsSealed() const
 	{
-		return m_state == State::Executable;
+		const State state = GetState();
+		return state == State::Executable || state == State::Pending;
+	}
+
+	inline bool CommandBuffer::IsPending() const
+	{
+		return m_pendingCount.load(std::memory_order_acquire) != 0;
+	}
+
+	inline CommandBuffer::State CommandBuffer::GetState() const
+	{
+		// A pool reset moves every command buffer back to the initial state without visiting them
+		if (m_state != State::Initial && m_poolGeneration != m_owner->GetCommandArena().GetGeneration())
+			return State::Initial;
+
+		if (m_state == State::Executable && IsPending())
+			return State::Pending;
+
+		return m_state;
+	}
+
+	inline UInt64 CommandBuffer::GetRecordingId() const
+	{
+		return m_recordingId;
+	}
+
+	inline void CommandBuffer::SyncWithPool()
+	{
+		if (m_state != State::Initial && m_poolGeneration != m_owner->GetCommandArena().GetGeneration())
+			ReleaseCommands();
+	}
+
+	inline VkResult CommandBuffer::Compile()
+	{
+		return VK_SUCCESS;
+	}
+
+	template<typename T>
+	inline CommandStream::Packet<T> CommandBuffer::Emplace(std::size_t inlineSize)
+	{
+		return m_stream.Emplace<T>(OpType<T>, inlineSize);
 	}
 
 	inline VkResult CommandBuffer::Transition(State to, std::initializer_list<State> allowed)
@@ -0,0 +1,301 @@
+/**
+ * @file CommandOptimizer.cpp
+ * @brief Implementation of the recorded command peephole pass
+ * @date 2026-10-16
+ */
+
+#include "Vkd/CommandBuffer/CommandOptimizer.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include "Vkd/CommandBuffer/CommandBuffer.hpp"
+#include "Vkd/CommandBuffer/OpAccess.hpp"
+
+namespace vkd
+{
+	namespace
+	{
+		constexpr UInt32 MaxTrackedVertexBindings = 32;
+
+		bool IsRemoved(const CommandHeader* command)
+		{
+			return command->Type == CommandStream::RemovedType;
+		}
+
+		template<typename T>
+		T& GetOp(CommandHeader* command)
+		{
+			CCT_ASSERT(command->Type == CommandBuffer::OpType<T>, "Unexpected command type {}", command->Type);
+			return *static_cast<T*>(command->GetPayload());
+		}
+
+		template<typename Op>
+		auto GetMutableRegions(Op& op)
+		{
+			// Regions live in the inline storage of the packet, which belongs to the stream being optimized
+			using Region = std::remove_const_t<typename decltype(op.regions)::element_type>;
+			return std::span<Region>(const_cast<Region*>(op.regions.data()), op.regions.size());
+		}
+
+		template<typename Region>
+		bool AreContiguous(const Region& first, const Region& second)
+		{
+			return first.srcOffset + first.size == second.srcOffset && first.dstOffset + first.size == second.dstOffset;
+		}
+
+		/// Merges contiguous regions of a single copy, returns the number of regions folded away.
+		template<typename Op>
+		UInt32 CompactRegions(Op& op)
+		{
+			auto regions = GetMutableRegions(op);
+			if (regions.size() < 2)
+				return 0;
+
+			std::size_t last = 0;
+			for (std::size_t i = 1; i < regions.size(); ++i)
+			{
+				if (AreContiguous(regions[last], regions[i]))
+					regions[last].size += regions[i].size;
+				else
+					regions[++last] = regions[i];
+			}
+
+			const std::size_t kept = last + 1;
+			const UInt32 merged = static_cast<UInt32>(regions.size() - kept);
+			op.regions = op.regions.first(kept);
+			return merged;
+		}
+
+		/// Folds the leading regions of next into the last region of previous, returns the number of regions folded.
+		template<typename Op>
+		UInt32 FoldRegions(Op& previous, Op& next)
+		{
+			if (previous.regions.empty() || previous.src != next.src || previous.dst != next.dst)
+				return 0;
+
+			auto& tail = GetMutableRegions(previous).back();
+			std::size_t folded = 0;
+			while (folded < next.regions.size() && AreContiguous(tail, next.regions[folded]))
+			{
+				tail.size += next.regions[folded].size;
+				++folded;
+			}
+
+			next.regions = next.regions.subspan(folded);
+			return static_cast<UInt32>(folded);
+		}
+
+		template<typename Op>
+		bool IsMergeable(const Op& op)
+		{
+			// Source and destination sharing an allocation may overlap, such copies keep their original split
+			return op.src && op.dst && op.src->GetMemory() && op.src->GetMemory() != op.dst->GetMemory();
+		}
+
+		bool IsDeadWriteCandidate(UInt32 type)
+		{
+			return type == CommandBuffer::OpType<Buffer::OpFill> || type == CommandBuffer::OpType<Buffer::OpUpdate> || type == CommandBuffer::OpType<Image::OpClearColorImage>;
+		}
+
+		bool IsBind(UInt32 type)
+		{
+			return type == CommandBuffer::OpType<OpBindPipeline> || type == CommandBuffer::OpType<OpBindVertexBuffer>;
+		}
+	} // namespace
+
+	void CommandOptimizer::Run(CommandStream& stream)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		m_stats = {};
+		m_commands.clear();
+		m_commands.reserve(stream.GetCommandCount());
+		for (CommandHeader& command : stream)
+			m_commands.push_back(&command);
+
+		RemoveRedundantBinds(stream);
+		MergeCopies(stream);
+		RemoveDeadWrites(stream);
+	}
+
+	void CommandOptimizer::RemoveRedundantBinds(CommandStream& stream)
+	{
+		std::array<const Pipeline*, 2> pipelines = {}; // graphics, compute
+		std::array<const Buffer*, MaxTrackedVertexBindings> vertexBuffers = {};
+		std::array<VkDeviceSize, MaxTrackedVertexBindings> vertexOffsets = {};
+		UInt32 knownVertexBindings = 0;
+
+		for (CommandHeader* command : m_commands)
+		{
+			if (IsRemoved(command))
+				continue;
+
+			if (command->Type == CommandBuffer::OpType<OpBindPipeline>)
+			{
+				const auto& op = GetOp<OpBindPipeline>(command);
+				if (op.BindPoint != VK_PIPELINE_BIND_POINT_GRAPHICS && op.BindPoint != VK_PIPELINE_BIND_POINT_COMPUTE)
+					continue;
+
+				const Pipeline*& bound = pipelines[op.BindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS ? 0 : 1];
+				if (op.PipelineObject && bound == op.PipelineObject)
+				{
+					stream.Remove(*command);
+					++m_stats.RemovedBinds;
+				}
+				bound = op.PipelineObject;
+			}
+			else if (command->Type == CommandBuffer::OpType<OpBindVertexBuffer>)
+			{
+				const auto& op = GetOp<OpBindVertexBuffer>(command);
+				if (op.FirstBinding + op.Buffers.size() > MaxTrackedVertexBindings)
+				{
+					knownVertexBindings = 0;
+					continue;
+				}
+
+				bool redundant = !op.Buffers.empty();
+				for (std::size_t i = 0; i < op.Buffers.size(); ++i)
+				{
+					const UInt32 binding = op.FirstBinding + static_cast<UInt32>(i);
+					const bool known = knownVertexBindings & (1u << binding);
+					redundant = redundant && known && vertexBuffers[binding] == op.Buffers[i] && vertexOffsets[binding] == op.Offsets[i];
+
+					vertexBuffers[binding] = op.Buffers[i];
+					vertexOffsets[binding] = op.Offsets[i];
+					knownVertexBindings |= 1u << binding;
+				}
+
+				if (redundant)
+				{
+					stream.Remove(*command);
+					++m_stats.RemovedBinds;
+				}
+			}
+			else if (command->Type == CommandBuffer::OpType<OpExecuteCommands>)
+			{
+				// Secondaries start from a reset context and leave their own bindings behind
+				pipelines = {};
+				knownVertexBindings = 0;
+			}
+		}
+	}
+
+	void CommandOptimizer::MergeCopies(CommandStream& stream)
+	{
+		CommandHeader* previous = nullptr;
+
+		for (CommandHeader* command : m_commands)
+		{
+			if (IsRemoved(command))
+				continue;
+
+			UInt32 foldedRegions = 0;
+			bool emptied = false;
+			if (command->Type == CommandBuffer::OpType<Buffer::OpCopy>)
+			{
+				auto& op = GetOp<Buffer::OpCopy>(command);
+				if (!IsMergeable(op))
+				{
+					previous = nullptr;
+					continue;
+				}
+
+				m_stats.MergedRegions += CompactRegions(op);
+				if (previous && previous->Type == command->Type)
+				{
+					foldedRegions = FoldRegions(GetOp<Buffer::OpCopy>(previous), op);
+					emptied = op.regions.empty();
+				}
+			}
+			else if (command->Type == CommandBuffer::OpType<Buffer::OpCopy2>)
+			{
+				auto& op = GetOp<Buffer::OpCopy2>(command);
+				if (!IsMergeable(op))
+				{
+					previous = nullptr;
+					continue;
+				}
+
+				m_stats.MergedRegions += CompactRegions(op);
+				if (previous && previous->Type == command->Type)
+				{
+					foldedRegions = FoldRegions(GetOp<Buffer::OpCopy2>(previous), op);
+					emptied = op.regions.empty();
+				}
+			}
+			else
+			{
+				// Binds can sit between two copies without ordering them, barriers and events order
+				// the copies against other work even though they touch no memory themselves
+				if (!IsBind(command->Type))
+					previous = nullptr;
+				continue;
+			}
+
+			m_stats.MergedRegions += foldedRegions;
+			if (emptied)
+			{
+				stream.Remove(*command);
+				++m_stats.MergedCopies;
+				continue;
+			}
+
+			previous = command;
+		}
+	}
+
+	void CommandOptimizer::RemoveDeadWrites(CommandStream& stream)
+	{
+		for (std::size_t i = 0; i < m_commands.size(); ++i)
+		{
+			CommandHeader* command = m_commands[i];
+			if (IsRemoved(command) || !IsDeadWriteCandidate(command->Type))
+				continue;
+
+			const OpAccessList accesses = GetOpAccesses(*command);
+			if (accesses.Opaque || accesses.Count != 1)
+				continue;
+
+			const MemoryAccess& write = accesses.Accesses[0];
+			const std::size_t end = std::min(m_commands.size(), i + 1 + MaxDeadWriteLookahead);
+			for (std::size_t j = i + 1; j < end; ++j)
+			{
+				if (IsRemoved(m_commands[j]))
+					continue;
+
+				// The host may read the memory as soon as the event is set
+				if (m_commands[j]->Type == CommandBuffer::OpType<OpSetEvent>)
+					break;
+
+				const OpAccessList nextAccesses = GetOpAccesses(*m_commands[j]);
+				if (nextAccesses.Opaque)
+					break;
+
+				bool read = false;
+				bool overwritten = false;
+				for (UInt32 k = 0; k < nextAccesses.Count; ++k)
+				{
+					const MemoryAccess& access = nextAccesses.Accesses[k];
+					if (!access.Overlaps(write))
+						continue;
+
+					if (!access.Write)
+						read = true;
+					else if (access.Discards && access.Covers(write))
+						overwritten = true;
+				}
+
+				if (read)
+					break;
+
+				if (overwritten)
+				{
+					stream.Remove(*command);
+					++m_stats.RemovedDeadWrites;
+					break;
+				}
+			}
+		}
+	}
+} // namespace vkd
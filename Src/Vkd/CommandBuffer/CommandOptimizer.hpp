@@ -0,0 +1,54 @@
+/**
+ * @file CommandOptimizer.hpp
+ * @brief Peephole pass over recorded commands
+ * @date 2026-10-16
+ *
+ * Runs at vkEndCommandBuffer when enabled on the device (VKD_OPTIMIZE_COMMANDS=1)
+ * and rewrites the command stream in place: binds restating the current state are
+ * dropped, contiguous buffer copy regions are merged and fills / clears / updates
+ * fully overwritten before being read are eliminated.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "Vkd/CommandBuffer/CommandStream.hpp"
+#include "Vkd/Defines.hpp"
+
+namespace vkd
+{
+	class CommandOptimizer
+	{
+	public:
+		struct Stats
+		{
+			UInt32 RemovedBinds = 0;
+			UInt32 MergedCopies = 0; ///< Copy commands folded into a previous one
+			UInt32 MergedRegions = 0;
+			UInt32 RemovedDeadWrites = 0;
+
+			[[nodiscard]] inline UInt32 GetRemovedCommandCount() const;
+		};
+
+		/// Bounds the forward search of the dead write pass
+		static constexpr std::size_t MaxDeadWriteLookahead = 64;
+
+		CommandOptimizer() = default;
+
+		void Run(CommandStream& stream);
+
+		/// Statistics of the last run
+		[[nodiscard]] inline const Stats& GetStats() const;
+
+	private:
+		void RemoveRedundantBinds(CommandStream& stream);
+		void MergeCopies(CommandStream& stream);
+		void RemoveDeadWrites(CommandStream& stream);
+
+		std::vector<CommandHeader*> m_commands;
+		Stats m_stats;
+	};
+} // namespace vkd
+
+#include "Vkd/CommandBuffer/CommandOptimizer.inl"
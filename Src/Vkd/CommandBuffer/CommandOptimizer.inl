@@ -0,0 +1,22 @@
+/**
+ * @file CommandOptimizer.inl
+ * @brief Inline implementations for CommandOptimizer
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include "Vkd/CommandBuffer/CommandOptimizer.hpp"
+
+namespace vkd
+{
+	inline UInt32 CommandOptimizer::Stats::GetRemovedCommandCount() const
+	{
+		return RemovedBinds + MergedCopies + RemovedDeadWrites;
+	}
+
+	inline const CommandOptimizer::Stats& CommandOptimizer::GetStats() const
+	{
+		return m_stats;
+	}
+} // namespace vkd
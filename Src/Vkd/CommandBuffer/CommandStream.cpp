@@ -0,0 +1,66 @@
+/**
+ * @file CommandStream.cpp
+ * @brief Implementation of the recorded command packet stream
+ * @date 2026-10-16
+ */
+
+#include "Vkd/CommandBuffer/CommandStream.hpp"
+
+namespace vkd
+{
+	CommandStream::CommandStream() :
+		m_arena(nullptr),
+		m_firstBlock(nullptr),
+		m_currentBlock(nullptr),
+		m_commandCount(0),
+		m_byteSize(0),
+		m_generation(0),
+		m_failed(false)
+	{
+	}
+
+	CommandStream::~CommandStream()
+	{
+		Reset();
+	}
+
+	void CommandStream::Reset()
+	{
+		if (m_firstBlock && m_generation == m_arena->GetGeneration())
+			m_arena->ReleaseBlocks(m_firstBlock);
+
+		m_firstBlock = nullptr;
+		m_currentBlock = nullptr;
+		m_commandCount = 0;
+		m_byteSize = 0;
+		m_failed = false;
+	}
+
+	std::byte* CommandStream::AllocatePacket(std::size_t size)
+	{
+		if (!m_currentBlock || m_currentBlock->Capacity - m_currentBlock->Used < size)
+		{
+			CCT_ASSERT(m_arena, "Command stream used before its arena was set");
+
+			CommandArena::Block* block = m_arena->AcquireBlock(size);
+			if (!block)
+			{
+				m_failed = true;
+				return nullptr;
+			}
+
+			if (m_currentBlock)
+				m_currentBlock->Next = block;
+			else
+			{
+				m_firstBlock = block;
+				m_generation = m_arena->GetGeneration();
+			}
+			m_currentBlock = block;
+		}
+
+		std::byte* memory = m_currentBlock->GetData() + m_currentBlock->Used;
+		m_currentBlock->Used += size;
+		return memory;
+	}
+} // namespace vkd
@@ -0,0 +1,138 @@
+/**
+ * @file CommandStream.hpp
+ * @brief Linear packet stream holding recorded commands
+ * @date 2026-10-16
+ *
+ * Commands are encoded as variable-length packets (a header followed by the op
+ * structure and its inline arrays) bump-allocated into blocks from the owning
+ * pool's CommandArena, so recording a command does not touch the heap.
+ */
+
+#pragma once
+
+#include <iterator>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include "Vkd/CommandPool/CommandArena.hpp"
+#include "Vkd/Defines.hpp"
+
+namespace vkd
+{
+	struct CommandHeader
+	{
+		UInt32 Type;
+		UInt32 Size; ///< Whole packet size in bytes, header included
+
+		[[nodiscard]] inline void* GetPayload();
+		[[nodiscard]] inline const void* GetPayload() const;
+	};
+
+	class CommandStream
+	{
+	public:
+		static constexpr std::size_t PacketAlignment = 8;
+
+		template<typename T>
+		class Packet
+		{
+		public:
+			inline Packet(T* op, std::byte* inlineData);
+
+			[[nodiscard]] inline T* operator->() const;
+			[[nodiscard]] inline T& operator*() const;
+			[[nodiscard]] inline explicit operator bool() const;
+
+			/// Copies count elements into the packet inline storage, the caller must have reserved InlineSize<U>(count) bytes.
+			template<typename U>
+			std::span<const U> Append(const U* data, std::size_t count);
+			/// Carves count uninitialized elements out of the packet inline storage.
+			template<typename U>
+			std::span<U> Reserve(std::size_t count);
+
+		private:
+			T* m_op;
+			std::byte* m_inlineData;
+		};
+
+		template<bool IsConst>
+		class BasicIterator
+		{
+		public:
+			using BlockType = std::conditional_t<IsConst, const CommandArena::Block, CommandArena::Block>;
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = CommandHeader;
+			using difference_type = std::ptrdiff_t;
+			using pointer = std::conditional_t<IsConst, const CommandHeader*, CommandHeader*>;
+			using reference = std::conditional_t<IsConst, const CommandHeader&, CommandHeader&>;
+
+			BasicIterator() = default;
+			inline explicit BasicIterator(BlockType* block);
+
+			[[nodiscard]] inline reference operator*() const;
+			[[nodiscard]] inline pointer operator->() const;
+			inline BasicIterator& operator++();
+			inline BasicIterator operator++(int);
+			[[nodiscard]] bool operator==(const BasicIterator& other) const = default;
+
+		private:
+			inline void SkipRemovedPackets();
+
+			BlockType* m_block = nullptr;
+			std::size_t m_offset = 0;
+		};
+
+		using Iterator = BasicIterator<true>;
+		using MutableIterator = BasicIterator<false>;
+
+		/// Packet type of commands dropped after recording, skipped by iteration
+		static constexpr UInt32 RemovedType = std::numeric_limits<UInt32>::max();
+
+		CommandStream();
+		CommandStream(const CommandStream&) = delete;
+		CommandStream(CommandStream&&) = delete;
+		~CommandStream();
+
+		CommandStream& operator=(const CommandStream&) = delete;
+		CommandStream& operator=(CommandStream&&) = delete;
+
+		inline void SetArena(CommandArena& arena);
+
+		/// Appends a value-initialized op of type T followed by inlineSize bytes of inline storage.
+		/// On allocation failure the returned packet is empty and the stream is flagged as failed.
+		template<typename T>
+		Packet<T> Emplace(UInt32 type, std::size_t inlineSize = 0);
+		/// Gives every block back to the arena, blocks already reclaimed by a pool reset are simply dropped.
+		void Reset();
+		/// Drops an already recorded command, its storage stays in place until the stream is reset.
+		inline void Remove(CommandHeader& command);
+
+		template<typename U>
+		[[nodiscard]] static constexpr std::size_t InlineSize(std::size_t count);
+		[[nodiscard]] static constexpr std::size_t AlignSize(std::size_t size);
+
+		[[nodiscard]] inline Iterator begin() const;
+		[[nodiscard]] inline Iterator end() const;
+		[[nodiscard]] inline MutableIterator begin();
+		[[nodiscard]] inline MutableIterator end();
+
+		[[nodiscard]] inline std::size_t GetCommandCount() const;
+		[[nodiscard]] inline std::size_t GetByteSize() const;
+		[[nodiscard]] inline bool IsEmpty() const;
+		[[nodiscard]] inline bool HasFailed() const;
+
+	private:
+		std::byte* AllocatePacket(std::size_t size);
+
+		CommandArena* m_arena;
+		CommandArena::Block* m_firstBlock;
+		CommandArena::Block* m_currentBlock;
+		std::size_t m_commandCount;
+		std::size_t m_byteSize;
+		UInt64 m_generation;
+		bool m_failed;
+	};
+} // namespace vkd
+
+#include "Vkd/CommandBuffer/CommandStream.inl"
@@ -0,0 +1,217 @@
+/**
+ * @file CommandStream.inl
+ * @brief Inline implementations for CommandStream
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include <cstring>
+#include <new>
+
+#include "Vkd/CommandBuffer/CommandStream.hpp"
+
+namespace vkd
+{
+	static_assert(sizeof(CommandHeader) % CommandStream::PacketAlignment == 0, "Packet payloads must stay aligned");
+
+	inline void* CommandHeader::GetPayload()
+	{
+		return reinterpret_cast<std::byte*>(this) + sizeof(CommandHeader);
+	}
+
+	inline const void* CommandHeader::GetPayload() const
+	{
+		return reinterpret_cast<const std::byte*>(this) + sizeof(CommandHeader);
+	}
+
+	template<typename T>
+	inline CommandStream::Packet<T>::Packet(T* op, std::byte* inlineData) :
+		m_op(op),
+		m_inlineData(inlineData)
+	{
+	}
+
+	template<typename T>
+	inline T* CommandStream::Packet<T>::operator->() const
+	{
+		return m_op;
+	}
+
+	template<typename T>
+	inline T& CommandStream::Packet<T>::operator*() const
+	{
+		return *m_op;
+	}
+
+	template<typename T>
+	inline CommandStream::Packet<T>::operator bool() const
+	{
+		return m_op != nullptr;
+	}
+
+	template<typename T>
+	template<typename U>
+	std::span<const U> CommandStream::Packet<T>::Append(const U* data, std::size_t count)
+	{
+		std::span<U> storage = Reserve<U>(count);
+		if (count != 0)
+			std::memcpy(storage.data(), data, count * sizeof(U));
+		return storage;
+	}
+
+	template<typename T>
+	template<typename U>
+	std::span<U> CommandStream::Packet<T>::Reserve(std::size_t count)
+	{
+		static_assert(std::is_trivially_copyable_v<U> && std::is_trivially_destructible_v<U>);
+		static_assert(alignof(U) <= PacketAlignment);
+
+		U* storage = reinterpret_cast<U*>(m_inlineData);
+		m_inlineData += InlineSize<U>(count);
+		return {storage, count};
+	}
+
+	template<bool IsConst>
+	inline CommandStream::BasicIterator<IsConst>::BasicIterator(BlockType* block) :
+		m_block(block),
+		m_offset(0)
+	{
+		SkipRemovedPackets();
+	}
+
+	template<bool IsConst>
+	inline auto CommandStream::BasicIterator<IsConst>::operator*() const -> reference
+	{
+		return *operator->();
+	}
+
+	template<bool IsConst>
+	inline auto CommandStream::BasicIterator<IsConst>::operator->() const -> pointer
+	{
+		return reinterpret_cast<pointer>(m_block->GetData() + m_offset);
+	}
+
+	template<bool IsConst>
+	inline auto CommandStream::BasicIterator<IsConst>::operator++() -> BasicIterator&
+	{
+		m_offset += (**this).Size;
+		SkipRemovedPackets();
+		return *this;
+	}
+
+	template<bool IsConst>
+	inline auto CommandStream::BasicIterator<IsConst>::operator++(int) -> BasicIterator
+	{
+		BasicIterator it = *this;
+		++(*this);
+		return it;
+	}
+
+	template<bool IsConst>
+	inline void CommandStream::BasicIterator<IsConst>::SkipRemovedPackets()
+	{
+		while (m_block)
+		{
+			if (m_offset >= m_block->Used)
+			{
+				m_block = m_block->Next;
+				m_offset = 0;
+				continue;
+			}
+
+			if ((**this).Type != RemovedType)
+				return;
+
+			m_offset += (**this).Size;
+		}
+		m_offset = 0;
+	}
+
+	inline void CommandStream::SetArena(CommandArena& arena)
+	{
+		CCT_ASSERT(m_firstBlock == nullptr, "Cannot change the arena of a non-empty command stream");
+		m_arena = &arena;
+	}
+
+	inline void CommandStream::Remove(CommandHeader& command)
+	{
+		CCT_ASSERT(command.Type != RemovedType, "Command already removed");
+		command.Type = RemovedType;
+		--m_commandCount;
+	}
+
+	template<typename T>
+	CommandStream::Packet<T> CommandStream::Emplace(UInt32 type, std::size_t inlineSize)
+	{
+		static_assert(std::is_trivially_destructible_v<T>, "Ops are never destroyed, they must be trivially destructible");
+		static_assert(alignof(T) <= PacketAlignment);
+
+		const std::size_t packetSize = sizeof(CommandHeader) + AlignSize(sizeof(T)) + inlineSize;
+		CCT_ASSERT(packetSize <= std::numeric_limits<UInt32>::max(), "Command packet too large");
+
+		std::byte* memory = AllocatePacket(packetSize);
+		if (!memory)
+			return {nullptr, nullptr};
+
+		new (memory) CommandHeader{type, static_cast<UInt32>(packetSize)};
+		std::byte* payload = memory + sizeof(CommandHeader);
+		T* op = new (payload) T{};
+
+		++m_commandCount;
+		m_byteSize += packetSize;
+
+		return {op, payload + AlignSize(sizeof(T))};
+	}
+
+	template<typename U>
+	constexpr std::size_t CommandStream::InlineSize(std::size_t count)
+	{
+		return AlignSize(count * sizeof(U));
+	}
+
+	constexpr std::size_t CommandStream::AlignSize(std::size_t size)
+	{
+		return (size + PacketAlignment - 1) & ~(PacketAlignment - 1);
+	}
+
+	inline CommandStream::Iterator CommandStream::begin() const
+	{
+		return Iterator(m_firstBlock);
+	}
+
+	inline CommandStream::Iterator CommandStream::end() const
+	{
+		return Iterator();
+	}
+
+	inline CommandStream::MutableIterator CommandStream::begin()
+	{
+		return MutableIterator(m_firstBlock);
+	}
+
+	inline CommandStream::MutableIterator CommandStream::end()
+	{
+		return MutableIterator();
+	}
+
+	inline std::size_t CommandStream::GetCommandCount() const
+	{
+		return m_commandCount;
+	}
+
+	inline std::size_t CommandStream::GetByteSize() const
+	{
+		return m_byteSize;
+	}
+
+	inline bool CommandStream::IsEmpty() const
+	{
+		return m_commandCount == 0;
+	}
+
+	inline bool CommandStream::HasFailed() const
+	{
+		return m_failed;
+	}
+} // namespace vkd
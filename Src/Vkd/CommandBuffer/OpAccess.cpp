@@ -0,0 +1,224 @@
+/**
+ * @file OpAccess.cpp
+ * @brief Implementation of op memory access collection
+ * @date 2026-10-16
+ */
+
+#include "Vkd/CommandBuffer/OpAccess.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "Vkd/CommandBuffer/CommandBuffer.hpp"
+
+namespace vkd
+{
+	namespace
+	{
+		MemoryAccess BufferAccess(const Buffer* buffer, VkDeviceSize offset, VkDeviceSize size, bool write, bool discards)
+		{
+			if (!buffer || !buffer->GetMemory())
+				return MemoryAccess{nullptr, 0, 0, write, false};
+			return MemoryAccess{buffer->GetMemory(), buffer->GetMemoryOffset() + offset, size, write, discards};
+		}
+
+		MemoryAccess ImageAccess(const Image* image, bool write, bool discards)
+		{
+			if (!image || !image->GetMemory())
+				return MemoryAccess{nullptr, 0, 0, write, false};
+
+			VkMemoryRequirements requirements = {};
+			image->GetMemoryRequirements(requirements);
+			return MemoryAccess{image->GetMemory(), image->GetMemoryOffset(), requirements.size, write, discards};
+		}
+
+		bool CoversAllSubresources(const Image& image, std::span<const VkImageSubresourceRange> ranges)
+		{
+			for (const VkImageSubresourceRange& range : ranges)
+			{
+				const bool allLevels = range.baseMipLevel == 0 && (range.levelCount == VK_REMAINING_MIP_LEVELS || range.levelCount >= image.GetMipLevels());
+				const bool allLayers = range.baseArrayLayer == 0 && (range.layerCount == VK_REMAINING_ARRAY_LAYERS || range.layerCount >= image.GetArrayLayers());
+				if (allLevels && allLayers && (range.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT))
+					return true;
+			}
+			return false;
+		}
+
+		template<typename Region>
+		void AddBufferCopyAccesses(OpAccessList& accesses, const Buffer* src, const Buffer* dst, std::span<const Region> regions)
+		{
+			if (regions.empty())
+				return;
+
+			VkDeviceSize srcBegin = std::numeric_limits<VkDeviceSize>::max();
+			VkDeviceSize dstBegin = std::numeric_limits<VkDeviceSize>::max();
+			VkDeviceSize srcEnd = 0;
+			VkDeviceSize dstEnd = 0;
+			for (const Region& region : regions)
+			{
+				srcBegin = std::min(srcBegin, region.srcOffset);
+				dstBegin = std::min(dstBegin, region.dstOffset);
+				srcEnd = std::max(srcEnd, region.srcOffset + region.size);
+				dstEnd = std::max(dstEnd, region.dstOffset + region.size);
+			}
+
+			accesses.Add(BufferAccess(src, srcBegin, srcEnd - srcBegin, false, false));
+			// Regions may leave holes in the bounding range, it is not fully overwritten
+			accesses.Add(BufferAccess(dst, dstBegin, dstEnd - dstBegin, true, regions.size() == 1));
+		}
+
+		VkDeviceSize LowestBufferOffset(std::span<const VkBufferImageCopy> regions)
+		{
+			VkDeviceSize offset = std::numeric_limits<VkDeviceSize>::max();
+			for (const VkBufferImageCopy& region : regions)
+				offset = std::min(offset, region.bufferOffset);
+			return offset;
+		}
+
+		template<typename T>
+		OpAccessList Collect(const T& /*op*/)
+		{
+			OpAccessList accesses;
+			accesses.Opaque = true;
+			return accesses;
+		}
+
+		OpAccessList Collect(const Buffer::OpFill& op)
+		{
+			VkDeviceSize size = op.size;
+			if (size == VK_WHOLE_SIZE && op.dst)
+				size = (op.dst->GetSize() - op.offset) & ~VkDeviceSize(3);
+
+			OpAccessList accesses;
+			accesses.Add(BufferAccess(op.dst, op.offset, size, true, true));
+			return accesses;
+		}
+
+		OpAccessList Collect(const Buffer::OpCopy& op)
+		{
+			OpAccessList accesses;
+			AddBufferCopyAccesses(accesses, op.src, op.dst, op.regions);
+			return accesses;
+		}
+
+		OpAccessList Collect(const Buffer::OpCopy2& op)
+		{
+			OpAccessList accesses;
+			AddBufferCopyAccesses(accesses, op.src, op.dst, op.regions);
+			return accesses;
+		}
+
+		OpAccessList Collect(const Buffer::OpUpdate& op)
+		{
+			OpAccessList accesses;
+			accesses.Add(BufferAccess(op.dst, op.offset, op.data.size(), true, true));
+			return accesses;
+		}
+
+		OpAccessList Collect(const Buffer::OpCopyBufferToImage& op)
+		{
+			OpAccessList accesses;
+			if (op.regions.empty())
+				return accesses;
+
+			// Row pitches are not resolved here, the source is read up to the end of the buffer
+			const VkDeviceSize offset = LowestBufferOffset(op.regions);
+			accesses.Add(BufferAccess(op.src, offset, op.src ? op.src->GetSize() - offset : 0, false, false));
+			accesses.Add(ImageAccess(op.dst, true, false));
+			return accesses;
+		}
+
+		OpAccessList Collect(const Buffer::OpCopyImageToBuffer& op)
+		{
+			OpAccessList accesses;
+			if (op.regions.empty())
+				return accesses;
+
+			const VkDeviceSize offset = LowestBufferOffset(op.regions);
+			accesses.Add(ImageAccess(op.src, false, false));
+			accesses.Add(BufferAccess(op.dst, offset, op.dst ? op.dst->GetSize() - offset : 0, true, false));
+			return accesses;
+		}
+
+		OpAccessList Collect(const Image::OpCopy& op)
+		{
+			OpAccessList accesses;
+			if (op.regions.empty())
+				return accesses;
+
+			accesses.Add(ImageAccess(op.src, false, false));
+			accesses.Add(ImageAccess(op.dst, true, false));
+			return accesses;
+		}
+
+		OpAccessList Collect(const Image::OpClearColorImage& op)
+		{
+			OpAccessList accesses;
+			if (op.ranges.empty())
+				return accesses;
+
+			accesses.Add(ImageAccess(op.image, true, op.image && CoversAllSubresources(*op.image, op.ranges)));
+			return accesses;
+		}
+
+		// Binding state is only consumed by draws, which are opaque
+		OpAccessList Collect(const OpBindVertexBuffer& /*op*/)
+		{
+			return {};
+		}
+
+		OpAccessList Collect(const OpBindPipeline& /*op*/)
+		{
+			return {};
+		}
+
+		// Ordering across barriers is handled by the passes themselves
+		OpAccessList Collect(const OpPipelineBarrier& /*op*/)
+		{
+			return {};
+		}
+
+		OpAccessList Collect(const OpSetEvent& /*op*/)
+		{
+			return {};
+		}
+
+		OpAccessList Collect(const OpResetEvent& /*op*/)
+		{
+			return {};
+		}
+
+		OpAccessList Collect(const OpWaitEvents& /*op*/)
+		{
+			return {};
+		}
+
+		using Collector = OpAccessList (*)(const void* op);
+
+		template<typename T>
+		OpAccessList CollectOp(const void* op)
+		{
+			return Collect(*static_cast<const T*>(op));
+		}
+
+		template<typename... Ts>
+		constexpr std::array<Collector, sizeof...(Ts)> MakeCollectorTable(Nz::TypeList<Ts...>)
+		{
+			return {&CollectOp<Ts>...};
+		}
+	} // namespace
+
+	OpAccessList GetOpAccesses(const CommandHeader& command)
+	{
+		static constexpr auto collectors = MakeCollectorTable(CommandBuffer::AllOps{});
+
+		if (command.Type >= collectors.size())
+		{
+			OpAccessList accesses;
+			accesses.Opaque = true;
+			return accesses;
+		}
+
+		return collectors[command.Type](command.GetPayload());
+	}
+} // namespace vkd
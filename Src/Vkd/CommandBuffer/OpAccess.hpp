@@ -0,0 +1,52 @@
+/**
+ * @file OpAccess.hpp
+ * @brief Memory ranges read and written by recorded ops
+ * @date 2026-10-16
+ *
+ * Describes what a recorded command touches in terms of device memory ranges so
+ * passes over a command stream can reason about dependencies, including between
+ * resources aliasing the same allocation. Images are tracked as a whole.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "Vkd/Defines.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace vkd
+{
+	class DeviceMemory;
+	struct CommandHeader;
+
+	struct MemoryAccess
+	{
+		const DeviceMemory* Memory;
+		VkDeviceSize Offset; ///< Relative to the start of Memory
+		VkDeviceSize Size;
+		bool Write;
+		bool Discards; ///< Every byte of the range is overwritten without being read
+
+		[[nodiscard]] inline bool Overlaps(const MemoryAccess& other) const;
+		[[nodiscard]] inline bool Covers(const MemoryAccess& other) const;
+	};
+
+	struct OpAccessList
+	{
+		static constexpr std::size_t MaxAccesses = 2;
+
+		std::array<MemoryAccess, MaxAccesses> Accesses;
+		UInt32 Count = 0;
+		bool Opaque = false; ///< Depends on state outside the op itself (draws, secondaries, unbound resources)
+
+		inline void Add(const MemoryAccess& access);
+		[[nodiscard]] inline bool Overlaps(const MemoryAccess& access) const;
+	};
+
+	/// Collects the memory accesses of a recorded command, ops the analysis does not understand are reported as opaque.
+	OpAccessList GetOpAccesses(const CommandHeader& command);
+} // namespace vkd
+
+#include "Vkd/CommandBuffer/OpAccess.inl"
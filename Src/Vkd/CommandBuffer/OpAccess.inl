@@ -0,0 +1,43 @@
+/**
+ * @file OpAccess.inl
+ * @brief Inline implementations for op memory accesses
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include "Vkd/CommandBuffer/OpAccess.hpp"
+
+namespace vkd
+{
+	inline bool MemoryAccess::Overlaps(const MemoryAccess& other) const
+	{
+		return Memory == other.Memory && Offset < other.Offset + other.Size && other.Offset < Offset + Size;
+	}
+
+	inline bool MemoryAccess::Covers(const MemoryAccess& other) const
+	{
+		return Memory == other.Memory && Offset <= other.Offset && other.Offset + other.Size <= Offset + Size;
+	}
+
+	inline void OpAccessList::Add(const MemoryAccess& access)
+	{
+		CCT_ASSERT(Count < MaxAccesses, "Too many accesses for a single op");
+		if (!access.Memory)
+		{
+			Opaque = true;
+			return;
+		}
+		Accesses[Count++] = access;
+	}
+
+	inline bool OpAccessList::Overlaps(const MemoryAccess& access) const
+	{
+		for (UInt32 i = 0; i < Count; ++i)
+		{
+			if (Accesses[i].Overlaps(access))
+				return true;
+		}
+		return false;
+	}
+} // namespace vkd
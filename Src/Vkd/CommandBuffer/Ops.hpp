@@ -8,14 +8,20 @@
 
 #pragma once
 
+#include <span>
+#include <type_traits>
+
 #include <NazaraUtils/TypeList.hpp>
 
 namespace vkd
 {
+	class CommandBuffer;
+	class Event;
+
 	struct OpBindVertexBuffer
 	{
-		std::vector<Buffer*> Buffers;
-		std::vector<VkDeviceSize> Offsets;
+		std::span<Buffer* const> Buffers;
+		std::span<const VkDeviceSize> Offsets;
 		UInt32 FirstBinding;
 	};
 
@@ -58,11 +64,71 @@ namespace vkd
 		Pipeline* PipelineObject;
 	};
 
+	/// Executes secondary command buffers by reference, their streams are walked in place
+	struct OpExecuteCommands
+	{
+		std::span<CommandBuffer* const> CommandBuffers;
+	};
+
+	/// Execution and memory dependency between the commands recorded before and after it.
+	/// Memory barrier ranges are not kept, every barrier orders all prior commands before all later ones.
+	struct OpPipelineBarrier
+	{
+		VkPipelineStageFlags SrcStageMask;
+		VkPipelineStageFlags DstStageMask;
+		VkDependencyFlags DependencyFlags;
+	};
+
+	/// Sets the event once the commands recorded before it executed
+	struct OpSetEvent
+	{
+		Event* EventObject;
+		VkPipelineStageFlags StageMask;
+	};
+
+	struct OpResetEvent
+	{
+		Event* EventObject;
+		VkPipelineStageFlags StageMask;
+	};
+
+	/// Orders the commands recorded after it after the ones recorded before the matching sets.
+	/// Commands recorded between a set and the wait are not ordered against the ones after it.
+	/// Memory barrier ranges are not kept, as for OpPipelineBarrier.
+	struct OpWaitEvents
+	{
+		std::span<Event* const> Events;
+		VkPipelineStageFlags SrcStageMask;
+		VkPipelineStageFlags DstStageMask;
+	};
+
 	using Op = Nz::TypeList<
 		OpBindVertexBuffer,
 		OpDraw,
 		OpDrawIndexed,
 		OpDrawIndirect,
 		OpDrawIndexedIndirect,
-		OpBindPipeline>;
+		OpBindPipeline,
+		OpExecuteCommands,
+		OpPipelineBarrier,
+		OpSetEvent,
+		OpResetEvent,
+		OpWaitEvents>;
+
+	/// Index of T in an op TypeList, used as the packet type of recorded commands
+	template<typename List, typename T>
+	struct OpIndex;
+
+	template<typename T, typename... Ts>
+	struct OpIndex<Nz::TypeList<Ts...>, T>
+	{
+		static_assert((std::is_same_v<T, Ts> || ...), "Type is not part of the op list");
+
+		static constexpr UInt32 Value = []
+		{
+			UInt32 index = 0;
+			[[maybe_unused]] bool found = ((std::is_same_v<T, Ts> ? true : (++index, false)) || ...);
+			return index;
+		}();
+	};
 } // namespace vkd
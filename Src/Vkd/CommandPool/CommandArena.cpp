@@ -0,0 +1,126 @@
+/**
+ * @file CommandArena.cpp
+ * @brief Implementation of the command recording block allocator
+ * @date 2026-10-16
+ */
+
+#include "Vkd/CommandPool/CommandArena.hpp"
+
+#include <algorithm>
+#include <new>
+
+#include "Vkd/Memory/Memory.hpp"
+
+namespace vkd
+{
+	CommandArena::CommandArena() :
+		m_allocationCallbacks(nullptr),
+		m_freeBlocks(nullptr),
+		m_usedHead(nullptr),
+		m_usedTail(nullptr),
+		m_freeBlockCount(0),
+		m_usedBlockCount(0),
+		m_maxCachedBlocks(UnlimitedCachedBlocks),
+		m_generation(0)
+	{
+	}
+
+	CommandArena::~CommandArena()
+	{
+		ReclaimAll();
+		Trim();
+	}
+
+	CommandArena::Block* CommandArena::AcquireBlock(std::size_t minCapacity)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		if (minCapacity <= BlockCapacity && m_freeBlocks)
+		{
+			Block* block = m_freeBlocks;
+			m_freeBlocks = block->ListNext;
+			--m_freeBlockCount;
+
+			block->Next = nullptr;
+			block->Used = 0;
+			LinkUsed(block);
+			return block;
+		}
+
+		CCT_ASSERT(m_allocationCallbacks, "CommandArena used before its allocation callbacks were set");
+
+		const std::size_t capacity = std::max(minCapacity, BlockCapacity);
+		void* memory = mem::Allocate(*m_allocationCallbacks, BlockHeaderSize + capacity, BlockAlignment, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+		if (!memory)
+			return nullptr;
+
+		Block* block = new (memory) Block;
+		block->Next = nullptr;
+		block->Capacity = capacity;
+		block->Used = 0;
+		LinkUsed(block);
+		return block;
+	}
+
+	void CommandArena::ReleaseBlocks(Block* first)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		while (first)
+		{
+			Block* next = first->Next;
+			UnlinkUsed(first);
+
+			// Oversized blocks only exist for single large packets (big vkCmdUpdateBuffer payloads,
+			// huge region lists), keeping them around would pin that memory for the pool lifetime.
+			if (first->Capacity == BlockCapacity && m_freeBlockCount < m_maxCachedBlocks)
+			{
+				first->ListNext = m_freeBlocks;
+				m_freeBlocks = first;
+				++m_freeBlockCount;
+			}
+			else
+				FreeBlock(first);
+
+			first = next;
+		}
+	}
+
+	void CommandArena::ReclaimAll()
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		++m_generation;
+		if (!m_usedHead)
+			return;
+
+		// Splice the whole used list in front of the cache, oversized blocks included: they are
+		// handed out again like regular ones and go away on the next Trim.
+		m_usedTail->ListNext = m_freeBlocks;
+		m_freeBlocks = m_usedHead;
+		m_freeBlockCount += m_usedBlockCount;
+
+		m_usedHead = nullptr;
+		m_usedTail = nullptr;
+		m_usedBlockCount = 0;
+	}
+
+	void CommandArena::Trim()
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		while (m_freeBlocks)
+		{
+			Block* next = m_freeBlocks->ListNext;
+			FreeBlock(m_freeBlocks);
+			m_freeBlocks = next;
+		}
+		m_freeBlockCount = 0;
+	}
+
+	void CommandArena::FreeBlock(Block* block)
+	{
+		block->~Block();
+		mem::Free(*m_allocationCallbacks, block);
+	}
+} // namespace vkd
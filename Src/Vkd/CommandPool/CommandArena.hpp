@@ -0,0 +1,81 @@
+/**
+ * @file CommandArena.hpp
+ * @brief Block allocator backing command buffer recording
+ * @date 2026-10-16
+ *
+ * Owned by a command pool, hands out fixed-size blocks to the command streams of
+ * the command buffers allocated from it and keeps released blocks for reuse.
+ * Blocks handed out are tracked so a pool reset can reclaim all of them at once.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "Vkd/Defines.hpp"
+
+namespace vkd
+{
+	class CommandArena
+	{
+	public:
+		struct Block
+		{
+			Block* Next; ///< Next block of the owning command stream
+			Block* ListPrev;
+			Block* ListNext; ///< Links in the arena used / free lists
+			std::size_t Capacity;
+			std::size_t Used;
+
+			[[nodiscard]] inline std::byte* GetData();
+			[[nodiscard]] inline const std::byte* GetData() const;
+		};
+
+		static constexpr std::size_t BlockAlignment = alignof(std::max_align_t);
+		static constexpr std::size_t BlockHeaderSize = (sizeof(Block) + BlockAlignment - 1) & ~(BlockAlignment - 1);
+		static constexpr std::size_t BlockSize = 64 * 1024;
+		static constexpr std::size_t BlockCapacity = BlockSize - BlockHeaderSize;
+		static constexpr std::size_t UnlimitedCachedBlocks = ~std::size_t(0);
+
+		CommandArena();
+		CommandArena(const CommandArena&) = delete;
+		CommandArena(CommandArena&&) = delete;
+		~CommandArena();
+
+		CommandArena& operator=(const CommandArena&) = delete;
+		CommandArena& operator=(CommandArena&&) = delete;
+
+		inline void SetAllocationCallbacks(const VkAllocationCallbacks& allocationCallbacks);
+		inline void SetMaxCachedBlocks(std::size_t maxCachedBlocks);
+
+		/// Returns an empty block holding at least minCapacity bytes, or nullptr when out of host memory.
+		Block* AcquireBlock(std::size_t minCapacity);
+		/// Gives a chain of blocks linked through Block::Next back to the arena.
+		void ReleaseBlocks(Block* first);
+		/// Moves every block handed out back to the cache in O(1) and starts a new generation.
+		/// Streams holding blocks from a previous generation must drop them without releasing.
+		void ReclaimAll();
+		/// Frees every cached block back to the allocation callbacks.
+		void Trim();
+
+		[[nodiscard]] inline std::size_t GetCachedBlockCount() const;
+		[[nodiscard]] inline std::size_t GetUsedBlockCount() const;
+		[[nodiscard]] inline UInt64 GetGeneration() const;
+
+	private:
+		void FreeBlock(Block* block);
+		inline void LinkUsed(Block* block);
+		inline void UnlinkUsed(Block* block);
+
+		const VkAllocationCallbacks* m_allocationCallbacks;
+		Block* m_freeBlocks;
+		Block* m_usedHead;
+		Block* m_usedTail;
+		std::size_t m_freeBlockCount;
+		std::size_t m_usedBlockCount;
+		std::size_t m_maxCachedBlocks;
+		UInt64 m_generation;
+	};
+} // namespace vkd
+
+#include "Vkd/CommandPool/CommandArena.inl"
@@ -0,0 +1,76 @@
+/**
+ * @file CommandArena.inl
+ * @brief Inline implementations for CommandArena
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include "Vkd/CommandPool/CommandArena.hpp"
+
+namespace vkd
+{
+	inline std::byte* CommandArena::Block::GetData()
+	{
+		return reinterpret_cast<std::byte*>(this) + BlockHeaderSize;
+	}
+
+	inline const std::byte* CommandArena::Block::GetData() const
+	{
+		return reinterpret_cast<const std::byte*>(this) + BlockHeaderSize;
+	}
+
+	inline void CommandArena::SetAllocationCallbacks(const VkAllocationCallbacks& allocationCallbacks)
+	{
+		m_allocationCallbacks = &allocationCallbacks;
+	}
+
+	inline void CommandArena::SetMaxCachedBlocks(std::size_t maxCachedBlocks)
+	{
+		m_maxCachedBlocks = maxCachedBlocks;
+	}
+
+	inline std::size_t CommandArena::GetCachedBlockCount() const
+	{
+		return m_freeBlockCount;
+	}
+
+	inline std::size_t CommandArena::GetUsedBlockCount() const
+	{
+		return m_usedBlockCount;
+	}
+
+	inline UInt64 CommandArena::GetGeneration() const
+	{
+		return m_generation;
+	}
+
+	inline void CommandArena::LinkUsed(Block* block)
+	{
+		block->ListPrev = m_usedTail;
+		block->ListNext = nullptr;
+		if (m_usedTail)
+			m_usedTail->ListNext = block;
+		else
+			m_usedHead = block;
+		m_usedTail = block;
+		++m_usedBlockCount;
+	}
+
+	inline void CommandArena::UnlinkUsed(Block* block)
+	{
+		if (block->ListPrev)
+			block->ListPrev->ListNext = block->ListNext;
+		else
+			m_usedHead = block->ListNext;
+
+		if (block->ListNext)
+			block->ListNext->ListPrev = block->ListPrev;
+		else
+			m_usedTail = block->ListPrev;
+
+		block->ListPrev = nullptr;
+		block->ListNext = nullptr;
+		--m_usedBlockCount;
+	}
+} // namespace vkd
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "Vkd/CommandPool/CommandArena.hpp"
 #include "Vkd/ObjectBase/ObjectBase.hpp"
 
 #include <vulkan/vulkan.h>
@@ -31,6 +32,7 @@ namespace vkd
 		[[nodiscard]] inline Device* GetOwner() const;
 		[[nodiscard]] inline VkCommandPoolCreateFlags GetFlags() const;
 		[[nodiscard]] inline UInt32 GetQueueFamilyIndex() const;
+		[[nodiscard]] inline CommandArena& GetCommandArena();
 
 		DispatchableObjectResult<CommandBuffer> AllocateCommandBuffer(VkCommandBufferLevel level);
 
@@ -38,11 +40,13 @@ namespace vkd
 
 		virtual VkResult Reset(VkCommandPoolResetFlags flags) = 0;
 		virtual DispatchableObjectResult<CommandBuffer> CreateCommandBuffer(VkCommandBufferLevel level) = 0;
+		virtual void FreeCommandBuffer(DispatchableObject<CommandBuffer>* commandBuffer) = 0;
 
 	private:
 		Device* m_owner;
 		VkCommandPoolCreateFlags m_flags;
 		UInt32 m_queueFamilyIndex;
+		CommandArena m_commandArena;
 	};
 } // namespace vkd
 
@@ -26,6 +26,7 @@ namespace vkd
 		m_queueFamilyIndex = createInfo.queueFamilyIndex;
 
 		SetAllocationCallbacks(pAllocator);
+		m_commandArena.SetAllocationCallbacks(pAllocator);
 
 		m_createResult = VK_SUCCESS;
 		return m_createResult;
@@ -48,4 +49,10 @@ namespace vkd
 		AssertValid();
 		return m_queueFamilyIndex;
 	}
+
+	inline CommandArena& CommandPool::GetCommandArena()
+	{
+		AssertValid();
+		return m_commandArena;
+	}
 } // namespace vkd
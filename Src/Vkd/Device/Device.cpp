@@ -5,8 +5,8 @@
  */
 
 #include <algorithm>
-#include <chrono>
-#include <thread>
+#include <ranges>
+#include <span>
 
 #include "Vkd/Buffer/Buffer.hpp"
 #include "Vkd/BufferView/BufferView.hpp"
@@ -21,13 +21,19 @@
 #include "Vkd/Queue/Queue.hpp"
 #include "Vkd/RenderPass/RenderPass.hpp"
 #include "Vkd/ShaderModule/ShaderModule.hpp"
+#include "Vkd/Synchronization/Event/Event.hpp"
 #include "Vkd/Synchronization/Fence/Fence.hpp"
+#include "Vkd/Synchronization/Semaphore/Semaphore.hpp"
+#include "VkdUtils/Futex/Futex.hpp"
+#include "VkdUtils/SyncWaiter/SyncWaiter.hpp"
+#include "VkdUtils/System/System.hpp"
 
 namespace vkd
 {
 	Device::Device() :
 		ObjectBase(ObjectType),
 		m_owner(nullptr),
+		m_commandOptimizationEnabled(false),
 		m_queues()
 	{
 	}
@@ -49,6 +55,7 @@ namespace vkd
 	{
 		m_owner = &owner;
 		SetAllocationCallbacks(allocationCallbacks);
+		m_commandOptimizationEnabled = System::IsEnvironmentFlagSet("VKD_OPTIMIZE_COMMANDS");
 
 #ifdef VKD_DEBUG_CHECKS
 		m_createResult = VK_SUCCESS; // avoid false positive in AssertValid()
@@ -64,6 +71,12 @@ namespace vkd
 		return m_owner;
 	}
 
+	bool Device::IsCommandOptimizationEnabled() const
+	{
+		AssertValid();
+		return m_commandOptimizationEnabled;
+	}
+
 	VkResult Device::CreateQueues(const VkDeviceCreateInfo& pCreateInfo)
 	{
 		if (pCreateInfo.queueCreateInfoCount == 0)
@@ -98,12 +111,21 @@ namespace vkd
 			const uint32_t count = queueCreateInfo.queueCount;
 			const VkDeviceQueueCreateFlags flags = queueCreateInfo.flags;
 
+			VkQueueGlobalPriorityEXT globalPriority = VK_QUEUE_GLOBAL_PRIORITY_MEDIUM_EXT;
+			const VkBaseInStructure* pNext = static_cast<const VkBaseInStructure*>(queueCreateInfo.pNext);
+			while (pNext)
+			{
+				if (pNext->sType == VK_STRUCTURE_TYPE_DEVICE_QUEUE_GLOBAL_PRIORITY_CREATE_INFO_EXT)
+					globalPriority = reinterpret_cast<const VkDeviceQueueGlobalPriorityCreateInfoEXT*>(pNext)->globalPriority;
+				pNext = pNext->pNext;
+			}
+
 			auto& vec = m_queues[family];
 			uint32_t& at = nextOffset[family];
 
 			for (uint32_t q = 0; q < count; ++q)
 			{
-				auto queue = CreateQueueForFamily(family, at + q, flags);
+				auto queue = CreateQueueForFamily(family, at + q, flags, globalPriority);
 				if (queue.IsError())
 				{
 					CCT_ASSERT_FALSE("Failed to create queue");
@@ -216,6 +238,10 @@ namespace vkd
 	if (strcmp(pName, "vk" #name) == 0)    \
 	return (PFN_vkVoidFunction) static_cast<PFN_vk##name>(klass::name)
 
+#define VKD_ENTRYPOINT_LOOKUP_KHR(klass, name) \
+	if (strcmp(pName, "vk" #name "KHR") == 0)  \
+	return (PFN_vkVoidFunction) static_cast<PFN_vk##name>(klass::name)
+
 		VKD_ENTRYPOINT_LOOKUP(vkd::Device, DestroyDevice);
 		VKD_ENTRYPOINT_LOOKUP(vkd::Device, CreateDevice);
 		VKD_ENTRYPOINT_LOOKUP(vkd::Device, GetDeviceProcAddr);
@@ -262,6 +288,12 @@ namespace vkd
 		VKD_ENTRYPOINT_LOOKUP(vkd::Device, DestroySampler);
 		VKD_ENTRYPOINT_LOOKUP(vkd::Device, CreateSemaphore);
 		VKD_ENTRYPOINT_LOOKUP(vkd::Device, DestroySemaphore);
+		VKD_ENTRYPOINT_LOOKUP(vkd::Device, GetSemaphoreCounterValue);
+		VKD_ENTRYPOINT_LOOKUP_KHR(vkd::Device, GetSemaphoreCounterValue);
+		VKD_ENTRYPOINT_LOOKUP(vkd::Device, WaitSemaphores);
+		VKD_ENTRYPOINT_LOOKUP_KHR(vkd::Device, WaitSemaphores);
+		VKD_ENTRYPOINT_LOOKUP(vkd::Device, SignalSemaphore);
+		VKD_ENTRYPOINT_LOOKUP_KHR(vkd::Device, SignalSemaphore);
 		VKD_ENTRYPOINT_LOOKUP(vkd::Device, CreateEvent);
 		VKD_ENTRYPOINT_LOOKUP(vkd::Device, DestroyEvent);
 		VKD_ENTRYPOINT_LOOKUP(vkd::Device, GetEventStatus);
@@ -307,6 +339,9 @@ namespace vkd
 		VKD_ENTRYPOINT_LOOKUP(vkd::CommandBuffer, CmdBindDescriptorSets);
 		VKD_ENTRYPOINT_LOOKUP(vkd::CommandBuffer, CmdPushConstants);
 		VKD_ENTRYPOINT_LOOKUP(vkd::CommandBuffer, CmdPipelineBarrier);
+		VKD_ENTRYPOINT_LOOKUP(vkd::CommandBuffer, CmdSetEvent);
+		VKD_ENTRYPOINT_LOOKUP(vkd::CommandBuffer, CmdResetEvent);
+		VKD_ENTRYPOINT_LOOKUP(vkd::CommandBuffer, CmdWaitEvents);
 		VKD_ENTRYPOINT_LOOKUP(vkd::CommandBuffer, CmdDraw);
 		VKD_ENTRYPOINT_LOOKUP(vkd::CommandBuffer, CmdDrawIndexed);
 		VKD_ENTRYPOINT_LOOKUP(vkd::CommandBuffer, CmdDrawIndirect);
@@ -423,22 +458,22 @@ namespace vkd
 		VKD_CHECK(pAllocateInfo && pCommandBuffers);
 		VKD_FROM_HANDLE(CommandPool, poolObj, pAllocateInfo->commandPool);
 
+		auto releaseAllocated = [&](uint32_t count)
+		{
+			for (uint32_t j = 0; j < count; ++j)
+			{
+				poolObj->FreeCommandBuffer(reinterpret_cast<DispatchableObject<CommandBuffer>*>(pCommandBuffers[j]));
+				pCommandBuffers[j] = VK_NULL_HANDLE;
+			}
+		};
+
 		// Allocate command buffers from the pool
 		for (uint32_t i = 0; i < pAllocateInfo->commandBufferCount; ++i)
 		{
 			auto bufferResult = poolObj->AllocateCommandBuffer(pAllocateInfo->level);
 			if (bufferResult.IsError())
 			{
-				// Clean up any buffers allocated so far
-				for (uint32_t j = 0; j < i; ++j)
-				{
-					VKD_FROM_HANDLE(CommandBuffer, bufferObj, pCommandBuffers[j]);
-					if (bufferObj)
-					{
-						auto* dispatchable = reinterpret_cast<DispatchableObject<CommandBuffer>*>(pCommandBuffers[j]);
-						mem::DeleteDispatchable(dispatchable);
-					}
-				}
+				releaseAllocated(i);
 				return bufferResult.GetError();
 			}
 
@@ -446,17 +481,8 @@ namespace vkd
 			VkResult result = buffer->Object->Create(*poolObj, pAllocateInfo->level);
 			if (result != VK_SUCCESS)
 			{
-				mem::DeleteDispatchable(buffer);
-				// Clean up any buffers allocated so far
-				for (uint32_t j = 0; j < i; ++j)
-				{
-					VKD_FROM_HANDLE(CommandBuffer, bufferObj, pCommandBuffers[j]);
-					if (bufferObj)
-					{
-						auto* dispatchable = reinterpret_cast<DispatchableObject<CommandBuffer>*>(pCommandBuffers[j]);
-						mem::DeleteDispatchable(dispatchable);
-					}
-				}
+				poolObj->FreeCommandBuffer(buffer);
+				releaseAllocated(i);
 				return result;
 			}
 
@@ -474,15 +500,12 @@ namespace vkd
 		VKD_FROM_HANDLE(CommandPool, commandPoolObj, commandPool);
 		VKD_CHECK(pCommandBuffers && commandBufferCount != 0);
 
-		// TODO: implement - free command buffers back to pool
 		for (uint32_t i = 0; i < commandBufferCount; ++i)
 		{
-			VKD_FROM_HANDLE(CommandBuffer, cmdBuffer, pCommandBuffers[i]);
-			if (!cmdBuffer)
+			if (pCommandBuffers[i] == VK_NULL_HANDLE)
 				continue;
 
-			auto* dispatchable = reinterpret_cast<DispatchableObject<CommandBuffer>*>(pCommandBuffers[i]);
-			mem::DeleteDispatchable(dispatchable);
+			commandPoolObj->FreeCommandBuffer(reinterpret_cast<DispatchableObject<CommandBuffer>*>(pCommandBuffers[i]));
 		}
 	}
 
@@ -516,11 +539,13 @@ namespace vkd
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		VKD_FROM_HANDLE(Fence, fenceObj, fence);
+		if (fence == VK_NULL_HANDLE)
+			return;
+
 		VKD_FROM_HANDLE(Device, deviceObj, device);
+		VKD_FROM_HANDLE(Fence, fenceObj, fence);
 
-		auto* dispatchable = reinterpret_cast<DispatchableObject<Fence>*>(fence);
-		mem::Delete(pAllocator ? *pAllocator : fenceObj->GetAllocationCallbacks(), dispatchable);
+		mem::Delete(pAllocator ? *pAllocator : fenceObj->GetAllocationCallbacks(), fenceObj);
 	}
 
 	VkResult Device::WaitForFences(VkDevice device, uint32_t fenceCount, const VkFence* pFences, VkBool32 waitAll, uint64_t timeout)
@@ -530,90 +555,42 @@ namespace vkd
 		VKD_FROM_HANDLE(Device, deviceObj, device);
 		VKD_CHECK(pFences && fenceCount != 0);
 
-		const bool infinite = timeout == std::numeric_limits<uint64_t>::max();
-
-		using Clock = std::chrono::steady_clock;
-		const auto start = Clock::now();
-		const auto deadline = infinite ? Clock::time_point::max() : (start + std::chrono::nanoseconds(timeout));
-
-		if (waitAll)
-		{
-			for (uint32_t i = 0; i < fenceCount; ++i)
-			{
-				VKD_FROM_HANDLE(Fence, fenceObj, pFences[i]);
-				if (!fenceObj)
-				{
-					CCT_ASSERT_FALSE("Invalid VkFence handle at index {}", i);
-					return VK_ERROR_DEVICE_LOST;
-				}
-
-				while (true)
-				{
-					const uint64_t remainingNs = (deadline == Clock::time_point::max())
-													 ? std::numeric_limits<uint64_t>::max()
-													 : static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - Clock::now()).count());
-
-					if (!infinite && Clock::now() >= deadline)
-						return VK_TIMEOUT;
-
-					VkResult result = fenceObj->Wait(remainingNs);
-					if (result == VK_SUCCESS)
-						break;
-					if (result == VK_TIMEOUT)
-					{
-						if (!infinite && Clock::now() >= deadline)
-							return VK_TIMEOUT;
-						std::this_thread::sleep_for(std::chrono::milliseconds(1));
-						continue;
-					}
-					return result;
-				}
-			}
-		}
-		if (timeout == 0)
+		if (fenceCount == 1)
 		{
-			for (uint32_t i = 0; i < fenceCount; ++i)
-			{
-				VKD_FROM_HANDLE(Fence, fenceObj, pFences[i]);
-				if (!fenceObj)
-				{
-					CCT_ASSERT_FALSE("Invalid VkFence handle at index {}", i);
-					return VK_ERROR_DEVICE_LOST;
-				}
-				VkResult r = fenceObj->Wait(0);
-				if (r == VK_SUCCESS)
-					return VK_SUCCESS;
-				if (r != VK_TIMEOUT)
-					return r;
-			}
-			return VK_TIMEOUT;
+			VKD_FROM_HANDLE(Fence, fenceObj, pFences[0]);
+			return fenceObj->Wait(timeout);
 		}
 
-		while (true)
+		// VK_NOT_READY while the condition does not hold yet
+		auto evaluate = [&]() -> VkResult
 		{
 			for (uint32_t i = 0; i < fenceCount; ++i)
 			{
 				VKD_FROM_HANDLE(Fence, fenceObj, pFences[i]);
-				if (!fenceObj)
-				{
-					CCT_ASSERT_FALSE("Invalid VkFence handle at index {}", i);
-					return VK_ERROR_DEVICE_LOST;
-				}
-
-				VkResult r = fenceObj->Wait(0);
-				if (r == VK_SUCCESS)
+				VkResult result = fenceObj->GetStatus();
+				if (result != VK_SUCCESS && result != VK_NOT_READY)
+					return result;
+				if (waitAll && result == VK_NOT_READY)
+					return VK_NOT_READY;
+				if (!waitAll && result == VK_SUCCESS)
 					return VK_SUCCESS;
-				if (r != VK_TIMEOUT)
-					return r;
 			}
+			return waitAll ? VK_SUCCESS : VK_NOT_READY;
+		};
 
-			if (!infinite && Clock::now() >= deadline)
-				return VK_TIMEOUT;
-
-			std::this_thread::sleep_for(std::chrono::milliseconds(1));
-		}
+		VkResult result = evaluate();
+		if (result != VK_NOT_READY)
+			return result;
+		if (timeout == 0)
+			return VK_TIMEOUT;
 
-		return VK_SUCCESS;
+		auto fenceWaiters = std::span(pFences, fenceCount) | std::views::transform([](VkFence fence) -> SyncWaiterList&
+																				   { return Fence::FromHandle(fence)->GetWaiters(); });
+		const bool done = SyncWaiter::WaitUntil(fenceWaiters, Futex::GetDeadline(timeout), [&]()
+												{
+			result = evaluate();
+			return result != VK_NOT_READY; });
+		return done ? result : VK_TIMEOUT;
 	}
 
 	VkResult Device::ResetFences(VkDevice device, uint32_t fenceCount, const VkFence* pFences)
@@ -1171,48 +1148,163 @@ namespace vkd
 	VkResult Device::CreateSemaphore(VkDevice device, const VkSemaphoreCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkSemaphore* pSemaphore)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
-		cct::Logger::Warning("vkCreateSemaphore not implemented");
-		return VK_ERROR_FEATURE_NOT_PRESENT;
+
+		VKD_FROM_HANDLE(Device, deviceObj, device);
+		VKD_CHECK(pCreateInfo && pSemaphore);
+
+		if (!pAllocator)
+			pAllocator = &deviceObj->GetAllocationCallbacks();
+
+		auto semaphoreResult = deviceObj->CreateSemaphore(*pAllocator);
+		if (semaphoreResult.IsError())
+			return semaphoreResult.GetError();
+
+		auto* semaphoreObj = std::move(semaphoreResult).GetValue();
+		VkResult result = semaphoreObj->Create(*deviceObj, *pCreateInfo);
+		if (result != VK_SUCCESS)
+		{
+			mem::Delete(*pAllocator, semaphoreObj);
+			return result;
+		}
+
+		*pSemaphore = VKD_TO_HANDLE(VkSemaphore, semaphoreObj);
+		return VK_SUCCESS;
 	}
 
 	void Device::DestroySemaphore(VkDevice device, VkSemaphore semaphore, const VkAllocationCallbacks* pAllocator)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
-		cct::Logger::Warning("vkDestroySemaphore not implemented");
+
+		if (semaphore == VK_NULL_HANDLE)
+			return;
+
+		VKD_FROM_HANDLE(Device, deviceObj, device);
+		VKD_FROM_HANDLE(Semaphore, semaphoreObj, semaphore);
+
+		mem::Delete(pAllocator ? *pAllocator : semaphoreObj->GetAllocationCallbacks(), semaphoreObj);
+	}
+
+	VkResult Device::GetSemaphoreCounterValue(VkDevice device, VkSemaphore semaphore, uint64_t* pValue)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		VKD_FROM_HANDLE(Semaphore, semaphoreObj, semaphore);
+		VKD_CHECK(pValue);
+
+		*pValue = semaphoreObj->GetCounterValue();
+		return VK_SUCCESS;
+	}
+
+	VkResult Device::WaitSemaphores(VkDevice device, const VkSemaphoreWaitInfo* pWaitInfo, uint64_t timeout)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		VKD_FROM_HANDLE(Device, deviceObj, device);
+		VKD_CHECK(pWaitInfo && pWaitInfo->semaphoreCount != 0);
+
+		const uint32_t semaphoreCount = pWaitInfo->semaphoreCount;
+		if (semaphoreCount == 1)
+		{
+			VKD_FROM_HANDLE(Semaphore, semaphoreObj, pWaitInfo->pSemaphores[0]);
+			return semaphoreObj->Wait(pWaitInfo->pValues[0], timeout);
+		}
+
+		const bool waitAny = (pWaitInfo->flags & VK_SEMAPHORE_WAIT_ANY_BIT) != 0;
+		auto isSatisfied = [&]() -> bool
+		{
+			for (uint32_t i = 0; i < semaphoreCount; ++i)
+			{
+				const bool reached = Semaphore::FromHandle(pWaitInfo->pSemaphores[i])->GetCounterValue() >= pWaitInfo->pValues[i];
+				if (waitAny && reached)
+					return true;
+				if (!waitAny && !reached)
+					return false;
+			}
+			return !waitAny;
+		};
+
+		if (isSatisfied())
+			return VK_SUCCESS;
+		if (timeout == 0)
+			return VK_TIMEOUT;
+
+		auto semaphoreWaiters = std::span(pWaitInfo->pSemaphores, semaphoreCount) | std::views::transform([](VkSemaphore semaphore) -> SyncWaiterList&
+																									  { return Semaphore::FromHandle(semaphore)->GetWaiters(); });
+		return SyncWaiter::WaitUntil(semaphoreWaiters, Futex::GetDeadline(timeout), isSatisfied) ? VK_SUCCESS : VK_TIMEOUT;
+	}
+
+	VkResult Device::SignalSemaphore(VkDevice device, const VkSemaphoreSignalInfo* pSignalInfo)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		VKD_CHECK(pSignalInfo);
+		VKD_FROM_HANDLE(Semaphore, semaphoreObj, pSignalInfo->semaphore);
+
+		// Queue waits on the semaphore are resolved by their drain tasks, they see the new payload right away
+		return semaphoreObj->Signal(pSignalInfo->value);
 	}
 
 	VkResult Device::CreateEvent(VkDevice device, const VkEventCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkEvent* pEvent)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
-		cct::Logger::Warning("vkCreateEvent not implemented");
-		return VK_ERROR_FEATURE_NOT_PRESENT;
+
+		VKD_FROM_HANDLE(Device, deviceObj, device);
+		VKD_CHECK(pCreateInfo && pEvent);
+
+		if (!pAllocator)
+			pAllocator = &deviceObj->GetAllocationCallbacks();
+
+		auto eventResult = deviceObj->CreateEvent(*pAllocator);
+		if (eventResult.IsError())
+			return eventResult.GetError();
+
+		auto* eventObj = std::move(eventResult).GetValue();
+		VkResult result = eventObj->Create(*deviceObj, *pCreateInfo);
+		if (result != VK_SUCCESS)
+		{
+			mem::Delete(*pAllocator, eventObj);
+			return result;
+		}
+
+		*pEvent = VKD_TO_HANDLE(VkEvent, eventObj);
+		return VK_SUCCESS;
 	}
 
 	void Device::DestroyEvent(VkDevice device, VkEvent event, const VkAllocationCallbacks* pAllocator)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
-		cct::Logger::Warning("vkDestroyEvent not implemented");
+
+		if (event == VK_NULL_HANDLE)
+			return;
+
+		VKD_FROM_HANDLE(Device, deviceObj, device);
+		VKD_FROM_HANDLE(Event, eventObj, event);
+
+		mem::Delete(pAllocator ? *pAllocator : eventObj->GetAllocationCallbacks(), eventObj);
 	}
 
 	VkResult Device::GetEventStatus(VkDevice device, VkEvent event)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
-		cct::Logger::Warning("vkGetEventStatus not implemented");
-		return VK_ERROR_FEATURE_NOT_PRESENT;
+
+		VKD_FROM_HANDLE(Event, eventObj, event);
+		return eventObj->GetStatus();
 	}
 
 	VkResult Device::SetEvent(VkDevice device, VkEvent event)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
-		cct::Logger::Warning("vkSetEvent not implemented");
-		return VK_ERROR_FEATURE_NOT_PRESENT;
+
+		VKD_FROM_HANDLE(Event, eventObj, event);
+		return eventObj->Set();
 	}
 
 	VkResult Device::ResetEvent(VkDevice device, VkEvent event)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
-		cct::Logger::Warning("vkResetEvent not implemented");
-		return VK_ERROR_FEATURE_NOT_PRESENT;
+
+		VKD_FROM_HANDLE(Event, eventObj, event);
+		return eventObj->Reset();
 	}
 
 	VkResult Device::CreateQueryPool(VkDevice device, const VkQueryPoolCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkQueryPool* pQueryPool)
@@ -1331,7 +1423,22 @@ namespace vkd
 	VkResult Device::DeviceWaitIdle(VkDevice device)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
-		cct::Logger::Warning("vkDeviceWaitIdle not implemented");
+
+		VKD_FROM_HANDLE(Device, deviceObj, device);
+
+		for (const auto& [family, queues] : deviceObj->m_queues)
+		{
+			for (DispatchableObject<Queue>* queue : queues)
+			{
+				if (!queue)
+					continue;
+
+				VkResult result = Queue::QueueWaitIdle(VKD_TO_HANDLE(VkQueue, queue));
+				if (result != VK_SUCCESS)
+					return result;
+			}
+		}
+
 		return VK_SUCCESS;
 	}
 } // namespace vkd
@@ -20,6 +20,8 @@ namespace vkd
 	class Queue;
 	class CommandPool;
 	class Fence;
+	class Semaphore;
+	class Event;
 	class Buffer;
 	class BufferView;
 	class Image;
@@ -41,6 +43,8 @@ namespace vkd
 
 		virtual VkResult Create(PhysicalDevice& owner, const VkDeviceCreateInfo& pDeviceCreateInfo, const VkAllocationCallbacks& allocationCallbacks);
 		[[nodiscard]] PhysicalDevice* GetOwner() const;
+		/// Whether recorded command buffers go through the CommandOptimizer, set with VKD_OPTIMIZE_COMMANDS=1
+		[[nodiscard]] bool IsCommandOptimizationEnabled() const;
 
 		VkResult CreateQueues(const VkDeviceCreateInfo& pCreateInfo);
 		[[nodiscard]] DispatchableObject<Queue>* GetQueue(uint32_t queueFamilyIndex, uint32_t queueIndex) const;
@@ -108,6 +112,9 @@ namespace vkd
 
 		static VkResult VKAPI_CALL CreateSemaphore(VkDevice device, const VkSemaphoreCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkSemaphore* pSemaphore);
 		static void VKAPI_CALL DestroySemaphore(VkDevice device, VkSemaphore semaphore, const VkAllocationCallbacks* pAllocator);
+		static VkResult VKAPI_CALL GetSemaphoreCounterValue(VkDevice device, VkSemaphore semaphore, uint64_t* pValue);
+		static VkResult VKAPI_CALL WaitSemaphores(VkDevice device, const VkSemaphoreWaitInfo* pWaitInfo, uint64_t timeout);
+		static VkResult VKAPI_CALL SignalSemaphore(VkDevice device, const VkSemaphoreSignalInfo* pSignalInfo);
 
 		static VkResult VKAPI_CALL CreateEvent(VkDevice device, const VkEventCreateInfo* pCreateInfo, const VkAllocationCallbacks* pAllocator, VkEvent* pEvent);
 		static void VKAPI_CALL DestroyEvent(VkDevice device, VkEvent event, const VkAllocationCallbacks* pAllocator);
@@ -139,9 +146,11 @@ namespace vkd
 
 		static VkResult VKAPI_CALL DeviceWaitIdle(VkDevice device);
 
-		virtual DispatchableObjectResult<Queue> CreateQueueForFamily(uint32_t queueFamilyIndex, uint32_t queueIndex, VkDeviceQueueCreateFlags flags) = 0;
+		virtual DispatchableObjectResult<Queue> CreateQueueForFamily(uint32_t queueFamilyIndex, uint32_t queueIndex, VkDeviceQueueCreateFlags flags, VkQueueGlobalPriorityEXT globalPriority) = 0;
 		virtual Result<CommandPool*, VkResult> CreateCommandPool(const VkAllocationCallbacks& allocationCallbacks) = 0;
 		virtual Result<Fence*, VkResult> CreateFence(const VkAllocationCallbacks& allocationCallbacks) = 0;
+		virtual Result<Semaphore*, VkResult> CreateSemaphore(const VkAllocationCallbacks& allocationCallbacks) = 0;
+		virtual Result<Event*, VkResult> CreateEvent(const VkAllocationCallbacks& allocationCallbacks) = 0;
 		virtual Result<Buffer*, VkResult> CreateBuffer(const VkAllocationCallbacks& allocationCallbacks) = 0;
 		virtual Result<BufferView*, VkResult> CreateBufferView(const VkAllocationCallbacks& allocationCallbacks) = 0;
 		virtual Result<Image*, VkResult> CreateImage(const VkAllocationCallbacks& allocationCallbacks) = 0;
@@ -154,6 +163,7 @@ namespace vkd
 
 	private:
 		PhysicalDevice* m_owner;
+		bool m_commandOptimizationEnabled;
 
 		// Queues organized by family index, then queue index
 		std::unordered_map<UInt32 /*family index*/, std::vector<DispatchableObject<Queue>*>> m_queues;
@@ -8,7 +8,7 @@
 
 #pragma once
 
-#include <vector>
+#include <span>
 
 #include "Vkd/ObjectBase/ObjectBase.hpp"
 
@@ -28,7 +28,7 @@ namespace vkd
 		{
 			Image* src;
 			Image* dst;
-			std::vector<VkImageCopy> regions;
+			std::span<const VkImageCopy> regions;
 		};
 
 		struct OpClearColorImage
@@ -36,7 +36,7 @@ namespace vkd
 			Image* image;
 			VkImageLayout layout;
 			VkClearColorValue clearColor;
-			std::vector<VkImageSubresourceRange> ranges;
+			std::span<const VkImageSubresourceRange> ranges;
 		};
 
 		using Op = Nz::TypeList<OpCopy, OpClearColorImage>;
@@ -15,6 +15,8 @@ namespace vkd::mem
 	template<typename T>
 	T* Allocate(const VkAllocationCallbacks& pAllocator, VkSystemAllocationScope allocationScope);
 
+	inline void* Allocate(const VkAllocationCallbacks& pAllocator, std::size_t size, std::size_t alignment, VkSystemAllocationScope allocationScope);
+
 	inline void Free(const VkAllocationCallbacks& pAllocator, void* memory);
 
 	template<typename T>
@@ -15,6 +15,11 @@ namespace vkd::mem
 		return static_cast<T*>(pAllocator.pfnAllocation(pAllocator.pUserData, sizeof(T), alignof(T), allocationScope));
 	}
 
+	inline void* Allocate(const VkAllocationCallbacks& pAllocator, std::size_t size, std::size_t alignment, VkSystemAllocationScope allocationScope)
+	{
+		return pAllocator.pfnAllocation(pAllocator.pUserData, size, alignment, allocationScope);
+	}
+
 	inline void Free(const VkAllocationCallbacks& pAllocator, void* memory)
 	{
 		pAllocator.pfnFree(pAllocator.pUserData, memory);
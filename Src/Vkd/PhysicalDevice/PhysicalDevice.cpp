@@ -6,12 +6,18 @@
 
 #include "Vkd/PhysicalDevice/PhysicalDevice.hpp"
 
+#include <algorithm>
+#include <limits>
+
 #include "VkdUtils/System/System.hpp"
 
 namespace vkd
 {
 	// Supported device extensions for the CPU backend
-	std::array<VkExtensionProperties, 0> PhysicalDevice::s_supportedExtensions = {};
+	std::array<VkExtensionProperties, 2> PhysicalDevice::s_supportedExtensions = {{
+		{VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME, VK_KHR_TIMELINE_SEMAPHORE_SPEC_VERSION},
+		{VK_EXT_GLOBAL_PRIORITY_EXTENSION_NAME, VK_EXT_GLOBAL_PRIORITY_SPEC_VERSION},
+	}};
 
 	PhysicalDevice::PhysicalDevice() :
 		ObjectBase(ObjectType),
@@ -103,6 +109,12 @@ namespace vkd
 				{
 					std::memset(reinterpret_cast<char*>(pNext) + sizeof(VkBaseOutStructure), 0,
 								sizeof(VkPhysicalDeviceVulkan12Features) - sizeof(VkBaseOutStructure));
+					reinterpret_cast<VkPhysicalDeviceVulkan12Features*>(pNext)->timelineSemaphore = VK_TRUE;
+					break;
+				}
+				case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES:
+				{
+					reinterpret_cast<VkPhysicalDeviceTimelineSemaphoreFeatures*>(pNext)->timelineSemaphore = VK_TRUE;
 					break;
 				}
 				case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES:
@@ -232,6 +244,13 @@ namespace vkd
 				{
 					std::memset(reinterpret_cast<char*>(pNext) + sizeof(VkBaseOutStructure), 0,
 								sizeof(VkPhysicalDeviceVulkan12Properties) - sizeof(VkBaseOutStructure));
+					reinterpret_cast<VkPhysicalDeviceVulkan12Properties*>(pNext)->maxTimelineSemaphoreValueDifference = std::numeric_limits<UInt64>::max();
+					break;
+				}
+				case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_PROPERTIES:
+				{
+					// Payloads are plain 64-bit counters, any two values can be in flight at once
+					reinterpret_cast<VkPhysicalDeviceTimelineSemaphoreProperties*>(pNext)->maxTimelineSemaphoreValueDifference = std::numeric_limits<UInt64>::max();
 					break;
 				}
 				case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_PROPERTIES:
@@ -319,12 +338,13 @@ namespace vkd
 			return VK_SUCCESS;
 		}
 
-		// std::size_t max = std::min(static_cast<std::size_t>(*pPropertyCount), s_supportedExtensions.size());
-		// if (max > 0)
-		// 	std::memcpy(pProperties, s_supportedExtensions.data(), max * sizeof(VkExtensionProperties));
+		std::size_t max = std::min(static_cast<std::size_t>(*pPropertyCount), s_supportedExtensions.size());
+		if (max > 0)
+			std::memcpy(pProperties, s_supportedExtensions.data(), max * sizeof(VkExtensionProperties));
+		*pPropertyCount = static_cast<uint32_t>(max);
 
-		// if (max < s_supportedExtensions.size())
-		// 	return VK_INCOMPLETE;
+		if (max < s_supportedExtensions.size())
+			return VK_INCOMPLETE;
 
 		return VK_SUCCESS;
 	}
@@ -61,7 +61,7 @@ namespace vkd
 		VkResult Create(Instance& owner, const VkPhysicalDeviceProperties& physicalDeviceProperties, const std::array<VkQueueFamilyProperties, 3>& queueFamilyProperties, const VkAllocationCallbacks& allocationCallbacks);
 
 	private:
-		static std::array<VkExtensionProperties, 0> s_supportedExtensions;
+		static std::array<VkExtensionProperties, 2> s_supportedExtensions;
 
 		Instance* m_instance;
 		VkPhysicalDeviceProperties m_physicalDeviceProperties;
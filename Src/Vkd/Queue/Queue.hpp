@@ -25,12 +25,14 @@ namespace vkd
 		Queue();
 		~Queue() override = default;
 
-		virtual VkResult Create(Device& owner, UInt32 queueFamilyIndex, UInt32 queueIndex, VkDeviceQueueCreateFlags flags);
+		virtual VkResult Create(Device& owner, UInt32 queueFamilyIndex, UInt32 queueIndex, VkDeviceQueueCreateFlags flags, VkQueueGlobalPriorityEXT globalPriority);
 
 		[[nodiscard]] inline Device* GetOwner() const;
 		[[nodiscard]] inline UInt32 GetQueueFamilyIndex() const;
 		[[nodiscard]] inline UInt32 GetQueueIndex() const;
 		[[nodiscard]] inline VkDeviceQueueCreateFlags GetFlags() const;
+		/// VK_EXT_global_priority priority, medium unless requested otherwise
+		[[nodiscard]] inline VkQueueGlobalPriorityEXT GetGlobalPriority() const;
 
 		// Vulkan API entry points
 		static VkResult VKAPI_CALL QueueSubmit(VkQueue queue, uint32_t submitCount, const VkSubmitInfo* pSubmits, VkFence fence);
@@ -47,6 +49,7 @@ namespace vkd
 		UInt32 m_queueFamilyIndex;
 		UInt32 m_queueIndex;
 		VkDeviceQueueCreateFlags m_flags;
+		VkQueueGlobalPriorityEXT m_globalPriority;
 	};
 } // namespace vkd
 
@@ -16,16 +16,18 @@ namespace vkd
 		m_owner(nullptr),
 		m_queueFamilyIndex(0),
 		m_queueIndex(0),
-		m_flags(0)
+		m_flags(0),
+		m_globalPriority(VK_QUEUE_GLOBAL_PRIORITY_MEDIUM_EXT)
 	{
 	}
 
-	inline VkResult Queue::Create(Device& owner, UInt32 queueFamilyIndex, UInt32 queueIndex, VkDeviceQueueCreateFlags flags)
+	inline VkResult Queue::Create(Device& owner, UInt32 queueFamilyIndex, UInt32 queueIndex, VkDeviceQueueCreateFlags flags, VkQueueGlobalPriorityEXT globalPriority)
 	{
 		m_owner = &owner;
 		m_queueFamilyIndex = queueFamilyIndex;
 		m_queueIndex = queueIndex;
 		m_flags = flags;
+		m_globalPriority = globalPriority;
 
 		SetAllocationCallbacks(m_owner->GetAllocationCallbacks());
 
@@ -56,4 +58,10 @@ namespace vkd
 		AssertValid();
 		return m_flags;
 	}
+
+	inline VkQueueGlobalPriorityEXT Queue::GetGlobalPriority() const
+	{
+		AssertValid();
+		return m_globalPriority;
+	}
 } // namespace vkd
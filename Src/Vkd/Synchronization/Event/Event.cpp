@@ -0,0 +1,14 @@
+/**
+ * @file Event.cpp
+ * @brief Implementation of Vulkan event
+ * @date 2026-10-16
+ */
+
+#include "Vkd/Synchronization/Event/Event.hpp"
+
+#include "Vkd/Defines.hpp"
+
+namespace vkd
+{
+
+}
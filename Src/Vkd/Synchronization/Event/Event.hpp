@@ -0,0 +1,51 @@
+/**
+ * @file Event.hpp
+ * @brief Vulkan event synchronization primitive
+ * @date 2026-10-16
+ *
+ * Represents an event set and reset by the host or by command buffers, command
+ * buffers waiting on it order what follows the wait after what preceded the set.
+ */
+
+#pragma once
+
+#include "Vkd/ObjectBase/ObjectBase.hpp"
+#include "VkdUtils/SyncWaiter/SyncWaiter.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace vkd
+{
+	class Device;
+
+	class Event : public ObjectBase
+	{
+	public:
+		static constexpr VkObjectType ObjectType = VK_OBJECT_TYPE_EVENT;
+		VKD_NON_DISPATCHABLE_HANDLE(Event);
+
+		Event();
+		~Event() override = default;
+
+		virtual VkResult Create(Device& owner, const VkEventCreateInfo& createInfo);
+
+		[[nodiscard]] inline Device* GetOwner() const;
+		[[nodiscard]] inline VkEventCreateFlags GetFlags() const;
+		/// Waiters on the event, notified by Set
+		[[nodiscard]] inline SyncWaiterList& GetWaiters();
+
+		// Vulkan API entry points
+
+		/// VK_EVENT_SET or VK_EVENT_RESET
+		virtual VkResult GetStatus() = 0;
+		virtual VkResult Set() = 0;
+		virtual VkResult Reset() = 0;
+
+	private:
+		Device* m_owner;
+		VkEventCreateFlags m_flags;
+		SyncWaiterList m_waiters;
+	};
+} // namespace vkd
+
+#include "Event.inl"
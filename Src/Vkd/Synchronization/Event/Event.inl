@@ -0,0 +1,48 @@
+/**
+ * @file Event.inl
+ * @brief Inline implementations for Event
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include "Vkd/Device/Device.hpp"
+#include "Vkd/Synchronization/Event/Event.hpp"
+
+namespace vkd
+{
+	inline Event::Event() :
+		ObjectBase(ObjectType),
+		m_owner(nullptr),
+		m_flags(0)
+	{
+	}
+
+	inline VkResult Event::Create(Device& owner, const VkEventCreateInfo& createInfo)
+	{
+		m_owner = &owner;
+		m_flags = createInfo.flags;
+
+		SetAllocationCallbacks(m_owner->GetAllocationCallbacks());
+
+		m_createResult = VK_SUCCESS;
+		return m_createResult;
+	}
+
+	inline Device* Event::GetOwner() const
+	{
+		AssertValid();
+		return m_owner;
+	}
+
+	inline VkEventCreateFlags Event::GetFlags() const
+	{
+		AssertValid();
+		return m_flags;
+	}
+
+	inline SyncWaiterList& Event::GetWaiters()
+	{
+		return m_waiters;
+	}
+} // namespace vkd
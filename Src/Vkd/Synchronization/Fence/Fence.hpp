@@ -9,6 +9,8 @@
 #pragma once
 
 #include "Vkd/ObjectBase/ObjectBase.hpp"
+#include "VkdUtils/SyncWaiter/SyncWaiter.hpp"
+#include "VkdUtils/Task/SyncAwaiter.hpp"
 
 #include <vulkan/vulkan.h>
 
@@ -29,6 +31,10 @@ namespace vkd
 
 		[[nodiscard]] inline Device* GetOwner() const;
 		[[nodiscard]] inline VkFenceCreateFlags GetFlags() const;
+		/// Threads waiting on several fences at once, notified by Signal once the fence is signaled
+		[[nodiscard]] inline SyncWaiterList& GetWaiters();
+		/// Awaitable suspending a coroutine until the fence is signaled, it then resumes on a worker of pool
+		[[nodiscard]] inline auto WaitAsync(ThreadPool& pool, ThreadPool::Priority priority = ThreadPool::Priority::Normal);
 
 		// Vulkan API entry points
 
@@ -40,6 +46,7 @@ namespace vkd
 	private:
 		Device* m_owner;
 		VkFenceCreateFlags m_flags;
+		SyncWaiterList m_waiters;
 	};
 } // namespace vkd
 
@@ -40,4 +40,15 @@ namespace vkd
 		AssertValid();
 		return m_flags;
 	}
+
+	inline auto Fence::WaitAsync(ThreadPool& pool, ThreadPool::Priority priority)
+	{
+		return WaitUntil(pool, m_waiters, [this]()
+						 { return GetStatus() == VK_SUCCESS; }, priority);
+	}
+
+	inline SyncWaiterList& Fence::GetWaiters()
+	{
+		return m_waiters;
+	}
 } // namespace vkd
@@ -0,0 +1,53 @@
+/**
+ * @file Semaphore.cpp
+ * @brief Implementation of Vulkan semaphore
+ * @date 2026-10-16
+ */
+
+#include "Vkd/Synchronization/Semaphore/Semaphore.hpp"
+
+#include <functional>
+#include <ranges>
+
+#include "Vkd/Defines.hpp"
+#include "VkdUtils/Futex/Futex.hpp"
+
+namespace vkd
+{
+	VkResult Semaphore::Create(Device& owner, const VkSemaphoreCreateInfo& createInfo)
+	{
+		m_owner = &owner;
+
+		const VkBaseInStructure* pNext = static_cast<const VkBaseInStructure*>(createInfo.pNext);
+		while (pNext)
+		{
+			if (pNext->sType == VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO)
+			{
+				const auto* typeCreateInfo = reinterpret_cast<const VkSemaphoreTypeCreateInfo*>(pNext);
+				m_type = typeCreateInfo->semaphoreType;
+				m_initialValue = m_type == VK_SEMAPHORE_TYPE_TIMELINE ? typeCreateInfo->initialValue : 0;
+			}
+			pNext = pNext->pNext;
+		}
+
+		SetAllocationCallbacks(m_owner->GetAllocationCallbacks());
+
+		m_createResult = VK_SUCCESS;
+		return m_createResult;
+	}
+
+	VkResult Semaphore::Wait(UInt64 value, UInt64 timeout)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		if (GetCounterValue() >= value)
+			return VK_SUCCESS;
+
+		if (timeout == 0)
+			return VK_TIMEOUT;
+
+		const bool reached = SyncWaiter::WaitUntil(std::views::single(std::ref(m_waiters)), Futex::GetDeadline(timeout), [this, value]()
+												   { return GetCounterValue() >= value; });
+		return reached ? VK_SUCCESS : VK_TIMEOUT;
+	}
+} // namespace vkd
@@ -0,0 +1,56 @@
+/**
+ * @file Semaphore.hpp
+ * @brief Vulkan semaphore synchronization primitive
+ * @date 2026-10-16
+ *
+ * Represents a binary or timeline semaphore. Both are exposed as a monotonic
+ * 64-bit payload, a wait on a value is satisfied once the payload reached it.
+ */
+
+#pragma once
+
+#include "Vkd/ObjectBase/ObjectBase.hpp"
+#include "VkdUtils/SyncWaiter/SyncWaiter.hpp"
+#include "VkdUtils/Task/SyncAwaiter.hpp"
+
+#include <vulkan/vulkan.h>
+
+namespace vkd
+{
+	class Device;
+
+	class Semaphore : public ObjectBase
+	{
+	public:
+		static constexpr VkObjectType ObjectType = VK_OBJECT_TYPE_SEMAPHORE;
+		VKD_NON_DISPATCHABLE_HANDLE(Semaphore);
+
+		Semaphore();
+		~Semaphore() override = default;
+
+		virtual VkResult Create(Device& owner, const VkSemaphoreCreateInfo& createInfo);
+
+		[[nodiscard]] inline Device* GetOwner() const;
+		[[nodiscard]] inline VkSemaphoreType GetType() const;
+		[[nodiscard]] inline UInt64 GetInitialValue() const;
+		/// Threads waiting on the payload, notified by Signal every time it moves forward
+		[[nodiscard]] inline SyncWaiterList& GetWaiters();
+
+		/// Blocks until the payload reaches value or the timeout in nanoseconds expires
+		VkResult Wait(UInt64 value, UInt64 timeout);
+		/// Awaitable suspending a coroutine until the payload reaches value, it then resumes on a worker of pool
+		[[nodiscard]] inline auto WaitAsync(ThreadPool& pool, UInt64 value, ThreadPool::Priority priority = ThreadPool::Priority::Normal);
+
+		virtual UInt64 GetCounterValue() = 0;
+		/// Raises the payload to value, a smaller value leaves it unchanged
+		virtual VkResult Signal(UInt64 value) = 0;
+
+	private:
+		Device* m_owner;
+		VkSemaphoreType m_type;
+		UInt64 m_initialValue;
+		SyncWaiterList m_waiters;
+	};
+} // namespace vkd
+
+#include "Semaphore.inl"
@@ -0,0 +1,50 @@
+/**
+ * @file Semaphore.inl
+ * @brief Inline implementations for Semaphore
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include "Vkd/Device/Device.hpp"
+#include "Vkd/Synchronization/Semaphore/Semaphore.hpp"
+
+namespace vkd
+{
+	inline Semaphore::Semaphore() :
+		ObjectBase(ObjectType),
+		m_owner(nullptr),
+		m_type(VK_SEMAPHORE_TYPE_BINARY),
+		m_initialValue(0)
+	{
+	}
+
+	inline Device* Semaphore::GetOwner() const
+	{
+		AssertValid();
+		return m_owner;
+	}
+
+	inline VkSemaphoreType Semaphore::GetType() const
+	{
+		AssertValid();
+		return m_type;
+	}
+
+	inline UInt64 Semaphore::GetInitialValue() const
+	{
+		AssertValid();
+		return m_initialValue;
+	}
+
+	inline auto Semaphore::WaitAsync(ThreadPool& pool, UInt64 value, ThreadPool::Priority priority)
+	{
+		return WaitUntil(pool, m_waiters, [this, value]()
+						 { return GetCounterValue() >= value; }, priority);
+	}
+
+	inline SyncWaiterList& Semaphore::GetWaiters()
+	{
+		return m_waiters;
+	}
+} // namespace vkd
@@ -0,0 +1,716 @@
+/**
+ * @file Replayer.cpp
+ * @brief Implementation of command capture replay
+ * @date 2026-10-16
+ */
+
+#include "VkdReplay/Replayer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+
+#include <Concerto/Core/Logger/Logger.hpp>
+
+#include "Vkd/Device/Device.hpp"
+#include "Vkd/Instance/Instance.hpp"
+#include "Vkd/PhysicalDevice/PhysicalDevice.hpp"
+#include "VkdSoftware/CommandBuffer/CommandBuffer.hpp"
+#include "VkdSoftware/CommandDispatcher/CommandDispatcher.hpp"
+#include "VkdSoftware/CpuContext/CpuContext.hpp"
+#include "VkdSoftware/Device/Device.hpp"
+
+namespace vkd::replay
+{
+	namespace
+	{
+		template<typename T>
+		constexpr std::string_view OpName = "Unknown";
+
+		template<>
+		constexpr std::string_view OpName<vkd::Buffer::OpFill> = "FillBuffer";
+		template<>
+		constexpr std::string_view OpName<vkd::Buffer::OpCopy> = "CopyBuffer";
+		template<>
+		constexpr std::string_view OpName<vkd::Buffer::OpCopy2> = "CopyBuffer2";
+		template<>
+		constexpr std::string_view OpName<vkd::Buffer::OpUpdate> = "UpdateBuffer";
+		template<>
+		constexpr std::string_view OpName<vkd::Buffer::OpCopyBufferToImage> = "CopyBufferToImage";
+		template<>
+		constexpr std::string_view OpName<vkd::Buffer::OpCopyImageToBuffer> = "CopyImageToBuffer";
+		template<>
+		constexpr std::string_view OpName<vkd::Image::OpCopy> = "CopyImage";
+		template<>
+		constexpr std::string_view OpName<vkd::Image::OpClearColorImage> = "ClearColorImage";
+		template<>
+		constexpr std::string_view OpName<vkd::OpBindVertexBuffer> = "BindVertexBuffers";
+		template<>
+		constexpr std::string_view OpName<vkd::OpDraw> = "Draw";
+		template<>
+		constexpr std::string_view OpName<vkd::OpDrawIndexed> = "DrawIndexed";
+		template<>
+		constexpr std::string_view OpName<vkd::OpDrawIndirect> = "DrawIndirect";
+		template<>
+		constexpr std::string_view OpName<vkd::OpDrawIndexedIndirect> = "DrawIndexedIndirect";
+		template<>
+		constexpr std::string_view OpName<vkd::OpBindPipeline> = "BindPipeline";
+		template<>
+		constexpr std::string_view OpName<vkd::OpExecuteCommands> = "ExecuteCommands";
+		template<>
+		constexpr std::string_view OpName<vkd::OpPipelineBarrier> = "PipelineBarrier";
+		template<>
+		constexpr std::string_view OpName<vkd::OpSetEvent> = "SetEvent";
+		template<>
+		constexpr std::string_view OpName<vkd::OpResetEvent> = "ResetEvent";
+		template<>
+		constexpr std::string_view OpName<vkd::OpWaitEvents> = "WaitEvents";
+
+		template<typename... Ts>
+		constexpr std::array<std::string_view, sizeof...(Ts)> MakeOpNameTable(Nz::TypeList<Ts...>)
+		{
+			return {OpName<Ts>...};
+		}
+
+		constexpr auto OpNames = MakeOpNameTable(vkd::CommandBuffer::AllOps{});
+
+		template<typename T>
+		constexpr UInt32 OpType = vkd::CommandBuffer::OpType<T>;
+
+		template<typename T>
+		bool ReadValue(std::span<const std::byte> data, std::size_t offset, T& value)
+		{
+			if (offset > data.size() || data.size() - offset < sizeof(T))
+				return false;
+			std::memcpy(&value, data.data() + offset, sizeof(T));
+			return true;
+		}
+
+		/// Records are 8 bytes aligned in the mapped file, arrays are read in place
+		template<typename T>
+		bool ReadArray(std::span<const std::byte> data, std::size_t offset, std::size_t count, std::span<const T>& values)
+		{
+			if (offset > data.size() || (data.size() - offset) / sizeof(T) < count)
+				return false;
+			values = std::span<const T>(reinterpret_cast<const T*>(data.data() + offset), count);
+			return true;
+		}
+
+		double ToMicroseconds(UInt64 nanoseconds)
+		{
+			return static_cast<double>(nanoseconds) / 1000.0;
+		}
+
+		UInt64 ElapsedNanoseconds(std::chrono::steady_clock::time_point start)
+		{
+			return static_cast<UInt64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+		}
+	} // namespace
+
+	Replayer::~Replayer()
+	{
+		if (m_device)
+		{
+			// Freeing the pool frees every command buffer allocated from it
+			if (m_commandPool)
+				vkd::Device::DestroyCommandPool(m_device, m_commandPool, nullptr);
+
+			for (auto& [id, event] : m_events)
+				vkd::Device::DestroyEvent(m_device, event, nullptr);
+
+			for (auto& [id, resource] : m_resources)
+			{
+				vkd::Device::UnmapMemory(m_device, resource.Memory);
+				if (resource.Kind == capture::ResourceKind::Buffer)
+					vkd::Device::DestroyBuffer(m_device, resource.BufferHandle, nullptr);
+				else
+					vkd::Device::DestroyImage(m_device, resource.ImageHandle, nullptr);
+				vkd::Device::FreeMemory(m_device, resource.Memory, nullptr);
+			}
+
+			vkd::Device::DestroyDevice(m_device, nullptr);
+		}
+
+		if (m_instance)
+			vkd::Instance::DestroyInstance(m_instance, nullptr);
+	}
+
+	bool Replayer::Init()
+	{
+		const VkApplicationInfo applicationInfo = {
+			.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
+			.pApplicationName = "vkd-replay",
+			.applicationVersion = 1,
+			.pEngineName = "vkd",
+			.engineVersion = 1,
+			.apiVersion = VK_API_VERSION_1_3,
+		};
+		const VkInstanceCreateInfo instanceCreateInfo = {
+			.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO,
+			.pApplicationInfo = &applicationInfo,
+		};
+		if (vkd::Instance::CreateInstance(&instanceCreateInfo, nullptr, &m_instance) != VK_SUCCESS)
+		{
+			cct::Logger::Error("Could not create instance");
+			return false;
+		}
+
+		// The software driver exposes a single physical device
+		UInt32 physicalDeviceCount = 1;
+		VkResult result = vkd::Instance::EnumeratePhysicalDevices(m_instance, &physicalDeviceCount, &m_physicalDevice);
+		if ((result != VK_SUCCESS && result != VK_INCOMPLETE) || physicalDeviceCount == 0)
+		{
+			cct::Logger::Error("Could not enumerate physical devices");
+			return false;
+		}
+		vkd::PhysicalDevice::GetPhysicalDeviceMemoryProperties(m_physicalDevice, &m_memoryProperties);
+
+		const float queuePriority = 1.0f;
+		const VkDeviceQueueCreateInfo queueCreateInfo = {
+			.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+			.queueFamilyIndex = 0,
+			.queueCount = 1,
+			.pQueuePriorities = &queuePriority,
+		};
+		const VkDeviceCreateInfo deviceCreateInfo = {
+			.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+			.queueCreateInfoCount = 1,
+			.pQueueCreateInfos = &queueCreateInfo,
+		};
+		if (vkd::Device::CreateDevice(m_physicalDevice, &deviceCreateInfo, nullptr, &m_device) != VK_SUCCESS)
+		{
+			cct::Logger::Error("Could not create device");
+			return false;
+		}
+
+		VKD_FROM_HANDLE(vkd::Device, device, m_device);
+		m_softwareDevice = static_cast<software::SoftwareDevice*>(device);
+
+		const VkCommandPoolCreateInfo commandPoolCreateInfo = {
+			.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+			.queueFamilyIndex = 0,
+		};
+		if (vkd::Device::CreateCommandPool(m_device, &commandPoolCreateInfo, nullptr, &m_commandPool) != VK_SUCCESS)
+		{
+			cct::Logger::Error("Could not create command pool");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Replayer::Load(const std::string& path)
+	{
+		if (!m_file.Open(path))
+		{
+			cct::Logger::Error("Could not open capture '{}'", path);
+			return false;
+		}
+
+		capture::FileHeader header = {};
+		if (!ReadValue(std::span<const std::byte>(m_file.GetData(), m_file.GetSize()), 0, header) || header.Magic != capture::Magic)
+		{
+			cct::Logger::Error("'{}' is not a vkd capture", path);
+			return false;
+		}
+
+		if (header.Version != capture::Version)
+		{
+			cct::Logger::Error("'{}' is a version {} capture, version {} is expected", path, header.Version, capture::Version);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool Replayer::Run(const Options& options)
+	{
+		const std::span<const std::byte> data(m_file.GetData(), m_file.GetSize());
+
+		m_opStats.assign(OpNames.size(), OpStats{});
+		m_submitStats.clear();
+
+		for (UInt32 iteration = 0; iteration < options.Iterations; ++iteration)
+		{
+			// Resources and command buffers are created by the first iteration, later ones only
+			// upload the captured contents again so that every iteration starts from the same state
+			std::size_t offset = capture::AlignRecordSize(sizeof(capture::FileHeader));
+			capture::RecordHeader header = {};
+			while (ReadValue(data, offset, header) && header.Type != capture::RecordType::End)
+			{
+				offset += sizeof(header);
+				if (data.size() - offset < header.Size)
+				{
+					cct::Logger::Error("Truncated record at offset {}", offset);
+					return false;
+				}
+
+				const std::span<const std::byte> payload = data.subspan(offset, header.Size);
+				bool replayed = false;
+				switch (header.Type)
+				{
+					case capture::RecordType::Resource:
+						replayed = ReplayResource(payload);
+						break;
+					case capture::RecordType::CommandBuffer:
+						replayed = ReplayCommandBuffer(payload);
+						break;
+					case capture::RecordType::Submit:
+						replayed = ReplaySubmit(payload, options);
+						break;
+					default:
+						cct::Logger::Error("Unknown record type {}", static_cast<UInt32>(header.Type));
+						break;
+				}
+
+				if (!replayed)
+					return false;
+
+				offset += header.Size;
+			}
+		}
+
+		return true;
+	}
+
+	void Replayer::PrintReport() const
+	{
+		std::printf("%-20s %10s %10s %14s %12s %12s\n", "Op", "Count", "Skipped", "Total (ms)", "Avg (us)", "Max (us)");
+		for (std::size_t type = 0; type < m_opStats.size(); ++type)
+		{
+			const OpStats& stats = m_opStats[type];
+			if (stats.Count == 0 && stats.Skipped == 0)
+				continue;
+
+			const double average = stats.Count ? ToMicroseconds(stats.TotalNanoseconds) / static_cast<double>(stats.Count) : 0.0;
+			std::printf("%-20.*s %10llu %10llu %14.3f %12.3f %12.3f\n", static_cast<int>(OpNames[type].size()), OpNames[type].data(),
+						static_cast<unsigned long long>(stats.Count), static_cast<unsigned long long>(stats.Skipped),
+						ToMicroseconds(stats.TotalNanoseconds) / 1000.0, average, ToMicroseconds(stats.MaxNanoseconds));
+		}
+
+		std::printf("\n%-8s %8s %12s %12s %12s\n", "Submit", "Runs", "Avg (us)", "Min (us)", "Max (us)");
+		for (std::size_t index = 0; index < m_submitStats.size(); ++index)
+		{
+			const SubmitStats& stats = m_submitStats[index];
+			if (stats.Count == 0)
+				continue;
+
+			std::printf("%-8zu %8llu %12.3f %12.3f %12.3f\n", index, static_cast<unsigned long long>(stats.Count),
+						ToMicroseconds(stats.TotalNanoseconds) / static_cast<double>(stats.Count), ToMicroseconds(stats.MinNanoseconds),
+						ToMicroseconds(stats.MaxNanoseconds));
+		}
+	}
+
+	bool Replayer::ReplayResource(std::span<const std::byte> payload)
+	{
+		capture::ResourceRecord record = {};
+		if (!ReadValue(payload, 0, record))
+			return false;
+
+		auto it = m_resources.find(record.Id);
+		if (it == m_resources.end())
+		{
+			if (!CreateResource(record.Id, record))
+				return false;
+			it = m_resources.find(record.Id);
+		}
+
+		if (record.Flags & capture::ResourceRecord::HasContents)
+		{
+			std::span<const std::byte> contents;
+			if (!ReadArray(payload, sizeof(record), record.Size, contents))
+				return false;
+			std::memcpy(it->second.MappedData, contents.data(), std::min(record.Size, it->second.Size));
+		}
+
+		return true;
+	}
+
+	bool Replayer::ReplayCommandBuffer(std::span<const std::byte> payload)
+	{
+		capture::CommandBufferRecord record = {};
+		if (!ReadValue(payload, 0, record))
+			return false;
+
+		if (m_commandBuffers.contains(record.Id))
+			return true;
+
+		const VkCommandBufferAllocateInfo allocateInfo = {
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+			.commandPool = m_commandPool,
+			.level = record.Level,
+			.commandBufferCount = 1,
+		};
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+		if (vkd::Device::AllocateCommandBuffers(m_device, &allocateInfo, &commandBuffer) != VK_SUCCESS)
+			return false;
+
+		const VkCommandBufferInheritanceInfo inheritanceInfo = {.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO};
+		const VkCommandBufferBeginInfo beginInfo = {
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+			.pInheritanceInfo = record.Level == VK_COMMAND_BUFFER_LEVEL_SECONDARY ? &inheritanceInfo : nullptr,
+		};
+		if (vkd::CommandBuffer::BeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
+			return false;
+
+		std::size_t offset = sizeof(record);
+		for (UInt32 i = 0; i < record.CommandCount; ++i)
+		{
+			capture::CommandRecord command = {};
+			if (!ReadValue(payload, offset, command))
+				return false;
+			offset += sizeof(command);
+
+			if (payload.size() - offset < command.Size || !ReplayCommand(commandBuffer, command.Type, payload.subspan(offset, command.Size)))
+			{
+				cct::Logger::Error("Could not replay command {} of command buffer {}", i, record.Id);
+				return false;
+			}
+			offset += command.Size;
+		}
+
+		if (vkd::CommandBuffer::EndCommandBuffer(commandBuffer) != VK_SUCCESS)
+			return false;
+
+		m_commandBuffers.emplace(record.Id, commandBuffer);
+		return true;
+	}
+
+	bool Replayer::ReplayCommand(VkCommandBuffer commandBuffer, UInt32 type, std::span<const std::byte> payload)
+	{
+		switch (type)
+		{
+			case OpType<vkd::Buffer::OpFill>:
+			{
+				capture::FillBufferCommand command = {};
+				if (!ReadValue(payload, 0, command))
+					return false;
+				vkd::CommandBuffer::CmdFillBuffer(commandBuffer, GetBuffer(command.Dst), command.Offset, command.Size, command.Data);
+				return true;
+			}
+			case OpType<vkd::Buffer::OpCopy>:
+			case OpType<vkd::Buffer::OpCopy2>:
+			{
+				capture::CopyBufferCommand command = {};
+				std::span<const VkBufferCopy> regions;
+				if (!ReadValue(payload, 0, command) || !ReadArray(payload, sizeof(command), command.RegionCount, regions))
+					return false;
+
+				if (type == OpType<vkd::Buffer::OpCopy>)
+				{
+					vkd::CommandBuffer::CmdCopyBuffer(commandBuffer, GetBuffer(command.Src), GetBuffer(command.Dst), command.RegionCount, regions.data());
+					return true;
+				}
+
+				std::vector<VkBufferCopy2> regions2;
+				regions2.reserve(regions.size());
+				for (const VkBufferCopy& region : regions)
+					regions2.push_back(VkBufferCopy2{VK_STRUCTURE_TYPE_BUFFER_COPY_2, nullptr, region.srcOffset, region.dstOffset, region.size});
+
+				const VkCopyBufferInfo2 copyInfo = {
+					.sType = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2,
+					.srcBuffer = GetBuffer(command.Src),
+					.dstBuffer = GetBuffer(command.Dst),
+					.regionCount = command.RegionCount,
+					.pRegions = regions2.data(),
+				};
+				vkd::CommandBuffer::CmdCopyBuffer2(commandBuffer, &copyInfo);
+				return true;
+			}
+			case OpType<vkd::Buffer::OpUpdate>:
+			{
+				capture::UpdateBufferCommand command = {};
+				std::span<const std::byte> data;
+				if (!ReadValue(payload, 0, command) || !ReadArray(payload, sizeof(command), command.DataSize, data))
+					return false;
+				vkd::CommandBuffer::CmdUpdateBuffer(commandBuffer, GetBuffer(command.Dst), command.Offset, command.DataSize, data.data());
+				return true;
+			}
+			case OpType<vkd::Buffer::OpCopyBufferToImage>:
+			case OpType<vkd::Buffer::OpCopyImageToBuffer>:
+			{
+				capture::BufferImageCopyCommand command = {};
+				std::span<const VkBufferImageCopy> regions;
+				if (!ReadValue(payload, 0, command) || !ReadArray(payload, sizeof(command), command.RegionCount, regions))
+					return false;
+
+				if (type == OpType<vkd::Buffer::OpCopyBufferToImage>)
+					vkd::CommandBuffer::CmdCopyBufferToImage(commandBuffer, GetBuffer(command.Buffer), GetImage(command.Image), command.ImageLayout, command.RegionCount, regions.data());
+				else
+					vkd::CommandBuffer::CmdCopyImageToBuffer(commandBuffer, GetImage(command.Image), command.ImageLayout, GetBuffer(command.Buffer), command.RegionCount, regions.data());
+				return true;
+			}
+			case OpType<vkd::Image::OpCopy>:
+			{
+				capture::CopyImageCommand command = {};
+				std::span<const VkImageCopy> regions;
+				if (!ReadValue(payload, 0, command) || !ReadArray(payload, sizeof(command), command.RegionCount, regions))
+					return false;
+				vkd::CommandBuffer::CmdCopyImage(commandBuffer, GetImage(command.Src), command.SrcLayout, GetImage(command.Dst), command.DstLayout, command.RegionCount, regions.data());
+				return true;
+			}
+			case OpType<vkd::Image::OpClearColorImage>:
+			{
+				capture::ClearColorImageCommand command = {};
+				std::span<const VkImageSubresourceRange> ranges;
+				if (!ReadValue(payload, 0, command) || !ReadArray(payload, sizeof(command), command.RangeCount, ranges))
+					return false;
+				vkd::CommandBuffer::CmdClearColorImage(commandBuffer, GetImage(command.Image), command.Layout, &command.Color, command.RangeCount, ranges.data());
+				return true;
+			}
+			case OpType<vkd::OpBindVertexBuffer>:
+			{
+				capture::BindVertexBuffersCommand command = {};
+				std::span<const UInt64> ids;
+				std::span<const VkDeviceSize> offsets;
+				if (!ReadValue(payload, 0, command) || !ReadArray(payload, sizeof(command), command.BindingCount, ids) ||
+					!ReadArray(payload, sizeof(command) + ids.size_bytes(), command.BindingCount, offsets))
+					return false;
+
+				std::vector<VkBuffer> buffers;
+				buffers.reserve(ids.size());
+				for (UInt64 id : ids)
+					buffers.push_back(GetBuffer(id));
+				vkd::CommandBuffer::CmdBindVertexBuffers(commandBuffer, command.FirstBinding, command.BindingCount, buffers.data(), offsets.data());
+				return true;
+			}
+			case OpType<vkd::OpExecuteCommands>:
+			{
+				capture::ExecuteCommandsCommand command = {};
+				std::span<const UInt64> ids;
+				if (!ReadValue(payload, 0, command) || !ReadArray(payload, sizeof(command), command.CommandBufferCount, ids))
+					return false;
+
+				std::vector<VkCommandBuffer> secondaries;
+				secondaries.reserve(ids.size());
+				for (UInt64 id : ids)
+				{
+					auto it = m_commandBuffers.find(id);
+					if (it == m_commandBuffers.end())
+						return false;
+					secondaries.push_back(it->second);
+				}
+				vkd::CommandBuffer::CmdExecuteCommands(commandBuffer, command.CommandBufferCount, secondaries.data());
+				return true;
+			}
+			case OpType<vkd::OpPipelineBarrier>:
+			{
+				vkd::OpPipelineBarrier command = {};
+				if (!ReadValue(payload, 0, command))
+					return false;
+				vkd::CommandBuffer::CmdPipelineBarrier(commandBuffer, command.SrcStageMask, command.DstStageMask, command.DependencyFlags, 0, nullptr, 0, nullptr, 0, nullptr);
+				return true;
+			}
+			case OpType<vkd::OpSetEvent>:
+			case OpType<vkd::OpResetEvent>:
+			{
+				capture::EventCommand command = {};
+				if (!ReadValue(payload, 0, command))
+					return false;
+
+				VkEvent event = GetEvent(command.Event);
+				if (!event)
+					return false;
+
+				if (type == OpType<vkd::OpSetEvent>)
+					vkd::CommandBuffer::CmdSetEvent(commandBuffer, event, command.StageMask);
+				else
+					vkd::CommandBuffer::CmdResetEvent(commandBuffer, event, command.StageMask);
+				return true;
+			}
+			case OpType<vkd::OpWaitEvents>:
+			{
+				capture::WaitEventsCommand command = {};
+				std::span<const UInt64> ids;
+				if (!ReadValue(payload, 0, command) || !ReadArray(payload, sizeof(command), command.EventCount, ids))
+					return false;
+
+				std::vector<VkEvent> events;
+				events.reserve(ids.size());
+				for (UInt64 id : ids)
+				{
+					VkEvent event = GetEvent(id);
+					if (!event)
+						return false;
+					events.push_back(event);
+				}
+				vkd::CommandBuffer::CmdWaitEvents(commandBuffer, command.EventCount, events.data(), command.SrcStageMask, command.DstStageMask, 0, nullptr, 0, nullptr, 0, nullptr);
+				return true;
+			}
+			case OpType<vkd::OpBindPipeline>:
+			case OpType<vkd::OpDraw>:
+			case OpType<vkd::OpDrawIndexed>:
+			case OpType<vkd::OpDrawIndirect>:
+			case OpType<vkd::OpDrawIndexedIndirect>:
+				// Pipelines are not part of the capture, draws have nothing to run with
+				++m_opStats[type].Skipped;
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	bool Replayer::ReplaySubmit(std::span<const std::byte> payload, const Options& options)
+	{
+		capture::SubmitRecord record = {};
+		std::span<const UInt64> ids;
+		if (!ReadValue(payload, 0, record) || !ReadArray(payload, sizeof(record), record.CommandBufferCount, ids))
+			return false;
+
+		if (m_submitStats.size() <= record.Index)
+			m_submitStats.resize(record.Index + 1);
+
+		// Host sets are not captured, waits not resolved inside their command buffer must not block the replay
+		for (auto& [eventId, event] : m_events)
+			vkd::Device::SetEvent(m_device, event);
+
+		const auto start = std::chrono::steady_clock::now();
+		for (UInt64 id : ids)
+		{
+			auto it = m_commandBuffers.find(id);
+			if (it == m_commandBuffers.end())
+			{
+				cct::Logger::Error("Submit {} references unknown command buffer {}", record.Index, id);
+				return false;
+			}
+
+			VKD_FROM_HANDLE(vkd::CommandBuffer, commandBuffer, it->second);
+			const auto& softwareCommandBuffer = static_cast<const software::CommandBuffer&>(*commandBuffer);
+
+			m_cpuContext.Reset();
+			m_cpuContext.ResetScratch();
+			software::CommandDispatcher dispatcher(m_cpuContext, options.Parallel ? &m_softwareDevice->GetTaskTenant() : nullptr);
+			const bool executed = options.Parallel ? dispatcher.Execute(softwareCommandBuffer) == VK_SUCCESS : ExecuteStepped(dispatcher, softwareCommandBuffer);
+			if (!executed)
+			{
+				cct::Logger::Error("Execution of submit {} failed", record.Index);
+				return false;
+			}
+		}
+
+		const UInt64 elapsed = ElapsedNanoseconds(start);
+		SubmitStats& stats = m_submitStats[record.Index];
+		++stats.Count;
+		stats.TotalNanoseconds += elapsed;
+		stats.MinNanoseconds = std::min(stats.MinNanoseconds, elapsed);
+		stats.MaxNanoseconds = std::max(stats.MaxNanoseconds, elapsed);
+		return true;
+	}
+
+	bool Replayer::ExecuteStepped(software::CommandDispatcher& dispatcher, const software::CommandBuffer& commandBuffer)
+	{
+		if (!commandBuffer.IsSealed())
+			return false;
+
+		// Secondaries run inside their ExecuteCommands step and are accounted to it
+		for (const software::ExecutionPlan::Step& step : commandBuffer.GetExecutionPlan().GetSteps())
+		{
+			const auto start = std::chrono::steady_clock::now();
+			if (step.Execute(dispatcher, step) != VK_SUCCESS)
+				return false;
+			const UInt64 elapsed = ElapsedNanoseconds(start);
+
+			OpStats& stats = m_opStats[step.Type];
+			++stats.Count;
+			stats.TotalNanoseconds += elapsed;
+			stats.MaxNanoseconds = std::max(stats.MaxNanoseconds, elapsed);
+		}
+
+		return true;
+	}
+
+	bool Replayer::CreateResource(UInt64 id, const capture::ResourceRecord& record)
+	{
+		Resource resource = {record.Kind, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, nullptr, record.Size};
+		VkMemoryRequirements requirements = {};
+
+		if (record.Kind == capture::ResourceKind::Buffer)
+		{
+			const VkBufferCreateInfo createInfo = {
+				.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+				.size = record.Size,
+				.usage = record.Usage,
+				.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+			};
+			if (vkd::Device::CreateBuffer(m_device, &createInfo, nullptr, &resource.BufferHandle) != VK_SUCCESS)
+				return false;
+			vkd::Device::GetBufferMemoryRequirements(m_device, resource.BufferHandle, &requirements);
+		}
+		else
+		{
+			const VkImageCreateInfo createInfo = {
+				.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+				.imageType = record.ImageType,
+				.format = record.Format,
+				.extent = record.Extent,
+				.mipLevels = record.MipLevels,
+				.arrayLayers = record.ArrayLayers,
+				.samples = record.Samples,
+				.tiling = record.Tiling,
+				.usage = record.Usage,
+				.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+				.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+			};
+			if (vkd::Device::CreateImage(m_device, &createInfo, nullptr, &resource.ImageHandle) != VK_SUCCESS)
+				return false;
+			vkd::Device::GetImageMemoryRequirements(m_device, resource.ImageHandle, &requirements);
+			resource.Size = requirements.size;
+		}
+
+		// Every resource gets its own allocation, aliasing in the captured application is not reproduced
+		const VkMemoryAllocateInfo allocateInfo = {
+			.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+			.allocationSize = requirements.size,
+			.memoryTypeIndex = FindMemoryType(requirements.memoryTypeBits),
+		};
+		if (vkd::Device::AllocateMemory(m_device, &allocateInfo, nullptr, &resource.Memory) != VK_SUCCESS)
+			return false;
+
+		const VkResult result = record.Kind == capture::ResourceKind::Buffer ? vkd::Device::BindBufferMemory(m_device, resource.BufferHandle, resource.Memory, 0) : vkd::Device::BindImageMemory(m_device, resource.ImageHandle, resource.Memory, 0);
+		if (result != VK_SUCCESS || vkd::Device::MapMemory(m_device, resource.Memory, 0, VK_WHOLE_SIZE, 0, &resource.MappedData) != VK_SUCCESS)
+			return false;
+
+		m_resources.emplace(id, resource);
+		return true;
+	}
+
+	VkBuffer Replayer::GetBuffer(UInt64 id) const
+	{
+		auto it = m_resources.find(id);
+		return it != m_resources.end() ? it->second.BufferHandle : VK_NULL_HANDLE;
+	}
+
+	VkImage Replayer::GetImage(UInt64 id) const
+	{
+		auto it = m_resources.find(id);
+		return it != m_resources.end() ? it->second.ImageHandle : VK_NULL_HANDLE;
+	}
+
+	VkEvent Replayer::GetEvent(UInt64 id)
+	{
+		auto it = m_events.find(id);
+		if (it != m_events.end())
+			return it->second;
+
+		const VkEventCreateInfo createInfo = {.sType = VK_STRUCTURE_TYPE_EVENT_CREATE_INFO};
+		VkEvent event = VK_NULL_HANDLE;
+		if (vkd::Device::CreateEvent(m_device, &createInfo, nullptr, &event) != VK_SUCCESS)
+			return VK_NULL_HANDLE;
+
+		m_events.emplace(id, event);
+		return event;
+	}
+
+	UInt32 Replayer::FindMemoryType(UInt32 memoryTypeBits) const
+	{
+		for (UInt32 i = 0; i < m_memoryProperties.memoryTypeCount; ++i)
+		{
+			if ((memoryTypeBits & (1u << i)) && (m_memoryProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
+				return i;
+		}
+		return 0;
+	}
+} // namespace vkd::replay
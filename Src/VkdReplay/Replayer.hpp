@@ -0,0 +1,110 @@
+/**
+ * @file Replayer.hpp
+ * @brief Replays a command capture on the software driver
+ * @date 2026-10-16
+ *
+ * Resources and command buffers of the capture are recreated through the driver
+ * entry points, submits are then executed directly through CommandDispatcher so
+ * the timings cover command execution only, not queue scheduling. Pipelines are
+ * not captured, pipeline binds and draws are skipped and reported as such.
+ */
+
+#pragma once
+
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Vkd/CommandBuffer/CommandBuffer.hpp"
+#include "VkdSoftware/Capture/CaptureFormat.hpp"
+#include "VkdSoftware/CpuContext/CpuContext.hpp"
+#include "VkdUtils/MappedFile/MappedFile.hpp"
+
+namespace vkd::software
+{
+	class CommandBuffer;
+	class CommandDispatcher;
+	class SoftwareDevice;
+} // namespace vkd::software
+
+namespace vkd::replay
+{
+	namespace capture = software::capture;
+
+	class Replayer
+	{
+	public:
+		struct Options
+		{
+			UInt32 Iterations = 1;
+			/// Executes submits through CommandDispatcher::Execute, batches may fan out and per op timings are not collected
+			bool Parallel = false;
+		};
+
+		Replayer() = default;
+		~Replayer();
+
+		Replayer(const Replayer&) = delete;
+		Replayer& operator=(const Replayer&) = delete;
+
+		bool Init();
+		bool Load(const std::string& path);
+		bool Run(const Options& options);
+		void PrintReport() const;
+
+	private:
+		struct Resource
+		{
+			capture::ResourceKind Kind;
+			VkBuffer BufferHandle;
+			VkImage ImageHandle;
+			VkDeviceMemory Memory;
+			void* MappedData;
+			VkDeviceSize Size;
+		};
+
+		struct OpStats
+		{
+			UInt64 Count = 0;
+			UInt64 Skipped = 0;
+			UInt64 TotalNanoseconds = 0;
+			UInt64 MaxNanoseconds = 0;
+		};
+
+		struct SubmitStats
+		{
+			UInt64 Count = 0;
+			UInt64 TotalNanoseconds = 0;
+			UInt64 MinNanoseconds = ~UInt64(0);
+			UInt64 MaxNanoseconds = 0;
+		};
+
+		bool ReplayResource(std::span<const std::byte> payload);
+		bool ReplayCommandBuffer(std::span<const std::byte> payload);
+		bool ReplayCommand(VkCommandBuffer commandBuffer, UInt32 type, std::span<const std::byte> payload);
+		bool ReplaySubmit(std::span<const std::byte> payload, const Options& options);
+		bool ExecuteStepped(software::CommandDispatcher& dispatcher, const software::CommandBuffer& commandBuffer);
+
+		bool CreateResource(UInt64 id, const capture::ResourceRecord& record);
+		[[nodiscard]] VkBuffer GetBuffer(UInt64 id) const;
+		[[nodiscard]] VkImage GetImage(UInt64 id) const;
+		/// Events are created the first time a command references their id
+		[[nodiscard]] VkEvent GetEvent(UInt64 id);
+		[[nodiscard]] UInt32 FindMemoryType(UInt32 memoryTypeBits) const;
+
+		MappedFile m_file;
+		VkInstance m_instance = VK_NULL_HANDLE;
+		VkPhysicalDevice m_physicalDevice = VK_NULL_HANDLE;
+		VkDevice m_device = VK_NULL_HANDLE;
+		VkCommandPool m_commandPool = VK_NULL_HANDLE;
+		software::SoftwareDevice* m_softwareDevice = nullptr;
+		software::CpuContext m_cpuContext; ///< Reused like a queue's, replay timings include no context setup
+		VkPhysicalDeviceMemoryProperties m_memoryProperties = {};
+		std::unordered_map<UInt64, Resource> m_resources;
+		std::unordered_map<UInt64, VkCommandBuffer> m_commandBuffers;
+		std::unordered_map<UInt64, VkEvent> m_events;
+		std::vector<OpStats> m_opStats; ///< Indexed by CommandBuffer::OpType
+		std::vector<SubmitStats> m_submitStats;
+	};
+} // namespace vkd::replay
@@ -0,0 +1,65 @@
+/**
+ * @file main.cpp
+ * @brief vkd-replay entry point
+ * @date 2026-10-16
+ *
+ * Replays a trace recorded with VKD_CAPTURE and reports per op type and per submit timings.
+ *
+ * Usage: vkd-replay <capture> [--iterations N] [--parallel]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "VkdReplay/Replayer.hpp"
+
+namespace
+{
+	void PrintUsage(const char* program)
+	{
+		std::fprintf(stderr, "Usage: %s <capture> [--iterations N] [--parallel]\n", program);
+		std::fprintf(stderr, "  --iterations N  Replays the whole capture N times (default 1)\n");
+		std::fprintf(stderr, "  --parallel      Executes submits through the thread pool, per op timings are not collected\n");
+	}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		PrintUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	std::string capturePath;
+	vkd::replay::Replayer::Options options;
+	for (int i = 1; i < argc; ++i)
+	{
+		if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+			options.Iterations = static_cast<vkd::UInt32>(std::strtoul(argv[++i], nullptr, 10));
+		else if (std::strcmp(argv[i], "--parallel") == 0)
+			options.Parallel = true;
+		else if (capturePath.empty() && argv[i][0] != '-')
+			capturePath = argv[i];
+		else
+		{
+			PrintUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (capturePath.empty() || options.Iterations == 0)
+	{
+		PrintUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	vkd::replay::Replayer replayer;
+	if (!replayer.Init() || !replayer.Load(capturePath) || !replayer.Run(options))
+		return EXIT_FAILURE;
+
+	replayer.PrintReport();
+	return EXIT_SUCCESS;
+}
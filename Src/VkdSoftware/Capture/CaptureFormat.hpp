@@ -0,0 +1,205 @@
+/**
+ * @file CaptureFormat.hpp
+ * @brief Binary layout of command capture files
+ * @date 2026-10-16
+ *
+ * A capture is a FileHeader followed by records, each one a RecordHeader and a
+ * payload padded to 8 bytes. A record type of zero or the end of the file ends
+ * the capture. Resource pointers are replaced by capture ids, zero standing for
+ * a null resource. Captures are raw dumps of host structures, they are only
+ * meant to be replayed on the architecture that produced them.
+ *
+ * Draws and barriers hold no resource and are stored as their op structure.
+ * Events have no record, the replay creates one the first time an id shows up.
+ * Command types are the CommandBuffer::OpType indices of the capturing build,
+ * Version must be bumped whenever the op list or an encoded command changes.
+ */
+
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <Concerto/Core/Types/Types.hpp>
+
+namespace vkd::software::capture
+{
+	using namespace cct;
+
+	static constexpr UInt32 Magic = 0x5043'4B56; // "VKCP"
+	static constexpr UInt32 Version = 2;
+	static constexpr UInt64 RecordAlignment = 8;
+
+	[[nodiscard]] constexpr UInt64 AlignRecordSize(UInt64 size)
+	{
+		return (size + RecordAlignment - 1) & ~(RecordAlignment - 1);
+	}
+
+	struct FileHeader
+	{
+		UInt32 Magic;
+		UInt32 Version;
+	};
+
+	enum class RecordType : UInt32
+	{
+		End = 0,
+		Resource = 1,	   ///< ResourceRecord, followed by the resource contents when HasContents is set
+		CommandBuffer = 2, ///< CommandBufferRecord, followed by CommandCount commands
+		Submit = 3,		   ///< SubmitRecord, followed by CommandBufferCount command buffer ids
+	};
+
+	struct RecordHeader
+	{
+		RecordType Type;
+		UInt32 Reserved;
+		UInt64 Size; ///< Payload size, padding included
+	};
+
+	enum class ResourceKind : UInt32
+	{
+		Buffer = 0,
+		Image = 1,
+	};
+
+	/// Emitted the first time a resource is referenced by a submit, then again each time its contents changed
+	struct ResourceRecord
+	{
+		static constexpr UInt32 HasContents = 1 << 0;
+
+		UInt64 Id;
+		ResourceKind Kind;
+		UInt32 Flags;
+		VkDeviceSize Size; ///< Buffer size or image memory requirements, also the size of the contents
+		UInt32 Usage;
+		VkFormat Format;
+		VkImageType ImageType;
+		VkImageTiling Tiling;
+		VkExtent3D Extent;
+		UInt32 MipLevels;
+		UInt32 ArrayLayers;
+		VkSampleCountFlagBits Samples;
+	};
+
+	/// Emitted once per recording, a re-recorded command buffer gets a new id
+	struct CommandBufferRecord
+	{
+		UInt64 Id;
+		VkCommandBufferLevel Level;
+		UInt32 CommandCount;
+	};
+
+	struct CommandRecord
+	{
+		UInt32 Type;
+		UInt32 Size; ///< Payload size, padding included
+	};
+
+	struct SubmitRecord
+	{
+		UInt64 Index;
+		UInt32 CommandBufferCount;
+		UInt32 Reserved;
+	};
+
+	struct FillBufferCommand
+	{
+		UInt64 Dst;
+		VkDeviceSize Offset;
+		VkDeviceSize Size;
+		UInt32 Data;
+		UInt32 Reserved;
+	};
+
+	/// Both copy flavours, followed by RegionCount VkBufferCopy
+	struct CopyBufferCommand
+	{
+		UInt64 Src;
+		UInt64 Dst;
+		UInt32 RegionCount;
+		UInt32 Reserved;
+	};
+
+	/// Followed by DataSize bytes
+	struct UpdateBufferCommand
+	{
+		UInt64 Dst;
+		VkDeviceSize Offset;
+		VkDeviceSize DataSize;
+	};
+
+	/// Both directions, followed by RegionCount VkBufferImageCopy
+	struct BufferImageCopyCommand
+	{
+		UInt64 Buffer;
+		UInt64 Image;
+		VkImageLayout ImageLayout;
+		UInt32 RegionCount;
+	};
+
+	/// Followed by RegionCount VkImageCopy
+	struct CopyImageCommand
+	{
+		UInt64 Src;
+		UInt64 Dst;
+		VkImageLayout SrcLayout;
+		VkImageLayout DstLayout;
+		UInt32 RegionCount;
+		UInt32 Reserved;
+	};
+
+	/// Followed by RangeCount VkImageSubresourceRange
+	struct ClearColorImageCommand
+	{
+		UInt64 Image;
+		VkClearColorValue Color;
+		VkImageLayout Layout;
+		UInt32 RangeCount;
+	};
+
+	/// Followed by BindingCount buffer ids then BindingCount offsets
+	struct BindVertexBuffersCommand
+	{
+		UInt32 FirstBinding;
+		UInt32 BindingCount;
+	};
+
+	/// Pipelines are not captured, only the bind point is kept
+	struct BindPipelineCommand
+	{
+		VkPipelineBindPoint BindPoint;
+		UInt32 Reserved;
+	};
+
+	/// Both indirect draw flavours
+	struct DrawIndirectCommand
+	{
+		UInt64 Buffer;
+		VkDeviceSize Offset;
+		UInt32 DrawCount;
+		UInt32 Stride;
+	};
+
+	/// Both set and reset
+	struct EventCommand
+	{
+		UInt64 Event;
+		VkPipelineStageFlags StageMask;
+		UInt32 Reserved;
+	};
+
+	/// Followed by EventCount event ids
+	struct WaitEventsCommand
+	{
+		VkPipelineStageFlags SrcStageMask;
+		VkPipelineStageFlags DstStageMask;
+		UInt32 EventCount;
+		UInt32 Reserved;
+	};
+
+	/// Followed by CommandBufferCount command buffer ids, recorded before the command buffer using them
+	struct ExecuteCommandsCommand
+	{
+		UInt32 CommandBufferCount;
+		UInt32 Reserved;
+	};
+} // namespace vkd::software::capture
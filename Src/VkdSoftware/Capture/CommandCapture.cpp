@@ -0,0 +1,382 @@
+/**
+ * @file CommandCapture.cpp
+ * @brief Implementation of command capture
+ * @date 2026-10-16
+ */
+
+#include "VkdSoftware/Capture/CommandCapture.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include <Concerto/Core/Logger/Logger.hpp>
+
+#include "VkdSoftware/DeviceMemory/DeviceMemory.hpp"
+
+namespace vkd::software
+{
+	namespace
+	{
+		using Encoder = void (*)(CommandCapture& capture, const void* op);
+
+		template<typename... Ts>
+		constexpr std::array<Encoder, sizeof...(Ts)> MakeEncoderTable(Nz::TypeList<Ts...>)
+		{
+			return {&CommandCapture::EncodeOp<Ts>...};
+		}
+
+		UInt64 HashContents(const UByte* data, std::size_t size)
+		{
+			// FNV-1a, only used to detect changes between submits
+			UInt64 hash = 14695981039346656037ULL;
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				hash ^= data[i];
+				hash *= 1099511628211ULL;
+			}
+			return hash;
+		}
+
+		bool SameResource(capture::ResourceRecord first, capture::ResourceRecord second)
+		{
+			first.Id = second.Id = 0;
+			first.Flags = second.Flags = 0;
+			return std::memcmp(&first, &second, sizeof(capture::ResourceRecord)) == 0;
+		}
+
+		template<typename T>
+		std::span<const std::byte> AsBytes(const T& value)
+		{
+			return std::as_bytes(std::span<const T>(&value, 1));
+		}
+	} // namespace
+
+	CommandCapture::~CommandCapture()
+	{
+		if (m_file.IsOpen())
+			m_file.Close(m_used);
+	}
+
+	bool CommandCapture::Open(const std::string& path)
+	{
+		if (!m_file.Create(path, InitialFileSize))
+		{
+			cct::Logger::Error("Could not create command capture file '{}'", path);
+			return false;
+		}
+
+		const capture::FileHeader header = {capture::Magic, capture::Version};
+		std::memcpy(m_file.GetData(), &header, sizeof(header));
+		m_used = capture::AlignRecordSize(sizeof(header));
+
+		cct::Logger::Info("Capturing submitted command buffers to '{}'", path);
+		return true;
+	}
+
+	void CommandCapture::CaptureSubmit(std::span<vkd::CommandBuffer* const> commandBuffers)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_file.IsOpen() || m_failed)
+			return;
+
+		std::vector<UInt64> ids;
+		ids.reserve(commandBuffers.size());
+		for (const vkd::CommandBuffer* commandBuffer : commandBuffers)
+			ids.push_back(CaptureCommandBuffer(*commandBuffer));
+
+		const capture::SubmitRecord record = {m_submitIndex, static_cast<UInt32>(ids.size()), 0};
+		WriteRecord(capture::RecordType::Submit, {AsBytes(record), std::as_bytes(std::span<const UInt64>(ids))});
+		++m_submitIndex;
+	}
+
+	UInt64 CommandCapture::CaptureCommandBuffer(const vkd::CommandBuffer& commandBuffer)
+	{
+		static constexpr auto encoders = MakeEncoderTable(vkd::CommandBuffer::AllOps{});
+
+		// Encoding is what discovers the referenced resources, it also runs for recordings
+		// already in the trace so that their resources are captured again if they changed
+		std::vector<std::byte> encoding;
+		std::vector<std::byte>* parentEncoding = std::exchange(m_encoding, &encoding);
+
+		UInt32 commandCount = 0;
+		for (const CommandHeader& command : commandBuffer.GetCommands())
+		{
+			CCT_ASSERT(command.Type < encoders.size(), "Invalid command type {}", command.Type);
+
+			const std::size_t start = encoding.size();
+			Append(capture::CommandRecord{command.Type, 0});
+			encoders[command.Type](*this, command.GetPayload());
+
+			const std::size_t size = capture::AlignRecordSize(encoding.size() - start - sizeof(capture::CommandRecord));
+			encoding.resize(start + sizeof(capture::CommandRecord) + size, std::byte{0});
+
+			const capture::CommandRecord record = {command.Type, static_cast<UInt32>(size)};
+			std::memcpy(encoding.data() + start, &record, sizeof(record));
+			++commandCount;
+		}
+
+		m_encoding = parentEncoding;
+
+		auto it = m_commandBuffers.find(&commandBuffer);
+		if (it != m_commandBuffers.end() && it->second.RecordingId == commandBuffer.GetRecordingId())
+			return it->second.Id;
+
+		const capture::CommandBufferRecord record = {m_nextId++, commandBuffer.GetLevel(), commandCount};
+		WriteRecord(capture::RecordType::CommandBuffer, {AsBytes(record), std::span<const std::byte>(encoding)});
+		m_commandBuffers[&commandBuffer] = CommandBufferEntry{commandBuffer.GetRecordingId(), record.Id};
+		return record.Id;
+	}
+
+	UInt64 CommandCapture::CaptureResource(const vkd::Buffer* buffer)
+	{
+		if (!buffer || !buffer->GetMemory())
+			return 0;
+
+		capture::ResourceRecord description = {};
+		description.Kind = capture::ResourceKind::Buffer;
+		description.Size = buffer->GetSize();
+		description.Usage = buffer->GetUsage();
+
+		const UByte* contents = static_cast<const DeviceMemory*>(buffer->GetMemory())->Data() + buffer->GetMemoryOffset();
+		return CaptureResource(buffer, description, contents);
+	}
+
+	UInt64 CommandCapture::CaptureResource(const vkd::Image* image)
+	{
+		if (!image || !image->GetMemory())
+			return 0;
+
+		VkMemoryRequirements requirements = {};
+		image->GetMemoryRequirements(requirements);
+
+		capture::ResourceRecord description = {};
+		description.Kind = capture::ResourceKind::Image;
+		description.Size = requirements.size;
+		description.Usage = image->GetUsage();
+		description.Format = image->GetFormat();
+		description.ImageType = image->GetImageType();
+		description.Tiling = image->GetTiling();
+		description.Extent = image->GetExtent();
+		description.MipLevels = image->GetMipLevels();
+		description.ArrayLayers = image->GetArrayLayers();
+		description.Samples = image->GetSamples();
+
+		const UByte* contents = static_cast<const DeviceMemory*>(image->GetMemory())->Data() + image->GetMemoryOffset();
+		return CaptureResource(image, description, contents);
+	}
+
+	UInt64 CommandCapture::CaptureResource(const void* key, capture::ResourceRecord& description, const UByte* contents)
+	{
+		auto it = m_resources.find(key);
+		// A destroyed resource may have its address reused by a different one
+		if (it != m_resources.end() && SameResource(it->second.Description, description))
+		{
+			ResourceEntry& entry = it->second;
+			if (entry.LastSubmit == m_submitIndex)
+				return entry.Description.Id;
+
+			entry.LastSubmit = m_submitIndex;
+			const UInt64 hash = HashContents(contents, description.Size);
+			if (hash == entry.ContentHash)
+				return entry.Description.Id;
+
+			entry.ContentHash = hash;
+			WriteRecord(capture::RecordType::Resource, {AsBytes(entry.Description), std::as_bytes(std::span<const UByte>(contents, description.Size))});
+			return entry.Description.Id;
+		}
+
+		description.Id = m_nextId++;
+		description.Flags = capture::ResourceRecord::HasContents;
+		m_resources[key] = ResourceEntry{description, HashContents(contents, description.Size), m_submitIndex};
+
+		WriteRecord(capture::RecordType::Resource, {AsBytes(description), std::as_bytes(std::span<const UByte>(contents, description.Size))});
+		return description.Id;
+	}
+
+	UInt64 CommandCapture::CaptureEvent(const vkd::Event* event)
+	{
+		auto [it, inserted] = m_events.try_emplace(event, 0);
+		if (inserted)
+			it->second = m_nextId++;
+		return it->second;
+	}
+
+	void CommandCapture::Encode(const vkd::Buffer::OpFill& op)
+	{
+		Append(capture::FillBufferCommand{CaptureResource(op.dst), op.offset, op.size, op.data, 0});
+	}
+
+	void CommandCapture::Encode(const vkd::Buffer::OpCopy& op)
+	{
+		Append(capture::CopyBufferCommand{CaptureResource(op.src), CaptureResource(op.dst), static_cast<UInt32>(op.regions.size()), 0});
+		AppendArray(op.regions);
+	}
+
+	void CommandCapture::Encode(const vkd::Buffer::OpCopy2& op)
+	{
+		Append(capture::CopyBufferCommand{CaptureResource(op.src), CaptureResource(op.dst), static_cast<UInt32>(op.regions.size()), 0});
+		for (const VkBufferCopy2& region : op.regions)
+			Append(VkBufferCopy{region.srcOffset, region.dstOffset, region.size});
+	}
+
+	void CommandCapture::Encode(const vkd::Buffer::OpUpdate& op)
+	{
+		Append(capture::UpdateBufferCommand{CaptureResource(op.dst), op.offset, op.data.size()});
+		AppendArray(op.data);
+	}
+
+	void CommandCapture::Encode(const vkd::Buffer::OpCopyBufferToImage& op)
+	{
+		Append(capture::BufferImageCopyCommand{CaptureResource(op.src), CaptureResource(op.dst), op.dstLayout, static_cast<UInt32>(op.regions.size())});
+		AppendArray(op.regions);
+	}
+
+	void CommandCapture::Encode(const vkd::Buffer::OpCopyImageToBuffer& op)
+	{
+		Append(capture::BufferImageCopyCommand{CaptureResource(op.dst), CaptureResource(op.src), op.srcLayout, static_cast<UInt32>(op.regions.size())});
+		AppendArray(op.regions);
+	}
+
+	void CommandCapture::Encode(const vkd::Image::OpCopy& op)
+	{
+		Append(capture::CopyImageCommand{CaptureResource(op.src), CaptureResource(op.dst), VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_GENERAL, static_cast<UInt32>(op.regions.size()), 0});
+		AppendArray(op.regions);
+	}
+
+	void CommandCapture::Encode(const vkd::Image::OpClearColorImage& op)
+	{
+		Append(capture::ClearColorImageCommand{CaptureResource(op.image), op.clearColor, op.layout, static_cast<UInt32>(op.ranges.size())});
+		AppendArray(op.ranges);
+	}
+
+	void CommandCapture::Encode(const vkd::OpBindVertexBuffer& op)
+	{
+		Append(capture::BindVertexBuffersCommand{op.FirstBinding, static_cast<UInt32>(op.Buffers.size())});
+		for (const vkd::Buffer* buffer : op.Buffers)
+			Append(CaptureResource(buffer));
+		AppendArray(op.Offsets);
+	}
+
+	void CommandCapture::Encode(const vkd::OpDraw& op)
+	{
+		Append(op);
+	}
+
+	void CommandCapture::Encode(const vkd::OpDrawIndexed& op)
+	{
+		Append(op);
+	}
+
+	void CommandCapture::Encode(const vkd::OpDrawIndirect& op)
+	{
+		Append(capture::DrawIndirectCommand{CaptureResource(op.BufferHandle), op.Offset, op.DrawCount, op.Stride});
+	}
+
+	void CommandCapture::Encode(const vkd::OpDrawIndexedIndirect& op)
+	{
+		Append(capture::DrawIndirectCommand{CaptureResource(op.BufferHandle), op.Offset, op.DrawCount, op.Stride});
+	}
+
+	void CommandCapture::Encode(const vkd::OpBindPipeline& op)
+	{
+		Append(capture::BindPipelineCommand{op.BindPoint, 0});
+	}
+
+	void CommandCapture::Encode(const vkd::OpExecuteCommands& op)
+	{
+		// Secondaries land in the trace before the command buffer executing them
+		std::vector<UInt64> ids;
+		ids.reserve(op.CommandBuffers.size());
+		for (const vkd::CommandBuffer* secondary : op.CommandBuffers)
+			ids.push_back(CaptureCommandBuffer(*secondary));
+
+		Append(capture::ExecuteCommandsCommand{static_cast<UInt32>(ids.size()), 0});
+		AppendArray(std::span<const UInt64>(ids));
+	}
+
+	void CommandCapture::Encode(const vkd::OpPipelineBarrier& op)
+	{
+		Append(op);
+	}
+
+	void CommandCapture::Encode(const vkd::OpSetEvent& op)
+	{
+		Append(capture::EventCommand{CaptureEvent(op.EventObject), op.StageMask, 0});
+	}
+
+	void CommandCapture::Encode(const vkd::OpResetEvent& op)
+	{
+		Append(capture::EventCommand{CaptureEvent(op.EventObject), op.StageMask, 0});
+	}
+
+	void CommandCapture::Encode(const vkd::OpWaitEvents& op)
+	{
+		Append(capture::WaitEventsCommand{op.SrcStageMask, op.DstStageMask, static_cast<UInt32>(op.Events.size()), 0});
+		for (const vkd::Event* event : op.Events)
+			Append(CaptureEvent(event));
+	}
+
+	void CommandCapture::Append(const void* data, std::size_t size)
+	{
+		CCT_ASSERT(m_encoding, "No command buffer is being encoded");
+
+		const std::size_t offset = m_encoding->size();
+		m_encoding->resize(offset + size);
+		if (size != 0)
+			std::memcpy(m_encoding->data() + offset, data, size);
+	}
+
+	bool CommandCapture::WriteRecord(capture::RecordType type, std::initializer_list<std::span<const std::byte>> payload)
+	{
+		std::size_t payloadSize = 0;
+		for (std::span<const std::byte> part : payload)
+			payloadSize += part.size();
+
+		const capture::RecordHeader header = {type, 0, capture::AlignRecordSize(payloadSize)};
+		if (!Reserve(sizeof(header) + header.Size))
+			return false;
+
+		std::byte* data = m_file.GetData() + m_used;
+		std::memcpy(data, &header, sizeof(header));
+		data += sizeof(header);
+		for (std::span<const std::byte> part : payload)
+		{
+			if (part.empty())
+				continue;
+			std::memcpy(data, part.data(), part.size());
+			data += part.size();
+		}
+
+		// The file is zero filled when grown, padding is already cleared
+		m_used += sizeof(header) + header.Size;
+		return true;
+	}
+
+	bool CommandCapture::Reserve(std::size_t size)
+	{
+		if (m_failed)
+			return false;
+
+		const std::size_t required = m_used + size;
+		if (required <= m_file.GetSize())
+			return true;
+
+		std::size_t fileSize = std::max(m_file.GetSize(), InitialFileSize);
+		while (fileSize < required)
+			fileSize *= 2;
+
+		if (!m_file.Resize(fileSize))
+		{
+			// Later submits are dropped, the records written so far stay readable
+			cct::Logger::Error("Could not grow command capture file to {} bytes, capture stopped", fileSize);
+			m_failed = true;
+			return false;
+		}
+
+		return true;
+	}
+} // namespace vkd::software
@@ -0,0 +1,114 @@
+/**
+ * @file CommandCapture.hpp
+ * @brief Capture of submitted command buffers to a memory-mapped trace
+ * @date 2026-10-16
+ *
+ * Enabled by setting VKD_CAPTURE to the output path. Every submit is appended to
+ * the trace with the command buffers it executes and the contents of the buffers
+ * and images they reference, so vkd-replay can execute it again in isolation.
+ * Command buffers are encoded once per recording and resource contents are only
+ * written again when they changed since the previous submit.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Vkd/CommandBuffer/CommandBuffer.hpp"
+#include "VkdSoftware/Capture/CaptureFormat.hpp"
+#include "VkdUtils/MappedFile/MappedFile.hpp"
+
+namespace vkd::software
+{
+	class CommandCapture
+	{
+	public:
+		/// The trace starts this large and doubles whenever a record does not fit
+		static constexpr std::size_t InitialFileSize = 16 * 1024 * 1024;
+
+		CommandCapture() = default;
+		~CommandCapture();
+
+		CommandCapture(const CommandCapture&) = delete;
+		CommandCapture& operator=(const CommandCapture&) = delete;
+
+		bool Open(const std::string& path);
+
+		/// Called by the queue right before executing a submit, the command buffers must not be running
+		void CaptureSubmit(std::span<vkd::CommandBuffer* const> commandBuffers);
+
+		[[nodiscard]] inline bool IsOpen() const;
+
+		/// Encoder of op type T, appends the encoded op to the command buffer being captured
+		template<typename T>
+		static void EncodeOp(CommandCapture& capture, const void* op);
+
+	private:
+		struct ResourceEntry
+		{
+			capture::ResourceRecord Description;
+			UInt64 ContentHash;
+			UInt64 LastSubmit; ///< Contents are only hashed once per submit
+		};
+
+		struct CommandBufferEntry
+		{
+			UInt64 RecordingId;
+			UInt64 Id;
+		};
+
+		UInt64 CaptureCommandBuffer(const vkd::CommandBuffer& commandBuffer);
+		UInt64 CaptureResource(const vkd::Buffer* buffer);
+		UInt64 CaptureResource(const vkd::Image* image);
+		UInt64 CaptureResource(const void* key, capture::ResourceRecord& description, const UByte* contents);
+		UInt64 CaptureEvent(const vkd::Event* event);
+
+		void Encode(const vkd::Buffer::OpFill& op);
+		void Encode(const vkd::Buffer::OpCopy& op);
+		void Encode(const vkd::Buffer::OpCopy2& op);
+		void Encode(const vkd::Buffer::OpUpdate& op);
+		void Encode(const vkd::Buffer::OpCopyBufferToImage& op);
+		void Encode(const vkd::Buffer::OpCopyImageToBuffer& op);
+		void Encode(const vkd::Image::OpCopy& op);
+		void Encode(const vkd::Image::OpClearColorImage& op);
+		void Encode(const vkd::OpBindVertexBuffer& op);
+		void Encode(const vkd::OpDraw& op);
+		void Encode(const vkd::OpDrawIndexed& op);
+		void Encode(const vkd::OpDrawIndirect& op);
+		void Encode(const vkd::OpDrawIndexedIndirect& op);
+		void Encode(const vkd::OpBindPipeline& op);
+		void Encode(const vkd::OpExecuteCommands& op);
+		void Encode(const vkd::OpPipelineBarrier& op);
+		void Encode(const vkd::OpSetEvent& op);
+		void Encode(const vkd::OpResetEvent& op);
+		void Encode(const vkd::OpWaitEvents& op);
+
+		/// Appends to the command being encoded
+		void Append(const void* data, std::size_t size);
+		template<typename T>
+		void Append(const T& value);
+		template<typename T>
+		void AppendArray(std::span<const T> values);
+
+		/// Appends a record to the trace, payload parts are concatenated then padded
+		bool WriteRecord(capture::RecordType type, std::initializer_list<std::span<const std::byte>> payload);
+		bool Reserve(std::size_t size);
+
+		std::mutex m_mutex;
+		MappedFile m_file;
+		std::size_t m_used = 0;
+		bool m_failed = false;
+		std::unordered_map<const void*, ResourceEntry> m_resources;
+		std::unordered_map<const vkd::CommandBuffer*, CommandBufferEntry> m_commandBuffers;
+		std::unordered_map<const vkd::Event*, UInt64> m_events;
+		std::vector<std::byte>* m_encoding = nullptr;
+		UInt64 m_nextId = 1;
+		UInt64 m_submitIndex = 0;
+	};
+} // namespace vkd::software
+
+#include "VkdSoftware/Capture/CommandCapture.inl"
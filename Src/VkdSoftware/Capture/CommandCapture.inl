@@ -0,0 +1,39 @@
+/**
+ * @file CommandCapture.inl
+ * @brief Inline implementations for CommandCapture
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include "VkdSoftware/Capture/CommandCapture.hpp"
+
+namespace vkd::software
+{
+	inline bool CommandCapture::IsOpen() const
+	{
+		return m_file.IsOpen();
+	}
+
+	template<typename T>
+	void CommandCapture::EncodeOp(CommandCapture& capture, const void* op)
+	{
+		capture.Encode(*static_cast<const T*>(op));
+	}
+
+	template<typename T>
+	void CommandCapture::Append(const T& value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be encoded");
+		Append(&value, sizeof(T));
+	}
+
+	template<typename T>
+	void CommandCapture::AppendArray(std::span<const T> values)
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be encoded");
+		Append(values.data(), values.size_bytes());
+	}
+} // namespace vkd::software
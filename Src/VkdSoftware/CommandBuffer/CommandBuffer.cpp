@@ -8,5 +8,11 @@
 
 namespace vkd::software
 {
+	VkResult CommandBuffer::Compile()
+	{
+		VKD_AUTO_PROFILER_SCOPE();
 
-}
+		m_executionPlan.Build(GetCommands());
+		return VK_SUCCESS;
+	}
+} // namespace vkd::software
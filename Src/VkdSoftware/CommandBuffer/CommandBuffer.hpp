@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Vkd/CommandBuffer/CommandBuffer.hpp"
+#include "VkdSoftware/CommandBuffer/ExecutionPlan.hpp"
 
 namespace vkd::software
 {
@@ -17,6 +18,18 @@ namespace vkd::software
 	public:
 		CommandBuffer() = default;
 		~CommandBuffer() override = default;
+
+		/// Built once at vkEndCommandBuffer and only read afterwards, executions share it and keep their state in their own CpuContext
+		[[nodiscard]] inline const ExecutionPlan& GetExecutionPlan() const;
+		[[nodiscard]] inline std::size_t GetPoolIndex() const;
+		inline void SetPoolIndex(std::size_t index);
+
+	protected:
+		VkResult Compile() override;
+
+	private:
+		ExecutionPlan m_executionPlan;
+		std::size_t m_poolIndex = 0;
 	};
 } // namespace vkd::software
 
@@ -10,5 +10,18 @@
 
 namespace vkd::software
 {
+	inline const ExecutionPlan& CommandBuffer::GetExecutionPlan() const
+	{
+		return m_executionPlan;
+	}
 
-}
+	inline std::size_t CommandBuffer::GetPoolIndex() const
+	{
+		return m_poolIndex;
+	}
+
+	inline void CommandBuffer::SetPoolIndex(std::size_t index)
+	{
+		m_poolIndex = index;
+	}
+} // namespace vkd::software
@@ -0,0 +1,258 @@
+/**
+ * @file ExecutionPlan.cpp
+ * @brief Implementation of command buffer execution plan lowering
+ * @date 2026-10-16
+ */
+
+#include "VkdSoftware/CommandBuffer/ExecutionPlan.hpp"
+
+#include <algorithm>
+#include <array>
+
+#include "VkdSoftware/CommandDispatcher/CommandDispatcher.hpp"
+#include "VkdSoftware/DeviceMemory/DeviceMemory.hpp"
+
+namespace vkd::software
+{
+	namespace
+	{
+		UByte* ResolveAddress(const vkd::Buffer* buffer)
+		{
+			if (!buffer || !buffer->GetMemory())
+				return nullptr;
+			return static_cast<DeviceMemory*>(buffer->GetMemory())->Data() + buffer->GetMemoryOffset();
+		}
+
+		UByte* ResolveAddress(const vkd::Image* image)
+		{
+			if (!image || !image->GetMemory())
+				return nullptr;
+			return static_cast<DeviceMemory*>(image->GetMemory())->Data() + image->GetMemoryOffset();
+		}
+
+		template<typename T>
+		void ResolveAddresses(const T& /*op*/, ExecutionPlan::Step& /*step*/)
+		{
+		}
+
+		template<typename T>
+			requires requires(const T& op) { op.src; op.dst; }
+		void ResolveAddresses(const T& op, ExecutionPlan::Step& step)
+		{
+			step.Src = ResolveAddress(op.src);
+			step.Dst = ResolveAddress(op.dst);
+		}
+
+		void ResolveAddresses(const vkd::Buffer::OpFill& op, ExecutionPlan::Step& step)
+		{
+			step.Dst = ResolveAddress(op.dst);
+		}
+
+		void ResolveAddresses(const vkd::Buffer::OpUpdate& op, ExecutionPlan::Step& step)
+		{
+			step.Dst = ResolveAddress(op.dst);
+		}
+
+		void ResolveAddresses(const vkd::Image::OpClearColorImage& op, ExecutionPlan::Step& step)
+		{
+			step.Dst = ResolveAddress(op.image);
+		}
+
+		using Lowerer = void (*)(const void* op, ExecutionPlan::Step& step);
+
+		template<typename T>
+		void Lower(const void* op, ExecutionPlan::Step& step)
+		{
+			step.Execute = &CommandDispatcher::ExecuteStep<T>;
+			step.Op = op;
+			step.Type = vkd::CommandBuffer::OpType<T>;
+			ResolveAddresses(*static_cast<const T*>(op), step);
+		}
+
+		template<typename... Ts>
+		constexpr std::array<Lowerer, sizeof...(Ts)> MakeLowererTable(Nz::TypeList<Ts...>)
+		{
+			return {&Lower<Ts>...};
+		}
+
+		bool Conflicts(const OpAccessList& first, const OpAccessList& second)
+		{
+			for (UInt32 i = 0; i < first.Count; ++i)
+			{
+				for (UInt32 j = 0; j < second.Count; ++j)
+				{
+					const MemoryAccess& a = first.Accesses[i];
+					const MemoryAccess& b = second.Accesses[j];
+					if ((a.Write || b.Write) && a.Overlaps(b))
+						return true;
+				}
+			}
+			return false;
+		}
+
+		VkDeviceSize GetWrittenBytes(const OpAccessList& accesses)
+		{
+			VkDeviceSize bytes = 0;
+			for (UInt32 i = 0; i < accesses.Count; ++i)
+			{
+				if (accesses.Accesses[i].Write)
+					bytes += accesses.Accesses[i].Size;
+			}
+			return bytes;
+		}
+	} // namespace
+
+	void ExecutionPlan::Build(const CommandStream& stream)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		static constexpr auto lowerers = MakeLowererTable(vkd::CommandBuffer::AllOps{});
+
+		Clear();
+		m_steps.reserve(stream.GetCommandCount());
+		m_batches.reserve(stream.GetCommandCount());
+
+		for (const CommandHeader& command : stream)
+		{
+			CCT_ASSERT(command.Type < lowerers.size(), "Invalid command type {}", command.Type);
+
+			// Barriers only order groups, they leave nothing to execute
+			if (command.Type == vkd::CommandBuffer::OpType<OpPipelineBarrier>)
+			{
+				FlushGroup();
+				continue;
+			}
+
+			Step step = {nullptr, nullptr, 0, nullptr, nullptr};
+			lowerers[command.Type](command.GetPayload(), step);
+
+			if (command.Type == vkd::CommandBuffer::OpType<OpSetEvent>)
+			{
+				AddEventUpdate(step, static_cast<const OpSetEvent*>(step.Op)->EventObject, true);
+				continue;
+			}
+			if (command.Type == vkd::CommandBuffer::OpType<OpResetEvent>)
+			{
+				AddEventUpdate(step, static_cast<const OpResetEvent*>(step.Op)->EventObject, false);
+				continue;
+			}
+			if (command.Type == vkd::CommandBuffer::OpType<OpWaitEvents>)
+			{
+				AddEventWait(step, *static_cast<const OpWaitEvents*>(step.Op));
+				continue;
+			}
+
+			const OpAccessList accesses = GetOpAccesses(command);
+			m_hasOpaqueSteps |= accesses.Opaque;
+			if (accesses.Opaque || accesses.Count == 0)
+				AddSerial(step);
+			else
+				AddToGroup(step, accesses);
+		}
+
+		FlushGroup();
+	}
+
+	void ExecutionPlan::AddToGroup(const Step& step, const OpAccessList& accesses)
+	{
+		if (m_group.size() >= MaxGroupSteps)
+			FlushGroup();
+
+		UInt32 batch = m_groupFloor;
+		for (const GroupEntry& entry : m_group)
+		{
+			if (entry.Batch >= batch && Conflicts(entry.Accesses, accesses))
+				batch = entry.Batch + 1;
+		}
+
+		m_group.push_back(GroupEntry{step, accesses, batch});
+		m_groupBatchCount = std::max(m_groupBatchCount, batch + 1);
+	}
+
+	void ExecutionPlan::AddSerial(const Step& step)
+	{
+		// Draws and binds go through the shared context state, they run alone and in order
+		FlushGroup();
+		m_batches.push_back(Batch{static_cast<UInt32>(m_steps.size()), 1, 0});
+		m_steps.push_back(step);
+	}
+
+	void ExecutionPlan::AddEventUpdate(const Step& step, const vkd::Event* event, bool set)
+	{
+		if (m_group.size() >= MaxGroupSteps)
+			FlushGroup();
+
+		// After every op of the group, whatever it touches
+		const UInt32 batch = m_groupBatchCount;
+		m_group.push_back(GroupEntry{step, OpAccessList{}, batch});
+		m_groupBatchCount = batch + 1;
+
+		std::erase_if(m_eventSignals, [&](const EventSignal& signal) { return signal.Event == event; });
+		if (set)
+			m_eventSignals.push_back(EventSignal{event, batch});
+	}
+
+	void ExecutionPlan::AddEventWait(const Step& step, const OpWaitEvents& op)
+	{
+		UInt32 floor = m_groupFloor;
+		for (const vkd::Event* event : op.Events)
+		{
+			auto it = std::find_if(m_eventSignals.begin(), m_eventSignals.end(), [&](const EventSignal& signal) { return signal.Event == event; });
+			if (it == m_eventSignals.end())
+			{
+				// Only known at execution time, the execution may stop at the wait until the host sets it
+				m_hasOpaqueSteps = true;
+				AddSerial(step);
+				return;
+			}
+			floor = std::max(floor, it->Batch);
+		}
+
+		// Sharing the batch of the set is fine, the set itself has no effect on memory
+		m_groupFloor = floor;
+	}
+
+	void ExecutionPlan::FlushGroup()
+	{
+		if (m_group.empty())
+			return;
+
+		// Counting sort of the group entries by batch, keeping program order inside a batch
+		const std::size_t firstBatch = m_batches.size();
+		m_batches.resize(firstBatch + m_groupBatchCount, Batch{0, 0, 0});
+		for (const GroupEntry& entry : m_group)
+		{
+			Batch& batch = m_batches[firstBatch + entry.Batch];
+			++batch.StepCount;
+			batch.Cost += GetWrittenBytes(entry.Accesses);
+		}
+
+		for (std::size_t i = firstBatch; i < m_batches.size(); ++i)
+			m_cost += m_batches[i].Cost;
+
+		UInt32 firstStep = static_cast<UInt32>(m_steps.size());
+		for (std::size_t i = firstBatch; i < m_batches.size(); ++i)
+		{
+			m_batches[i].FirstStep = firstStep;
+			firstStep += m_batches[i].StepCount;
+		}
+
+		m_steps.resize(firstStep);
+		for (const GroupEntry& entry : m_group)
+		{
+			Batch& batch = m_batches[firstBatch + entry.Batch];
+			m_steps[batch.FirstStep++] = entry.PlannedStep;
+		}
+
+		for (std::size_t i = firstBatch; i < m_batches.size(); ++i)
+			m_batches[i].FirstStep -= m_batches[i].StepCount;
+
+		m_group.clear();
+		m_groupBatchCount = 0;
+		m_groupFloor = 0;
+
+		// Every later op lands after the flushed batches, the signals no longer constrain anything
+		for (EventSignal& signal : m_eventSignals)
+			signal.Batch = 0;
+	}
+} // namespace vkd::software
@@ -0,0 +1,114 @@
+/**
+ * @file ExecutionPlan.hpp
+ * @brief Pre-resolved execution plan of a sealed command buffer
+ * @date 2026-10-16
+ *
+ * Built once at vkEndCommandBuffer, each step points at its recorded op in the
+ * command stream, the handler executing it and the host addresses of the
+ * resources it touches, so replaying the command buffer neither copies nor allocates.
+ *
+ * Steps are grouped into batches of mutually independent transfer ops. Barriers,
+ * draws, binds and secondaries close the current group, inside a group an op lands
+ * in the first batch after every earlier op whose memory ranges it conflicts with.
+ *
+ * Events are split barriers and leave the group open: a set or reset lands after
+ * every op before it, a wait matching a set of the group only keeps the ops after
+ * it from landing before the set, so the ops recorded between the set and the wait
+ * still share batches with them. A wait with no matching set, i.e. on an event set
+ * by the host or by an earlier command buffer, becomes a batch of its own, the
+ * execution stops there until the event is set.
+ */
+
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "Vkd/CommandBuffer/CommandStream.hpp"
+#include "Vkd/CommandBuffer/OpAccess.hpp"
+
+namespace vkd
+{
+	class Event;
+	struct OpWaitEvents;
+} // namespace vkd
+
+namespace vkd::software
+{
+	class CommandDispatcher;
+
+	class ExecutionPlan
+	{
+	public:
+		struct Step
+		{
+			using Handler = VkResult (*)(CommandDispatcher& dispatcher, const Step& step);
+
+			Handler Execute;
+			const void* Op;
+			UInt32 Type; ///< CommandBuffer::OpType of the op
+			const UByte* Src; ///< Host address of the source resource, memory bind offset applied
+			UByte* Dst;		  ///< Host address of the destination resource, memory bind offset applied
+		};
+
+		/// Steps of a batch touch disjoint memory and may run in any order or concurrently
+		struct Batch
+		{
+			UInt32 FirstStep;
+			UInt32 StepCount;
+			VkDeviceSize Cost; ///< Bytes written by the batch, used to decide whether fanning out is worth it
+		};
+
+		/// Bounds the quadratic conflict search, a group reaching it is closed
+		static constexpr std::size_t MaxGroupSteps = 1024;
+
+		ExecutionPlan() = default;
+		~ExecutionPlan() = default;
+
+		/// Lowers the stream into steps, the storage of a previous build is reused
+		void Build(const CommandStream& stream);
+		inline void Clear();
+
+		[[nodiscard]] inline std::span<const Step> GetSteps() const;
+		[[nodiscard]] inline std::span<const Batch> GetBatches() const;
+		[[nodiscard]] inline std::span<const Step> GetBatchSteps(const Batch& batch) const;
+		[[nodiscard]] inline bool IsEmpty() const;
+		/// Bytes written by all the transfer ops
+		[[nodiscard]] inline VkDeviceSize GetCost() const;
+		/// Whether a step depends on state outside the plan (draws, secondaries), its cost is then unknown
+		[[nodiscard]] inline bool HasOpaqueSteps() const;
+
+	private:
+		struct GroupEntry
+		{
+			Step PlannedStep;
+			OpAccessList Accesses;
+			UInt32 Batch;
+		};
+
+		/// Last set of an event recorded so far, Batch is relative to the current group
+		struct EventSignal
+		{
+			const vkd::Event* Event;
+			UInt32 Batch;
+		};
+
+		void AddToGroup(const Step& step, const OpAccessList& accesses);
+		void AddSerial(const Step& step);
+		void AddEventUpdate(const Step& step, const vkd::Event* event, bool set);
+		void AddEventWait(const Step& step, const OpWaitEvents& op);
+		void FlushGroup();
+
+		std::vector<Step> m_steps;
+		std::vector<Batch> m_batches;
+		std::vector<GroupEntry> m_group;
+		std::vector<EventSignal> m_eventSignals;
+		UInt32 m_groupBatchCount = 0;
+		/// First batch the next op of the group may land in, raised by event waits
+		UInt32 m_groupFloor = 0;
+		VkDeviceSize m_cost = 0;
+		bool m_hasOpaqueSteps = false;
+	};
+} // namespace vkd::software
+
+#include "VkdSoftware/CommandBuffer/ExecutionPlan.inl"
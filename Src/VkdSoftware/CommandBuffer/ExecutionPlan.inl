@@ -0,0 +1,54 @@
+/**
+ * @file ExecutionPlan.inl
+ * @brief Inline implementations for execution plan
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include "VkdSoftware/CommandBuffer/ExecutionPlan.hpp"
+
+namespace vkd::software
+{
+	inline void ExecutionPlan::Clear()
+	{
+		m_steps.clear();
+		m_batches.clear();
+		m_group.clear();
+		m_eventSignals.clear();
+		m_groupBatchCount = 0;
+		m_groupFloor = 0;
+		m_cost = 0;
+		m_hasOpaqueSteps = false;
+	}
+
+	inline std::span<const ExecutionPlan::Step> ExecutionPlan::GetSteps() const
+	{
+		return m_steps;
+	}
+
+	inline std::span<const ExecutionPlan::Batch> ExecutionPlan::GetBatches() const
+	{
+		return m_batches;
+	}
+
+	inline std::span<const ExecutionPlan::Step> ExecutionPlan::GetBatchSteps(const Batch& batch) const
+	{
+		return std::span<const Step>(m_steps).subspan(batch.FirstStep, batch.StepCount);
+	}
+
+	inline bool ExecutionPlan::IsEmpty() const
+	{
+		return m_steps.empty();
+	}
+
+	inline VkDeviceSize ExecutionPlan::GetCost() const
+	{
+		return m_cost;
+	}
+
+	inline bool ExecutionPlan::HasOpaqueSteps() const
+	{
+		return m_hasOpaqueSteps;
+	}
+} // namespace vkd::software
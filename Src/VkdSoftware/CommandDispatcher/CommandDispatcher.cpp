@@ -6,21 +6,63 @@
 
 #include "VkdSoftware/CommandDispatcher/CommandDispatcher.hpp"
 
+#include <atomic>
+
+#include "Vkd/Synchronization/Event/Event.hpp"
+
 namespace vkd::software
 {
-	VkResult CommandDispatcher::Execute(const vkd::CommandBuffer& cb)
+	VkResult CommandDispatcher::Execute(const CommandBuffer& cb)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
 		if (!cb.IsSealed())
 			return VK_ERROR_VALIDATION_FAILED_EXT;
 
-		const auto& ops = cb.GetOps();
-		for (const auto& op : ops)
+		if (m_depth >= ResumePoint::MaxDepth)
 		{
-			VkResult result = std::visit([this]<typename T>(T operation)
-										 { return (*this)(std::move(operation)); }, op);
+			CCT_ASSERT_FALSE("Secondary command buffer executing further secondaries");
+			return VK_ERROR_VALIDATION_FAILED_EXT;
+		}
+
+		// A resumed level picks up at the batch it stopped in, the innermost one ends the resumption
+		const UInt32 level = m_depth;
+		UInt32 firstBatch = 0;
+		if (m_resumePoint && level < m_resumePoint->Depth)
+		{
+			firstBatch = m_resumePoint->Frames[level].Batch;
+			if (level + 1 == m_resumePoint->Depth)
+				m_resumePoint->Depth = 0;
+		}
 
+		const std::span<const ExecutionPlan::Batch> batches = cb.GetExecutionPlan().GetBatches();
+		VkResult result = VK_SUCCESS;
+		++m_depth;
+		for (UInt32 i = firstBatch; i < batches.size(); ++i)
+		{
+			const ExecutionPlan::Batch& batch = batches[i];
+			const std::span<const ExecutionPlan::Step> steps = cb.GetExecutionPlan().GetBatchSteps(batch);
+			const bool parallel = m_tasks && batch.StepCount > 1 && batch.Cost >= ParallelBatchMinCost;
+
+			// Waits and secondaries are batches of their own, only a serial batch stops
+			result = parallel ? ExecuteParallel(steps) : ExecuteSerial(steps);
+			if (result != VK_SUCCESS)
+			{
+				if (result == VK_NOT_READY && m_resumePoint)
+					m_resumePoint->Frames[level].Batch = i;
+				break;
+			}
+		}
+		--m_depth;
+
+		return result;
+	}
+
+	VkResult CommandDispatcher::ExecuteSerial(std::span<const ExecutionPlan::Step> steps)
+	{
+		for (const ExecutionPlan::Step& step : steps)
+		{
+			VkResult result = step.Execute(*this, step);
 			if (result != VK_SUCCESS)
 				return result;
 		}
@@ -28,76 +70,162 @@ namespace vkd::software
 		return VK_SUCCESS;
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::Buffer::OpFill op)
+	VkResult CommandDispatcher::ExecuteParallel(std::span<const ExecutionPlan::Step> steps)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		// Steps of a batch do not conflict, each is a chunk of its own. The calling thread
+		// executes steps too, and may be a pool worker when commands fan out further
+		std::atomic<VkResult> batchResult = VK_SUCCESS;
+		m_tasks->ParallelFor(0, steps.size(), 1, [this, steps, &batchResult](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const ExecutionPlan::Step& step = steps[i];
+				VkResult result = step.Execute(*this, step);
+				if (result != VK_SUCCESS)
+				{
+					VkResult expected = VK_SUCCESS;
+					batchResult.compare_exchange_strong(expected, result, std::memory_order_relaxed);
+				}
+			}
+		}, m_priority);
+
+		return batchResult.load(std::memory_order_relaxed);
+	}
+
+	VkResult CommandDispatcher::operator()(const vkd::Buffer::OpFill& op, const ExecutionPlan::Step& step)
 	{
-		return m_context->FillBuffer(std::move(op));
+		return m_context->FillBuffer(op, step.Dst);
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::Buffer::OpCopy op)
+	VkResult CommandDispatcher::operator()(const vkd::Buffer::OpCopy& op, const ExecutionPlan::Step& step)
 	{
-		return m_context->CopyBuffer(std::move(op));
+		return m_context->CopyBuffer(op, step.Src, step.Dst);
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::Buffer::OpCopy2 op)
+	VkResult CommandDispatcher::operator()(const vkd::Buffer::OpCopy2& op, const ExecutionPlan::Step& step)
 	{
-		return m_context->CopyBuffer2(std::move(op));
+		return m_context->CopyBuffer2(op, step.Src, step.Dst);
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::Buffer::OpUpdate op)
+	VkResult CommandDispatcher::operator()(const vkd::Buffer::OpUpdate& op, const ExecutionPlan::Step& step)
 	{
-		return m_context->UpdateBuffer(std::move(op));
+		return m_context->UpdateBuffer(op, step.Dst);
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::Buffer::OpCopyBufferToImage op)
+	VkResult CommandDispatcher::operator()(const vkd::Buffer::OpCopyBufferToImage& op, const ExecutionPlan::Step& step)
 	{
-		return m_context->CopyBufferToImage(std::move(op));
+		return m_context->CopyBufferToImage(op, step.Src, step.Dst);
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::Buffer::OpCopyImageToBuffer op)
+	VkResult CommandDispatcher::operator()(const vkd::Buffer::OpCopyImageToBuffer& op, const ExecutionPlan::Step& step)
 	{
-		return m_context->CopyImageToBuffer(std::move(op));
+		return m_context->CopyImageToBuffer(op, step.Src, step.Dst);
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::Image::OpCopy op)
+	VkResult CommandDispatcher::operator()(const vkd::Image::OpCopy& op, const ExecutionPlan::Step& step)
 	{
-		return m_context->CopyImage(std::move(op));
+		return m_context->CopyImage(op, step.Src, step.Dst);
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::Image::OpClearColorImage op)
+	VkResult CommandDispatcher::operator()(const vkd::Image::OpClearColorImage& op, const ExecutionPlan::Step& step)
 	{
-		return m_context->ClearColorImage(std::move(op));
+		return m_context->ClearColorImage(op, step.Dst);
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::OpBindVertexBuffer op)
+	VkResult CommandDispatcher::operator()(const vkd::OpBindVertexBuffer& op, const ExecutionPlan::Step& /*step*/)
 	{
-		return m_context->BindVertexBuffer(std::move(op));
+		return m_context->BindVertexBuffer(op);
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::OpDraw op)
+	VkResult CommandDispatcher::operator()(const vkd::OpDraw& op, const ExecutionPlan::Step& /*step*/)
 	{
-		return m_context->Draw(std::move(op));
+		return m_context->Draw(op);
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::OpDrawIndexed op)
+	VkResult CommandDispatcher::operator()(const vkd::OpDrawIndexed& op, const ExecutionPlan::Step& /*step*/)
 	{
 		// TODO: Implement DrawIndexed in CpuContext
 		return VK_SUCCESS;
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::OpDrawIndirect op)
+	VkResult CommandDispatcher::operator()(const vkd::OpDrawIndirect& op, const ExecutionPlan::Step& /*step*/)
 	{
 		// TODO: Implement DrawIndirect in CpuContext
 		return VK_SUCCESS;
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::OpDrawIndexedIndirect op)
+	VkResult CommandDispatcher::operator()(const vkd::OpDrawIndexedIndirect& op, const ExecutionPlan::Step& /*step*/)
 	{
 		// TODO: Implement DrawIndexedIndirect in CpuContext
 		return VK_SUCCESS;
 	}
 
-	VkResult CommandDispatcher::operator()(vkd::OpBindPipeline op)
+	VkResult CommandDispatcher::operator()(const vkd::OpBindPipeline& op, const ExecutionPlan::Step& /*step*/)
+	{
+		return m_context->BindPipeline(op);
+	}
+
+	VkResult CommandDispatcher::operator()(const vkd::OpExecuteCommands& op, const ExecutionPlan::Step& /*step*/)
+	{
+		// The level of this op is m_depth - 1, a deeper level left to resume is one of its secondaries
+		const UInt32 level = m_depth - 1;
+		const bool resuming = m_resumePoint && m_depth < m_resumePoint->Depth;
+
+		for (std::size_t i = resuming ? m_resumePoint->Frames[level].Secondary : 0; i < op.CommandBuffers.size(); ++i)
+		{
+			// Pipeline and vertex bindings are not inherited by secondaries, only the render pass
+			// state described by their inheritance info carries over, so only bindings are cleared.
+			// A resumed secondary keeps the bindings it made before stopping.
+			if (!resuming || i != m_resumePoint->Frames[level].Secondary)
+				m_context->Reset();
+
+			VkResult result = Execute(*static_cast<const CommandBuffer*>(op.CommandBuffers[i]));
+			if (result != VK_SUCCESS)
+			{
+				if (result == VK_NOT_READY && m_resumePoint)
+					m_resumePoint->Frames[level].Secondary = static_cast<UInt32>(i);
+				return result;
+			}
+		}
+
+		return VK_SUCCESS;
+	}
+
+	VkResult CommandDispatcher::operator()(const vkd::OpPipelineBarrier& /*op*/, const ExecutionPlan::Step& /*step*/)
 	{
-		return m_context->BindPipeline(std::move(op));
+		// Barriers are resolved into batch boundaries when the execution plan is built
+		return VK_SUCCESS;
+	}
+
+	VkResult CommandDispatcher::operator()(const vkd::OpSetEvent& op, const ExecutionPlan::Step& /*step*/)
+	{
+		return op.EventObject->Set();
+	}
+
+	VkResult CommandDispatcher::operator()(const vkd::OpResetEvent& op, const ExecutionPlan::Step& /*step*/)
+	{
+		return op.EventObject->Reset();
+	}
+
+	VkResult CommandDispatcher::operator()(const vkd::OpWaitEvents& op, const ExecutionPlan::Step& /*step*/)
+	{
+		// Only planned for waits whose set is not part of the command buffer, the others are batch boundaries.
+		// The set comes from the host or another queue, the caller resumes once it happened
+		for (vkd::Event* event : op.Events)
+		{
+			if (event->GetStatus() == VK_EVENT_SET)
+				continue;
+
+			if (m_resumePoint)
+			{
+				m_resumePoint->Depth = m_depth;
+				m_resumePoint->Event = event;
+			}
+			return VK_NOT_READY;
+		}
+
+		return VK_SUCCESS;
 	}
 } // namespace vkd::software
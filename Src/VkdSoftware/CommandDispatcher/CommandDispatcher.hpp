@@ -3,43 +3,95 @@
  * @brief Command dispatcher for CPU-based rendering
  * @date 2025-10-27
  *
- * Executes recorded command buffer operations on the CPU.
+ * Executes recorded command buffer operations on the CPU. Batches of independent
+ * transfer ops large enough to amortize the hand-off are spread over the workers
+ * of the device's task tenant, the executing thread taking its share of the work. The
+ * pieces are queued with the priority of the queue being executed.
+ *
+ * A wait on an event that is not set yet, by the host or another queue, stops the
+ * execution instead of blocking the thread: Execute returns VK_NOT_READY and the
+ * resume point records the batch each level of secondaries stopped in. Executing
+ * the same command buffer again with that resume point continues from the wait.
  */
 
 #pragma once
 
+#include <array>
+
 #include "Vkd/Buffer/Buffer.hpp"
 #include "Vkd/Image/Image.hpp"
 #include "VkdSoftware/CommandBuffer/CommandBuffer.hpp"
+#include "VkdSoftware/CommandBuffer/ExecutionPlan.hpp"
 #include "VkdSoftware/CpuContext/CpuContext.hpp"
+#include "VkdUtils/TaskTenant/TaskTenant.hpp"
 
 namespace vkd::software
 {
 	class CommandDispatcher
 	{
 	public:
-		explicit CommandDispatcher(CpuContext& ctx);
+		/// Batches writing fewer bytes than this run on the calling thread
+		static constexpr VkDeviceSize ParallelBatchMinCost = 256 * 1024;
+
+		/// Where an execution stopped at an event wait, kept by the caller until it executes again
+		struct ResumePoint
+		{
+			/// A primary and the secondaries it executes, which cannot execute further ones
+			static constexpr std::size_t MaxDepth = 2;
+
+			struct Frame
+			{
+				UInt32 Batch;
+				UInt32 Secondary; ///< Index in the ExecuteCommands op the batch holds, if any
+			};
+
+			std::array<Frame, MaxDepth> Frames = {};
+			UInt32 Depth = 0; ///< Levels to resume, zero when nothing is suspended
+			vkd::Event* Event = nullptr; ///< First event of the wait found not set
+
+			[[nodiscard]] inline bool IsSuspended() const;
+		};
+
+		explicit CommandDispatcher(CpuContext& ctx, TaskTenant* tasks = nullptr, ThreadPool::Priority priority = ThreadPool::Priority::Normal, ResumePoint* resumePoint = nullptr);
 		~CommandDispatcher() = default;
 
-		VkResult Execute(const vkd::CommandBuffer& cb);
+		/// @return VK_NOT_READY when stopped at a wait on an event not set, resumable when a resume point was given
+		VkResult Execute(const CommandBuffer& cb);
+
+		/// Execution plan handler of op type T
+		template<typename T>
+		static VkResult ExecuteStep(CommandDispatcher& dispatcher, const ExecutionPlan::Step& step);
 
 	private:
-		VkResult operator()(vkd::Buffer::OpFill op);
-		VkResult operator()(vkd::Buffer::OpCopy op);
-		VkResult operator()(vkd::Buffer::OpCopy2 op);
-		VkResult operator()(vkd::Buffer::OpUpdate op);
-		VkResult operator()(vkd::Buffer::OpCopyBufferToImage op);
-		VkResult operator()(vkd::Buffer::OpCopyImageToBuffer op);
-		VkResult operator()(vkd::Image::OpCopy op);
-		VkResult operator()(vkd::Image::OpClearColorImage op);
-		VkResult operator()(vkd::OpBindVertexBuffer op);
-		VkResult operator()(vkd::OpDraw op);
-		VkResult operator()(vkd::OpDrawIndexed op);
-		VkResult operator()(vkd::OpDrawIndirect op);
-		VkResult operator()(vkd::OpDrawIndexedIndirect op);
-		VkResult operator()(vkd::OpBindPipeline op);
+		VkResult ExecuteSerial(std::span<const ExecutionPlan::Step> steps);
+		VkResult ExecuteParallel(std::span<const ExecutionPlan::Step> steps);
+
+		VkResult operator()(const vkd::Buffer::OpFill& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::Buffer::OpCopy& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::Buffer::OpCopy2& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::Buffer::OpUpdate& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::Buffer::OpCopyBufferToImage& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::Buffer::OpCopyImageToBuffer& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::Image::OpCopy& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::Image::OpClearColorImage& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::OpBindVertexBuffer& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::OpDraw& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::OpDrawIndexed& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::OpDrawIndirect& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::OpDrawIndexedIndirect& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::OpBindPipeline& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::OpExecuteCommands& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::OpPipelineBarrier& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::OpSetEvent& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::OpResetEvent& op, const ExecutionPlan::Step& step);
+		VkResult operator()(const vkd::OpWaitEvents& op, const ExecutionPlan::Step& step);
 
 		CpuContext* m_context;
+		TaskTenant* m_tasks;
+		ThreadPool::Priority m_priority;
+		ResumePoint* m_resumePoint;
+		/// Levels of command buffers being executed, the primary included
+		UInt32 m_depth;
 	};
 } // namespace vkd::software
 
@@ -10,8 +10,23 @@
 
 namespace vkd::software
 {
-	inline CommandDispatcher::CommandDispatcher(CpuContext& ctx) :
-		m_context(&ctx)
+	inline bool CommandDispatcher::ResumePoint::IsSuspended() const
 	{
+		return Depth != 0;
+	}
+
+	inline CommandDispatcher::CommandDispatcher(CpuContext& ctx, TaskTenant* tasks, ThreadPool::Priority priority, ResumePoint* resumePoint) :
+		m_context(&ctx),
+		m_tasks(tasks),
+		m_priority(priority),
+		m_resumePoint(resumePoint),
+		m_depth(0)
+	{
+	}
+
+	template<typename T>
+	VkResult CommandDispatcher::ExecuteStep(CommandDispatcher& dispatcher, const ExecutionPlan::Step& step)
+	{
+		return dispatcher(*static_cast<const T*>(step.Op), step);
 	}
 } // namespace vkd::software
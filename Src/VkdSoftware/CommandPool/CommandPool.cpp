@@ -11,18 +11,54 @@
 
 namespace vkd::software
 {
+	CommandPool::~CommandPool()
+	{
+		// Destroying a pool frees every command buffer allocated from it
+		while (!m_commandBuffers.empty())
+			DestroyCommandBuffer(m_commandBuffers.back());
+	}
+
 	VkResult CommandPool::Create(Device& owner, const VkCommandPoolCreateInfo& createInfo, const VkAllocationCallbacks& pAllocator)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		return vkd::CommandPool::Create(owner, createInfo, pAllocator);
+		VkResult result = vkd::CommandPool::Create(owner, createInfo, pAllocator);
+		if (result != VK_SUCCESS)
+			return result;
+
+		// Transient pools churn through short-lived command buffers, keep more of them (and all of their blocks) around
+		if (createInfo.flags & VK_COMMAND_POOL_CREATE_TRANSIENT_BIT)
+		{
+			m_maxCachedCommandBuffers = MaxCachedTransientCommandBuffers;
+			GetCommandArena().SetMaxCachedBlocks(CommandArena::UnlimitedCachedBlocks);
+		}
+		else
+		{
+			m_maxCachedCommandBuffers = MaxCachedCommandBuffers;
+			GetCommandArena().SetMaxCachedBlocks(MaxCachedBlocks);
+		}
+		m_freeCommandBuffers.reserve(m_maxCachedCommandBuffers);
+
+		return VK_SUCCESS;
 	}
 
 	VkResult CommandPool::Reset(VkCommandPoolResetFlags flags)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		// TODO: implement CPU execution - reset all command buffers in pool
+		// Every block goes back to the cache at once, command buffers notice the new arena
+		// generation and return to the initial state the next time they are used.
+		GetCommandArena().ReclaimAll();
+
+		if (flags & VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT)
+		{
+			GetCommandArena().Trim();
+
+			for (auto* commandBuffer : m_freeCommandBuffers)
+				DestroyCommandBuffer(commandBuffer);
+			m_freeCommandBuffers.clear();
+		}
+
 		return VK_SUCCESS;
 	}
 
@@ -30,6 +66,13 @@ namespace vkd::software
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
+		if (!m_freeCommandBuffers.empty())
+		{
+			auto* buffer = m_freeCommandBuffers.back();
+			m_freeCommandBuffers.pop_back();
+			return buffer;
+		}
+
 		auto* buffer = mem::NewDispatchable<CommandBuffer>(GetAllocationCallbacks(), VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
 		if (!buffer)
 		{
@@ -37,6 +80,38 @@ namespace vkd::software
 			return VK_ERROR_OUT_OF_HOST_MEMORY;
 		}
 
-		return reinterpret_cast<DispatchableObject<vkd::CommandBuffer>*>(buffer);
+		buffer->Object->SetPoolIndex(m_commandBuffers.size());
+		m_commandBuffers.push_back(reinterpret_cast<DispatchableObject<vkd::CommandBuffer>*>(buffer));
+
+		return m_commandBuffers.back();
+	}
+
+	void CommandPool::FreeCommandBuffer(DispatchableObject<vkd::CommandBuffer>* commandBuffer)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+		VKD_CHECK(commandBuffer);
+
+		commandBuffer->Object->ReleaseCommands();
+
+		if (m_freeCommandBuffers.size() < m_maxCachedCommandBuffers)
+		{
+			m_freeCommandBuffers.push_back(commandBuffer);
+			return;
+		}
+
+		DestroyCommandBuffer(commandBuffer);
+	}
+
+	void CommandPool::DestroyCommandBuffer(DispatchableObject<vkd::CommandBuffer>* commandBuffer)
+	{
+		auto* softwareBuffer = static_cast<CommandBuffer*>(commandBuffer->Object);
+		const std::size_t index = softwareBuffer->GetPoolIndex();
+		CCT_ASSERT(index < m_commandBuffers.size() && m_commandBuffers[index] == commandBuffer, "Command buffer does not belong to this pool");
+
+		m_commandBuffers[index] = m_commandBuffers.back();
+		static_cast<CommandBuffer*>(m_commandBuffers[index]->Object)->SetPoolIndex(index);
+		m_commandBuffers.pop_back();
+
+		mem::DeleteDispatchable(commandBuffer);
 	}
 } // namespace vkd::software
@@ -4,10 +4,14 @@
  * @date 2025-10-25
  *
  * Command pool implementation for CPU-based command buffer allocation.
+ * Freed command buffers and their recording blocks are kept for reuse so steady
+ * state allocate / record / reset cycles do not reach the allocator.
  */
 
 #pragma once
 
+#include <vector>
+
 #include "Vkd/CommandPool/CommandPool.hpp"
 
 namespace vkd::software
@@ -15,16 +19,26 @@ namespace vkd::software
 	class CommandPool : public vkd::CommandPool
 	{
 	public:
+		static constexpr std::size_t MaxCachedCommandBuffers = 16;
+		static constexpr std::size_t MaxCachedTransientCommandBuffers = 64;
+		static constexpr std::size_t MaxCachedBlocks = 64;
+
 		CommandPool() = default;
-		~CommandPool() override = default;
+		~CommandPool() override;
 
 		VkResult Create(Device& owner, const VkCommandPoolCreateInfo& createInfo, const VkAllocationCallbacks& pAllocator) override;
 
+		void FreeCommandBuffer(DispatchableObject<vkd::CommandBuffer>* commandBuffer) override;
+
 	protected:
 		VkResult Reset(VkCommandPoolResetFlags flags) override;
 		DispatchableObjectResult<vkd::CommandBuffer> CreateCommandBuffer(VkCommandBufferLevel level) override;
 
 	private:
-		// TODO: implement CPU command buffer pool management
+		void DestroyCommandBuffer(DispatchableObject<vkd::CommandBuffer>* commandBuffer);
+
+		std::vector<DispatchableObject<vkd::CommandBuffer>*> m_commandBuffers; ///< Every command buffer owned by the pool, allocated or cached
+		std::vector<DispatchableObject<vkd::CommandBuffer>*> m_freeCommandBuffers;
+		std::size_t m_maxCachedCommandBuffers = MaxCachedCommandBuffers;
 	};
 } // namespace vkd::software
@@ -8,6 +8,8 @@
 
 #include "Vkd/DeviceMemory/DeviceMemory.hpp"
 
+#include <algorithm>
+
 #include <vulkan/utility/vk_format_utils.h>
 
 namespace vkd::software
@@ -16,7 +18,7 @@ namespace vkd::software
 	{
 	}
 
-	VkResult CpuContext::BindPipeline(OpBindPipeline op)
+	VkResult CpuContext::BindPipeline(const OpBindPipeline& op)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
@@ -27,7 +29,7 @@ namespace vkd::software
 		return VK_SUCCESS;
 	}
 
-	VkResult CpuContext::BindVertexBuffer(OpBindVertexBuffer op)
+	VkResult CpuContext::BindVertexBuffer(const OpBindVertexBuffer& op)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
@@ -36,11 +38,8 @@ namespace vkd::software
 		CCT_ASSERT(op.Buffers.size() == op.Offsets.size(), "Buffers and offsets size mismatch");
 
 		const UInt32 maxBinding = op.FirstBinding + static_cast<UInt32>(op.Buffers.size());
-		if (maxBinding > m_boundVertexBuffers.size())
-		{
-			m_boundVertexBuffers.resize(maxBinding, nullptr);
-			m_vertexBufferOffsets.resize(maxBinding, 0);
-		}
+		CCT_ASSERT(maxBinding <= MaxVertexInputBindings, "Vertex binding out of range");
+		m_boundVertexBufferCount = std::max(m_boundVertexBufferCount, maxBinding);
 
 		for (size_t i = 0; i < op.Buffers.size(); ++i)
 		{
@@ -52,116 +51,76 @@ namespace vkd::software
 		return VK_SUCCESS;
 	}
 
-	VkResult CpuContext::Draw(vkd::OpDraw op)
+	VkResult CpuContext::Draw(const vkd::OpDraw& op)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
 		return VK_SUCCESS;
 	}
 
-	VkResult CpuContext::CopyBuffer(vkd::Buffer::OpCopy op)
+	VkResult CpuContext::CopyBuffer(const vkd::Buffer::OpCopy& op, const UByte* src, UByte* dst)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		for (auto& region : op.regions)
-		{
-			CCT_ASSERT(op.src && op.src->GetMemory(), "Invalid pointer");
-			CCT_ASSERT(op.dst && op.dst->GetMemory(), "Invalid pointer");
-
-			cct::UByte* srcData = nullptr;
-			op.src->GetMemory()->Map(region.srcOffset, region.size, reinterpret_cast<void**>(&srcData));
+		CCT_ASSERT(src && dst, "Invalid pointer");
 
-			cct::UByte* dstData = nullptr;
-			op.dst->GetMemory()->Map(region.dstOffset, region.size, reinterpret_cast<void**>(&dstData));
-
-			std::memcpy(dstData, srcData, region.size);
-
-			op.dst->GetMemory()->Unmap();
-			op.src->GetMemory()->Unmap();
-		}
+		for (const VkBufferCopy& region : op.regions)
+			std::memcpy(dst + region.dstOffset, src + region.srcOffset, region.size);
 
 		return VK_SUCCESS;
 	}
 
-	VkResult CpuContext::CopyBuffer2(vkd::Buffer::OpCopy2 op)
+	VkResult CpuContext::CopyBuffer2(const vkd::Buffer::OpCopy2& op, const UByte* src, UByte* dst)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		for (auto& region : op.regions)
-		{
-			CCT_ASSERT(op.src && op.src->GetMemory(), "Invalid pointer");
-			CCT_ASSERT(op.dst && op.dst->GetMemory(), "Invalid pointer");
-
-			cct::UByte* srcData = nullptr;
-			op.src->GetMemory()->Map(region.srcOffset, region.size, reinterpret_cast<void**>(&srcData));
+		CCT_ASSERT(src && dst, "Invalid pointer");
 
-			cct::UByte* dstData = nullptr;
-			op.dst->GetMemory()->Map(region.dstOffset, region.size, reinterpret_cast<void**>(&dstData));
-
-			std::memcpy(dstData, srcData, region.size);
-
-			op.dst->GetMemory()->Unmap();
-			op.src->GetMemory()->Unmap();
-		}
+		for (const VkBufferCopy2& region : op.regions)
+			std::memcpy(dst + region.dstOffset, src + region.srcOffset, region.size);
 
 		return VK_SUCCESS;
 	}
 
-	VkResult CpuContext::UpdateBuffer(vkd::Buffer::OpUpdate op)
+	VkResult CpuContext::UpdateBuffer(const vkd::Buffer::OpUpdate& op, UByte* dst)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		CCT_ASSERT(op.dst && op.dst->GetMemory(), "Invalid pointer");
-
-		cct::UByte* dstData = nullptr;
-		op.dst->GetMemory()->Map(op.offset, op.data.size(), reinterpret_cast<void**>(&dstData));
-
-		std::memcpy(dstData, op.data.data(), op.data.size());
+		CCT_ASSERT(dst, "Invalid pointer");
 
-		op.dst->GetMemory()->Unmap();
+		std::memcpy(dst + op.offset, op.data.data(), op.data.size());
 
 		return VK_SUCCESS;
 	}
 
-	VkResult CpuContext::FillBuffer(vkd::Buffer::OpFill op)
+	VkResult CpuContext::FillBuffer(const vkd::Buffer::OpFill& op, UByte* dst)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		cct::UByte* data = nullptr;
-		op.dst->GetMemory()->Map(op.offset, op.size, reinterpret_cast<void**>(&data));
+		CCT_ASSERT(dst, "Invalid pointer");
 
-		UInt32* data32 = reinterpret_cast<UInt32*>(data);
-		size_t count = op.size / sizeof(UInt32);
+		const VkDeviceSize size = op.size == VK_WHOLE_SIZE ? op.dst->GetSize() - op.offset : op.size;
+
+		UInt32* data32 = reinterpret_cast<UInt32*>(dst + op.offset);
+		size_t count = size / sizeof(UInt32);
 		for (size_t i = 0; i < count; ++i)
 			data32[i] = op.data;
 
-		op.dst->GetMemory()->Unmap();
-
 		return VK_SUCCESS;
 	}
 
-	VkResult CpuContext::CopyImage(vkd::Image::OpCopy op)
+	VkResult CpuContext::CopyImage(const vkd::Image::OpCopy& op, const UByte* src, UByte* dst)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		for (auto& region : op.regions)
-		{
-			CCT_ASSERT(op.src && op.src->GetMemory(), "Invalid pointer");
-			CCT_ASSERT(op.dst && op.dst->GetMemory(), "Invalid pointer");
-
-			VkDeviceSize pixelSize = vkuFormatElementSize(op.src->GetFormat());
-			VkDeviceSize srcRowPitch = op.src->GetExtent().width * pixelSize;
-			VkDeviceSize dstRowPitch = op.dst->GetExtent().width * pixelSize;
+		CCT_ASSERT(src && dst, "Invalid pointer");
 
-			VkDeviceSize srcImageSize = srcRowPitch * op.src->GetExtent().height * op.src->GetExtent().depth;
-			VkDeviceSize dstImageSize = dstRowPitch * op.dst->GetExtent().height * op.dst->GetExtent().depth;
-
-			cct::UByte* srcBase = nullptr;
-			op.src->GetMemory()->Map(0, srcImageSize, reinterpret_cast<void**>(&srcBase));
-
-			cct::UByte* dstBase = nullptr;
-			op.dst->GetMemory()->Map(0, dstImageSize, reinterpret_cast<void**>(&dstBase));
+		VkDeviceSize pixelSize = vkuFormatElementSize(op.src->GetFormat());
+		VkDeviceSize srcRowPitch = op.src->GetExtent().width * pixelSize;
+		VkDeviceSize dstRowPitch = op.dst->GetExtent().width * pixelSize;
 
+		for (const VkImageCopy& region : op.regions)
+		{
 			VkDeviceSize rowSize = region.extent.width * pixelSize;
 			for (UInt32 z = 0; z < region.extent.depth; ++z)
 			{
@@ -176,40 +135,27 @@ namespace vkd::software
 											  (region.dstOffset.y + y)) *
 												 dstRowPitch +
 											 region.dstOffset.x * pixelSize;
-					std::memcpy(dstBase + dstOffset, srcBase + srcOffset, rowSize);
+					std::memcpy(dst + dstOffset, src + srcOffset, rowSize);
 				}
 			}
-
-			op.dst->GetMemory()->Unmap();
-			op.src->GetMemory()->Unmap();
 		}
 
 		return VK_SUCCESS;
 	}
 
-	VkResult CpuContext::CopyBufferToImage(vkd::Buffer::OpCopyBufferToImage op)
+	VkResult CpuContext::CopyBufferToImage(const vkd::Buffer::OpCopyBufferToImage& op, const UByte* src, UByte* dst)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		for (auto& region : op.regions)
-		{
-			CCT_ASSERT(op.src && op.src->GetMemory(), "Invalid pointer");
-			CCT_ASSERT(op.dst && op.dst->GetMemory(), "Invalid pointer");
+		CCT_ASSERT(src && dst, "Invalid pointer");
 
-			VkDeviceSize pixelSize = vkuFormatElementSize(op.dst->GetFormat());
-			VkDeviceSize imageRowPitch = op.dst->GetExtent().width * pixelSize;
-			VkDeviceSize imageSize = imageRowPitch * op.dst->GetExtent().height * op.dst->GetExtent().depth;
+		VkDeviceSize pixelSize = vkuFormatElementSize(op.dst->GetFormat());
+		VkDeviceSize imageRowPitch = op.dst->GetExtent().width * pixelSize;
 
+		for (const VkBufferImageCopy& region : op.regions)
+		{
 			UInt32 bufferRowLength = region.bufferRowLength ? region.bufferRowLength : region.imageExtent.width;
-			VkDeviceSize bufferRowPitch = bufferRowLength * pixelSize;
-
-			cct::UByte* srcBase = nullptr;
-			op.src->GetMemory()->Map(region.bufferOffset,
-									 bufferRowPitch * region.imageExtent.height * region.imageExtent.depth,
-									 reinterpret_cast<void**>(&srcBase));
-
-			cct::UByte* dstBase = nullptr;
-			op.dst->GetMemory()->Map(0, imageSize, reinterpret_cast<void**>(&dstBase));
+			const UByte* srcBase = src + region.bufferOffset;
 
 			VkDeviceSize rowSize = region.imageExtent.width * pixelSize;
 			for (UInt32 z = 0; z < region.imageExtent.depth; ++z)
@@ -223,40 +169,27 @@ namespace vkd::software
 												 imageRowPitch +
 											 region.imageOffset.x * pixelSize;
 
-					std::memcpy(dstBase + dstOffset, srcBase + srcOffset, rowSize);
+					std::memcpy(dst + dstOffset, srcBase + srcOffset, rowSize);
 				}
 			}
-
-			op.dst->GetMemory()->Unmap();
-			op.src->GetMemory()->Unmap();
 		}
 
 		return VK_SUCCESS;
 	}
 
-	VkResult CpuContext::CopyImageToBuffer(vkd::Buffer::OpCopyImageToBuffer op)
+	VkResult CpuContext::CopyImageToBuffer(const vkd::Buffer::OpCopyImageToBuffer& op, const UByte* src, UByte* dst)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		for (auto& region : op.regions)
-		{
-			CCT_ASSERT(op.src && op.src->GetMemory(), "Invalid pointer");
-			CCT_ASSERT(op.dst && op.dst->GetMemory(), "Invalid pointer");
+		CCT_ASSERT(src && dst, "Invalid pointer");
 
-			VkDeviceSize pixelSize = vkuFormatElementSize(op.src->GetFormat());
-			VkDeviceSize imageRowPitch = op.src->GetExtent().width * pixelSize;
-			VkDeviceSize imageSize = imageRowPitch * op.src->GetExtent().height * op.src->GetExtent().depth;
+		VkDeviceSize pixelSize = vkuFormatElementSize(op.src->GetFormat());
+		VkDeviceSize imageRowPitch = op.src->GetExtent().width * pixelSize;
 
+		for (const VkBufferImageCopy& region : op.regions)
+		{
 			UInt32 bufferRowLength = region.bufferRowLength ? region.bufferRowLength : region.imageExtent.width;
-			VkDeviceSize bufferRowPitch = bufferRowLength * pixelSize;
-
-			cct::UByte* srcBase = nullptr;
-			op.src->GetMemory()->Map(0, imageSize, reinterpret_cast<void**>(&srcBase));
-
-			cct::UByte* dstBase = nullptr;
-			op.dst->GetMemory()->Map(region.bufferOffset,
-									 bufferRowPitch * region.imageExtent.height * region.imageExtent.depth,
-									 reinterpret_cast<void**>(&dstBase));
+			UByte* dstBase = dst + region.bufferOffset;
 
 			VkDeviceSize rowSize = region.imageExtent.width * pixelSize;
 			for (UInt32 z = 0; z < region.imageExtent.depth; ++z)
@@ -270,43 +203,35 @@ namespace vkd::software
 					VkDeviceSize dstOffset = (z * bufferRowLength * region.imageExtent.height + y * bufferRowLength) *
 											 pixelSize;
 
-					std::memcpy(dstBase + dstOffset, srcBase + srcOffset, rowSize);
+					std::memcpy(dstBase + dstOffset, src + srcOffset, rowSize);
 				}
 			}
-
-			op.dst->GetMemory()->Unmap();
-			op.src->GetMemory()->Unmap();
 		}
 
 		return VK_SUCCESS;
 	}
 
-	VkResult CpuContext::ClearColorImage(vkd::Image::OpClearColorImage op)
+	VkResult CpuContext::ClearColorImage(const vkd::Image::OpClearColorImage& op, UByte* dst)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		CCT_ASSERT(op.image && op.image->GetMemory(), "Invalid pointer");
+		CCT_ASSERT(dst, "Invalid pointer");
 
-		for (auto& range : op.ranges)
-		{
-			VkDeviceSize pixelSize = vkuFormatElementSize(op.image->GetFormat());
-			VkDeviceSize imageSize = op.image->GetExtent().width * op.image->GetExtent().height *
-									 op.image->GetExtent().depth * pixelSize;
-
-			cct::UByte* data = nullptr;
-			op.image->GetMemory()->Map(0, imageSize, reinterpret_cast<void**>(&data));
+		VkDeviceSize pixelSize = vkuFormatElementSize(op.image->GetFormat());
+		VkDeviceSize imageSize = op.image->GetExtent().width * op.image->GetExtent().height *
+								 op.image->GetExtent().depth * pixelSize;
 
-			UInt32* data32 = reinterpret_cast<UInt32*>(data);
-			UInt32 clearValue = (static_cast<UInt32>(op.clearColor.uint32[3]) << 24) |
-								(static_cast<UInt32>(op.clearColor.uint32[2]) << 16) |
-								(static_cast<UInt32>(op.clearColor.uint32[1]) << 8) |
-								static_cast<UInt32>(op.clearColor.uint32[0]);
+		UInt32 clearValue = (static_cast<UInt32>(op.clearColor.uint32[3]) << 24) |
+							(static_cast<UInt32>(op.clearColor.uint32[2]) << 16) |
+							(static_cast<UInt32>(op.clearColor.uint32[1]) << 8) |
+							static_cast<UInt32>(op.clearColor.uint32[0]);
 
+		for ([[maybe_unused]] const VkImageSubresourceRange& range : op.ranges)
+		{
+			UInt32* data32 = reinterpret_cast<UInt32*>(dst);
 			size_t pixelCount = imageSize / pixelSize;
 			for (size_t i = 0; i < pixelCount; ++i)
 				data32[i] = clearValue;
-
-			op.image->GetMemory()->Unmap();
 		}
 
 		return VK_SUCCESS;
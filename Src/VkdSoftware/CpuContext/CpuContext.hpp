@@ -5,15 +5,23 @@
  *
  * Maintains the state for CPU-based rendering operations including vertex buffers,
  * pipeline state, and viewport configuration.
+ *
+ * A context lives as long as its queue and is reused by every command buffer it
+ * executes. Bound state follows Vulkan's rules and starts undefined for each command
+ * buffer, primary or secondary, while the scratch arenas keep their storage and are
+ * only rewound between primaries, so steady-state execution does not allocate.
  */
 
 #pragma once
 
-#include <vector>
+#include <array>
+
+#include <VkdUtils/ScratchArena/ScratchArena.hpp>
 
 #include "Vkd/Buffer/Buffer.hpp"
 #include "Vkd/CommandBuffer/Ops.hpp"
 #include "Vkd/Image/Image.hpp"
+#include "VkdSoftware/Defines.hpp"
 
 namespace vkd::software
 {
@@ -25,24 +33,38 @@ namespace vkd::software
 		CpuContext();
 		~CpuContext() = default;
 
-		VkResult BindPipeline(OpBindPipeline op);
-		VkResult BindVertexBuffer(OpBindVertexBuffer buffer);
-		VkResult Draw(vkd::OpDraw op);
-		VkResult CopyBuffer(vkd::Buffer::OpCopy op);
-		VkResult CopyBuffer2(vkd::Buffer::OpCopy2 op);
-		VkResult UpdateBuffer(vkd::Buffer::OpUpdate op);
-		VkResult FillBuffer(vkd::Buffer::OpFill op);
-		VkResult CopyBufferToImage(vkd::Buffer::OpCopyBufferToImage op);
-		VkResult CopyImageToBuffer(vkd::Buffer::OpCopyImageToBuffer op);
-		VkResult CopyImage(vkd::Image::OpCopy op);
-		VkResult ClearColorImage(vkd::Image::OpClearColorImage op);
+		// Transfer operations receive the host addresses of their resources, resolved by the execution plan
+		VkResult BindPipeline(const OpBindPipeline& op);
+		VkResult BindVertexBuffer(const OpBindVertexBuffer& op);
+		VkResult Draw(const vkd::OpDraw& op);
+		VkResult CopyBuffer(const vkd::Buffer::OpCopy& op, const UByte* src, UByte* dst);
+		VkResult CopyBuffer2(const vkd::Buffer::OpCopy2& op, const UByte* src, UByte* dst);
+		VkResult UpdateBuffer(const vkd::Buffer::OpUpdate& op, UByte* dst);
+		VkResult FillBuffer(const vkd::Buffer::OpFill& op, UByte* dst);
+		VkResult CopyBufferToImage(const vkd::Buffer::OpCopyBufferToImage& op, const UByte* src, UByte* dst);
+		VkResult CopyImageToBuffer(const vkd::Buffer::OpCopyImageToBuffer& op, const UByte* src, UByte* dst);
+		VkResult CopyImage(const vkd::Image::OpCopy& op, const UByte* src, UByte* dst);
+		VkResult ClearColorImage(const vkd::Image::OpClearColorImage& op, UByte* dst);
 
+		/// Clears bound state, done before each command buffer since none is inherited
 		inline void Reset();
+		/// Rewinds the scratch arenas, allocations from the previous command buffer become invalid
+		inline void ResetScratch();
+
+		// Scratch storage of the executing thread, not shared with the helpers of parallel batches
+		[[nodiscard]] inline ScratchArena& GetVertexScratch();
+		[[nodiscard]] inline ScratchArena& GetBinningScratch();
+		[[nodiscard]] inline ScratchArena& GetStagingScratch();
 
 	private:
 		vkd::Pipeline* m_boundPipeline = nullptr;
-		std::vector<Buffer*> m_boundVertexBuffers;
-		std::vector<VkDeviceSize> m_vertexBufferOffsets;
+		std::array<Buffer*, MaxVertexInputBindings> m_boundVertexBuffers = {};
+		std::array<VkDeviceSize, MaxVertexInputBindings> m_vertexBufferOffsets = {};
+		UInt32 m_boundVertexBufferCount = 0;
+
+		ScratchArena m_vertexScratch;	///< Post-transform vertices
+		ScratchArena m_binningScratch;	///< Primitive bins
+		ScratchArena m_stagingScratch;	///< Format conversion staging
 	};
 } // namespace vkd::software
 
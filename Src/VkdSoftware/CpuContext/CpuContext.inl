@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "VkdSoftware/CpuContext/CpuContext.hpp"
 
 namespace vkd::software
@@ -13,7 +15,30 @@ namespace vkd::software
 	inline void CpuContext::Reset()
 	{
 		m_boundPipeline = nullptr;
-		m_boundVertexBuffers.clear();
-		m_vertexBufferOffsets.clear();
+		std::fill_n(m_boundVertexBuffers.begin(), m_boundVertexBufferCount, nullptr);
+		std::fill_n(m_vertexBufferOffsets.begin(), m_boundVertexBufferCount, 0);
+		m_boundVertexBufferCount = 0;
+	}
+
+	inline void CpuContext::ResetScratch()
+	{
+		m_vertexScratch.Reset();
+		m_binningScratch.Reset();
+		m_stagingScratch.Reset();
+	}
+
+	inline ScratchArena& CpuContext::GetVertexScratch()
+	{
+		return m_vertexScratch;
+	}
+
+	inline ScratchArena& CpuContext::GetBinningScratch()
+	{
+		return m_binningScratch;
+	}
+
+	inline ScratchArena& CpuContext::GetStagingScratch()
+	{
+		return m_stagingScratch;
 	}
 } // namespace vkd::software
@@ -12,4 +12,10 @@
 #include <Concerto/Core/Assert.hpp>
 #include <Concerto/Core/Types/Types.hpp>
 
+namespace vkd::software
+{
+	/// Reported as maxVertexInputBindings, execution contexts keep fixed binding tables of this size
+	inline constexpr cct::UInt32 MaxVertexInputBindings = 16;
+} // namespace vkd::software
+
 #endif // VKD_SOFTWARE_DEFINE_HPP
\ No newline at end of file
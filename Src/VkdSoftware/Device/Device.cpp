@@ -6,6 +6,13 @@
 
 #include "VkdSoftware/Device/Device.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
 #include "Vkd/Memory/Memory.hpp"
 #include "Vkd/PhysicalDevice/PhysicalDevice.hpp"
 #include "VkdSoftware/Buffer/Buffer.hpp"
@@ -19,12 +26,98 @@
 #include "VkdSoftware/Queue/Queue.hpp"
 #include "VkdSoftware/RenderPass/RenderPass.hpp"
 #include "VkdSoftware/ShaderModule/ShaderModule.hpp"
+#include "VkdSoftware/Synchronization/Event/Event.hpp"
 #include "VkdSoftware/Synchronization/Fence/Fence.hpp"
+#include "VkdSoftware/Synchronization/Semaphore/Semaphore.hpp"
 #include "VkdUtils/System/System.hpp"
 
 namespace vkd::software
 {
+	namespace
+	{
+		/// VKD_THREADS overrides the worker count, VKD_THREAD_AFFINITY=none|numa|cpu how workers are pinned
+		/// and VKD_THREAD_SPIN_US how long idle workers may spin, 0 to park them right away
+		ThreadPool::Options GetThreadPoolOptions(const CpuTopology& topology)
+		{
+			ThreadPool::Options options;
+			options.Topology = &topology;
+
+			if (std::optional<std::string> threads = System::GetEnvironmentValue("VKD_THREADS"); threads && !threads->empty())
+			{
+				unsigned int count = 0;
+				const auto [end, error] = std::from_chars(threads->data(), threads->data() + threads->size(), count);
+				if (error == std::errc() && end == threads->data() + threads->size())
+					options.WorkerCount = count;
+				else
+					cct::Logger::Warning("Ignoring VKD_THREADS='{}', expected a worker count", *threads);
+			}
+
+			if (std::optional<std::string> spin = System::GetEnvironmentValue("VKD_THREAD_SPIN_US"); spin && !spin->empty())
+			{
+				unsigned int microseconds = 0;
+				const auto [end, error] = std::from_chars(spin->data(), spin->data() + spin->size(), microseconds);
+				if (error == std::errc() && end == spin->data() + spin->size())
+					options.MaxSpin = std::chrono::microseconds(microseconds);
+				else
+					cct::Logger::Warning("Ignoring VKD_THREAD_SPIN_US='{}', expected a duration in microseconds", *spin);
+			}
+
+			if (std::optional<std::string> affinity = System::GetEnvironmentValue("VKD_THREAD_AFFINITY"); affinity && !affinity->empty())
+			{
+				std::string lowered = *affinity;
+				std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](unsigned char c)
+							   { return static_cast<char>(std::tolower(c)); });
+
+				if (lowered == "none")
+					options.Pinning = ThreadPool::Affinity::None;
+				else if (lowered == "numa")
+					options.Pinning = ThreadPool::Affinity::NumaNode;
+				else if (lowered == "cpu")
+					options.Pinning = ThreadPool::Affinity::Cpu;
+				else
+					cct::Logger::Warning("Ignoring VKD_THREAD_AFFINITY='{}', expected none, numa or cpu", *affinity);
+			}
+
+			return options;
+		}
+
+		/// VKD_DEVICE_THREADS bounds the workers each device uses at once, all of them by default
+		unsigned int GetDeviceThreadQuota()
+		{
+			std::optional<std::string> threads = System::GetEnvironmentValue("VKD_DEVICE_THREADS");
+			if (!threads || threads->empty())
+				return 0;
+
+			unsigned int quota = 0;
+			const auto [end, error] = std::from_chars(threads->data(), threads->data() + threads->size(), quota);
+			if (error != std::errc() || end != threads->data() + threads->size())
+			{
+				cct::Logger::Warning("Ignoring VKD_DEVICE_THREADS='{}', expected a worker count", *threads);
+				return 0;
+			}
+			return quota;
+		}
+
+		/// Created with the first device and destroyed with the last one, so the worker count stays
+		/// bounded by the CPUs however many devices the process creates
+		std::shared_ptr<ThreadPool> AcquireSharedThreadPool()
+		{
+			static std::mutex mutex;
+			static std::weak_ptr<ThreadPool> sharedPool;
+
+			std::lock_guard lock(mutex);
+			std::shared_ptr<ThreadPool> pool = sharedPool.lock();
+			if (!pool)
+			{
+				pool = std::make_shared<ThreadPool>(GetThreadPoolOptions(System::QueryCpuTopology()));
+				sharedPool = pool;
+			}
+			return pool;
+		}
+	} // namespace
+
 	SoftwareDevice::SoftwareDevice() :
+		m_tasks(AcquireSharedThreadPool(), GetDeviceThreadQuota()),
 		m_allocator([]() -> std::size_t
 					{
 		System system;
@@ -38,7 +131,10 @@ namespace vkd::software
 
 	SoftwareDevice::~SoftwareDevice()
 	{
-		m_threadPool.RequestStop();
+		// The pool is shared with the other devices and not stopped, once the queues are drained
+		// nothing of this device is left to queue and m_tasks waits for its runners
+		for (Queue* queue : m_softwareQueues)
+			queue->StopExecutor();
 	}
 
 	VkResult SoftwareDevice::Create(vkd::PhysicalDevice& owner, const VkDeviceCreateInfo& pDeviceCreateInfo, const VkAllocationCallbacks& allocationCallbacks)
@@ -47,12 +143,26 @@ namespace vkd::software
 			return VK_ERROR_OUT_OF_DEVICE_MEMORY;
 
 		cct::Logger::Info("Allocated {} Mb for SoftwareDevice allocator", m_allocator.GetTotal() / (1024ULL * 1024ULL));
+
+		if (std::optional<std::string> capturePath = System::GetEnvironmentValue("VKD_CAPTURE"); capturePath && !capturePath->empty())
+		{
+			// A capture that cannot be opened is not fatal, the device simply runs without it
+			m_commandCapture.emplace();
+			if (!m_commandCapture->Open(*capturePath))
+				m_commandCapture.reset();
+		}
+
 		return Device::Create(owner, pDeviceCreateInfo, allocationCallbacks);
 	}
 
 	ThreadPool& SoftwareDevice::GetThreadPool()
 	{
-		return m_threadPool;
+		return m_tasks.GetPool();
+	}
+
+	TaskTenant& SoftwareDevice::GetTaskTenant()
+	{
+		return m_tasks;
 	}
 
 	Allocator& SoftwareDevice::GetAllocator()
@@ -60,7 +170,12 @@ namespace vkd::software
 		return m_allocator;
 	}
 
-	DispatchableObjectResult<vkd::Queue> SoftwareDevice::CreateQueueForFamily(uint32_t queueFamilyIndex, uint32_t queueIndex, VkDeviceQueueCreateFlags flags)
+	CommandCapture* SoftwareDevice::GetCommandCapture()
+	{
+		return m_commandCapture ? &*m_commandCapture : nullptr;
+	}
+
+	DispatchableObjectResult<vkd::Queue> SoftwareDevice::CreateQueueForFamily(uint32_t queueFamilyIndex, uint32_t queueIndex, VkDeviceQueueCreateFlags flags, VkQueueGlobalPriorityEXT globalPriority)
 	{
 		PhysicalDevice* physicalDevice = GetOwner();
 		auto properties = physicalDevice->GetQueueFamilyProperties();
@@ -73,10 +188,11 @@ namespace vkd::software
 			return VK_ERROR_OUT_OF_HOST_MEMORY;
 		}
 
-		VkResult result = queue->Object->Create(*this, queueFamilyIndex, queueIndex, flags);
+		VkResult result = queue->Object->Create(*this, queueFamilyIndex, queueIndex, flags, globalPriority);
 		if (result != VK_SUCCESS)
 			return result;
 
+		m_softwareQueues.push_back(queue->Object);
 		return reinterpret_cast<DispatchableObject<vkd::Queue>*>(queue);
 	}
 
@@ -104,6 +220,30 @@ namespace vkd::software
 		return fence;
 	}
 
+	Result<vkd::Semaphore*, VkResult> SoftwareDevice::CreateSemaphore(const VkAllocationCallbacks& allocationCallbacks)
+	{
+		auto* semaphore = mem::New<Semaphore>(allocationCallbacks, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+		if (!semaphore)
+		{
+			CCT_ASSERT_FALSE("Failed to allocate Semaphore");
+			return VK_ERROR_OUT_OF_HOST_MEMORY;
+		}
+
+		return semaphore;
+	}
+
+	Result<vkd::Event*, VkResult> SoftwareDevice::CreateEvent(const VkAllocationCallbacks& allocationCallbacks)
+	{
+		auto* event = mem::New<Event>(allocationCallbacks, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
+		if (!event)
+		{
+			CCT_ASSERT_FALSE("Failed to allocate Event");
+			return VK_ERROR_OUT_OF_HOST_MEMORY;
+		}
+
+		return event;
+	}
+
 	Result<vkd::Buffer*, VkResult> SoftwareDevice::CreateBuffer(const VkAllocationCallbacks& allocationCallbacks)
 	{
 		auto* buffer = mem::New<Buffer>(allocationCallbacks, VK_SYSTEM_ALLOCATION_SCOPE_OBJECT);
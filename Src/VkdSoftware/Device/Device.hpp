@@ -3,17 +3,24 @@
  * @brief Software renderer logical device implementation
  * @date 2025-04-23
  *
- * CPU-based software rendering logical device with thread pool and memory allocator.
+ * CPU-based software rendering logical device with memory allocator. Devices share the
+ * process thread pool, each through a task tenant bounding the workers it uses at once.
  */
 
 #pragma once
 
+#include <optional>
+#include <vector>
+
 #include "Vkd/Device/Device.hpp"
+#include "VkdSoftware/Capture/CommandCapture.hpp"
 #include "VkdUtils/Allocator/Allocator.hpp"
-#include "VkdUtils/ThreadPool/ThreadPool.hpp"
+#include "VkdUtils/TaskTenant/TaskTenant.hpp"
 
 namespace vkd::software
 {
+	class Queue;
+
 	class SoftwareDevice : public Device
 	{
 	public:
@@ -22,12 +29,19 @@ namespace vkd::software
 
 		VkResult Create(vkd::PhysicalDevice& owner, const VkDeviceCreateInfo& pDeviceCreateInfo, const VkAllocationCallbacks& allocationCallbacks) override;
 
+		/// Pool shared by every device of the process
 		[[nodiscard]] ThreadPool& GetThreadPool();
+		/// This device's share of the pool, where its work is queued
+		[[nodiscard]] TaskTenant& GetTaskTenant();
 		[[nodiscard]] Allocator& GetAllocator();
+		/// Null unless VKD_CAPTURE names a trace file
+		[[nodiscard]] CommandCapture* GetCommandCapture();
 
-		DispatchableObjectResult<vkd::Queue> CreateQueueForFamily(uint32_t queueFamilyIndex, uint32_t queueIndex, VkDeviceQueueCreateFlags flags) override;
+		DispatchableObjectResult<vkd::Queue> CreateQueueForFamily(uint32_t queueFamilyIndex, uint32_t queueIndex, VkDeviceQueueCreateFlags flags, VkQueueGlobalPriorityEXT globalPriority) override;
 		Result<vkd::CommandPool*, VkResult> CreateCommandPool(const VkAllocationCallbacks& allocationCallbacks) override;
 		Result<vkd::Fence*, VkResult> CreateFence(const VkAllocationCallbacks& allocationCallbacks) override;
+		Result<vkd::Semaphore*, VkResult> CreateSemaphore(const VkAllocationCallbacks& allocationCallbacks) override;
+		Result<vkd::Event*, VkResult> CreateEvent(const VkAllocationCallbacks& allocationCallbacks) override;
 		Result<vkd::Buffer*, VkResult> CreateBuffer(const VkAllocationCallbacks& allocationCallbacks) override;
 		Result<vkd::BufferView*, VkResult> CreateBufferView(const VkAllocationCallbacks& allocationCallbacks) override;
 		Result<vkd::Image*, VkResult> CreateImage(const VkAllocationCallbacks& allocationCallbacks) override;
@@ -39,7 +53,10 @@ namespace vkd::software
 		Result<vkd::ShaderModule*, VkResult> CreateShaderModule(const VkAllocationCallbacks& allocationCallbacks) override;
 
 	private:
-		ThreadPool m_threadPool;
+		TaskTenant m_tasks;
 		Allocator m_allocator;
+		std::optional<CommandCapture> m_commandCapture;
+		/// Stopped before the task tenant is destroyed, their drain tasks run on it
+		std::vector<Queue*> m_softwareQueues;
 	};
 } // namespace vkd::software
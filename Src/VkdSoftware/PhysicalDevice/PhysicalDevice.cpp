@@ -6,6 +6,7 @@
 
 #include "VkdSoftware/PhysicalDevice/PhysicalDevice.hpp"
 
+#include "VkdSoftware/Defines.hpp"
 #include "VkdSoftware/Device/Device.hpp"
 
 namespace vkd::software
@@ -51,7 +52,7 @@ namespace vkd::software
 			.maxDescriptorSetStorageImages = 24,
 			.maxDescriptorSetInputAttachments = 4,
 			.maxVertexInputAttributes = 16,
-			.maxVertexInputBindings = 16,
+			.maxVertexInputBindings = MaxVertexInputBindings,
 			.maxVertexInputAttributeOffset = 2047,
 			.maxVertexInputBindingStride = 2048,
 			.maxVertexOutputComponents = 64,
@@ -134,21 +135,23 @@ namespace vkd::software
 		std::memcpy(physicalDeviceProperties.deviceName, deviceName.data(), deviceName.size());
 		physicalDeviceProperties.sparseProperties = {};
 
+		// Every created queue drains its submissions on the device task tenant, the counts stay
+		// small so that an application creating all of them does not flood the device quota
 		std::array queueFamilyProperties = {
 			VkQueueFamilyProperties{
 				.queueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT,
-				.queueCount = 1,
+				.queueCount = 4,
 				.timestampValidBits = 0,
 				.minImageTransferGranularity = {1, 1, 1}},
 			VkQueueFamilyProperties{
 				.queueFlags = VK_QUEUE_GRAPHICS_BIT,
-				.queueCount = 1,
+				.queueCount = 2,
 				.timestampValidBits = 0,
 				.minImageTransferGranularity = {1, 1, 1},
 			},
 			VkQueueFamilyProperties{
 				.queueFlags = VK_QUEUE_TRANSFER_BIT,
-				.queueCount = 1,
+				.queueCount = 2,
 				.timestampValidBits = 0,
 				.minImageTransferGranularity = {1, 1, 1},
 			}};
@@ -6,59 +6,164 @@
 
 #include "VkdSoftware/Queue/Queue.hpp"
 
+#include <thread>
+#include <utility>
+
+#include "Vkd/Synchronization/Event/Event.hpp"
 #include "VkdSoftware/CommandBuffer/CommandBuffer.hpp"
-#include "VkdSoftware/CommandDispatcher/CommandDispatcher.hpp"
-#include "VkdSoftware/CpuContext/CpuContext.hpp"
 #include "VkdSoftware/Device/Device.hpp"
 #include "VkdSoftware/Synchronization/Fence/Fence.hpp"
+#include "VkdSoftware/Synchronization/Semaphore/Semaphore.hpp"
+#include "VkdUtils/System/System.hpp"
 
 namespace vkd::software
 {
-	VkResult Queue::Create(Device& owner, uint32_t queueFamilyIndex, uint32_t queueIndex, VkDeviceQueueCreateFlags flags)
+	namespace
+	{
+		const VkTimelineSemaphoreSubmitInfo* FindTimelineSubmitInfo(const VkSubmitInfo& submitInfo)
+		{
+			const VkTimelineSemaphoreSubmitInfo* timelineInfo = nullptr;
+			const VkBaseInStructure* pNext = static_cast<const VkBaseInStructure*>(submitInfo.pNext);
+			while (pNext)
+			{
+				if (pNext->sType == VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO)
+					timelineInfo = reinterpret_cast<const VkTimelineSemaphoreSubmitInfo*>(pNext);
+				pNext = pNext->pNext;
+			}
+			return timelineInfo;
+		}
+	} // namespace
+
+	Queue::Queue() :
+		m_pendingRing(SubmissionRingCapacity),
+		m_pendingCount(0),
+		m_submittedCount(0),
+		m_completedCount(0),
+		m_tasks(nullptr),
+		m_currentSubmission(nullptr),
+		m_nextBatch(0),
+		m_nextCommandBuffer(0),
+		m_inlineSubmitEnabled(false),
+		m_taskPriority(ThreadPool::Priority::Normal)
+	{
+	}
+
+	Queue::~Queue()
 	{
-		return vkd::Queue::Create(owner, queueFamilyIndex, queueIndex, flags);
+		StopExecutor();
+	}
+
+	VkResult Queue::Create(Device& owner, uint32_t queueFamilyIndex, uint32_t queueIndex, VkDeviceQueueCreateFlags flags, VkQueueGlobalPriorityEXT globalPriority)
+	{
+		VkResult result = vkd::Queue::Create(owner, queueFamilyIndex, queueIndex, flags, globalPriority);
+		if (result != VK_SUCCESS)
+			return result;
+
+		switch (globalPriority)
+		{
+			case VK_QUEUE_GLOBAL_PRIORITY_REALTIME_EXT:
+			case VK_QUEUE_GLOBAL_PRIORITY_HIGH_EXT:
+				m_taskPriority = ThreadPool::Priority::Realtime;
+				break;
+			case VK_QUEUE_GLOBAL_PRIORITY_LOW_EXT:
+				m_taskPriority = ThreadPool::Priority::Background;
+				break;
+			default:
+				m_taskPriority = ThreadPool::Priority::Normal;
+				break;
+		}
+
+		m_inlineSubmitEnabled = System::IsEnvironmentFlagSet("VKD_INLINE_SUBMIT");
+		m_drainWaiter.Owner = this;
+		m_tasks = &static_cast<SoftwareDevice&>(owner).GetTaskTenant();
+
+		return VK_SUCCESS;
+	}
+
+	void Queue::StopExecutor()
+	{
+		if (!m_tasks)
+			return;
+
+		// Once everything submitted completed the drain task only has to return
+		WaitIdle();
+		m_tasks->Wait(m_drainCounter);
+		m_tasks = nullptr;
 	}
 
 	VkResult Queue::Submit(uint32_t submitCount, const VkSubmitInfo* pSubmits, VkFence fence)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
-		VKD_CHECK(submitCount && pSubmits);
+		VKD_CHECK(submitCount == 0 || pSubmits);
 
-		std::vector<vkd::CommandBuffer*> cmdBuffers;
-		cmdBuffers.resize(pSubmits->commandBufferCount);
-		for (std::size_t i = 0; i < pSubmits->commandBufferCount; ++i)
+		for (uint32_t i = 0; i < submitCount; ++i)
 		{
-			VKD_FROM_HANDLE(vkd::CommandBuffer, cmdBufferObj, pSubmits->pCommandBuffers[i]);
-			cmdBuffers[i] = cmdBufferObj;
+			VkResult result = ValidateSemaphoreOperations(pSubmits[i]);
+			if (result != VK_SUCCESS)
+				return result;
 		}
 
-		auto* softwareDevice = static_cast<SoftwareDevice*>(GetOwner());
-		auto& threadPool = softwareDevice->GetThreadPool();
+		Submission* submission = AcquireSubmission();
+		submission->Fence = fence;
 
-		std::lock_guard<std::mutex> lock(m_submitMutex);
-		auto previousSubmit = std::move(m_previousSubmit);
+		for (uint32_t i = 0; i < submitCount; ++i)
+		{
+			const VkSubmitInfo& submitInfo = pSubmits[i];
+			submission->Batches.push_back(SubmitBatch{
+				.FirstCommandBuffer = static_cast<UInt32>(submission->CommandBuffers.size()),
+				.CommandBufferCount = submitInfo.commandBufferCount,
+			});
 
-		m_previousSubmit = threadPool.Submit([cmdBuffers, fence, previousSubmit = std::move(previousSubmit)]() mutable -> bool
-											 {
-			// Wait for the previous submit to complete before starting the new one
-			if (previousSubmit.valid())
+			for (uint32_t j = 0; j < submitInfo.commandBufferCount; ++j)
 			{
-				previousSubmit.wait();
-			}
+				VKD_FROM_HANDLE(vkd::CommandBuffer, cmdBufferObj, submitInfo.pCommandBuffers[j]);
 
-			for (auto* cmdBufferObj : cmdBuffers)
-			{
-				CpuContext cpuContext;
-				CommandDispatcher commandDispatcher(cpuContext);
-				commandDispatcher.Execute(*cmdBufferObj);
+				VkResult result = cmdBufferObj->MarkSubmitted();
+				if (result != VK_SUCCESS)
+				{
+					// Nothing ran, one-time submit buffers stay executable
+					for (vkd::CommandBuffer* submitted : submission->CommandBuffers)
+						submitted->UnmarkSubmitted();
+					ReleaseSubmission(submission);
+					return result;
+				}
+				submission->CommandBuffers.push_back(cmdBufferObj);
 			}
+		}
 
-			if (fence)
-			{
-				VKD_FROM_HANDLE(vkd::Fence, fenceObj, fence);
-				fenceObj->Signal();
-			}
-			return true; });
+		// Reserved once nothing can fail anymore, binary semaphore counters are not rolled back
+		for (uint32_t i = 0; i < submitCount; ++i)
+			AddSemaphoreOperations(*submission, submission->Batches[i], pSubmits[i]);
+
+		// Submits are externally synchronized, with nothing pending no drain task is in flight
+		// until the next submit, the calling thread can take its place
+		if (m_inlineSubmitEnabled && submission->Waits.empty() && m_pendingCount.load(std::memory_order_acquire) == 0 && CanExecuteInline(*submission))
+		{
+			m_submittedCount.fetch_add(1, std::memory_order_acq_rel);
+			// Without waits it cannot suspend
+			m_nextBatch = 0;
+			Execute(*submission);
+			ReleaseSubmission(submission);
+
+			m_completedCount.fetch_add(1, std::memory_order_acq_rel);
+			m_completedCount.notify_all();
+			return VK_SUCCESS;
+		}
+
+		// Counted before being pushed, a WaitIdle snapshot covers every submission that already owns a ring slot
+		m_submittedCount.fetch_add(1, std::memory_order_acq_rel);
+
+		UInt64 completed = m_completedCount.load(std::memory_order_acquire);
+		while (!m_pendingRing.TryPush(submission))
+		{
+			// The ring is full, the drain task frees a slot before each completion
+			m_completedCount.wait(completed, std::memory_order_acquire);
+			completed = m_completedCount.load(std::memory_order_acquire);
+		}
+
+		// While a drain task runs or is suspended it picks the submission up later
+		if (m_pendingCount.fetch_add(1, std::memory_order_acq_rel) == 0)
+			ScheduleDrain();
 
 		return VK_SUCCESS;
 	}
@@ -67,12 +172,12 @@ namespace vkd::software
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		std::lock_guard<std::mutex> lock(m_submitMutex);
-
-		// Wait for the previous submit to complete
-		if (m_previousSubmit.valid())
+		const UInt64 target = m_submittedCount.load(std::memory_order_acquire);
+		UInt64 completed = m_completedCount.load(std::memory_order_acquire);
+		while (completed < target)
 		{
-			m_previousSubmit.wait();
+			m_completedCount.wait(completed, std::memory_order_acquire);
+			completed = m_completedCount.load(std::memory_order_acquire);
 		}
 
 		return VK_SUCCESS;
@@ -85,4 +190,262 @@ namespace vkd::software
 		// Sparse binding is an optional feature, not implemented for software queue
 		return VK_ERROR_FEATURE_NOT_PRESENT;
 	}
+
+	VkResult Queue::ValidateSemaphoreOperations(const VkSubmitInfo& submitInfo)
+	{
+		const VkTimelineSemaphoreSubmitInfo* timelineInfo = FindTimelineSubmitInfo(submitInfo);
+
+		for (uint32_t i = 0; i < submitInfo.waitSemaphoreCount; ++i)
+		{
+			VKD_FROM_HANDLE(vkd::Semaphore, semaphoreObj, submitInfo.pWaitSemaphores[i]);
+			if (semaphoreObj->GetType() != VK_SEMAPHORE_TYPE_TIMELINE)
+				continue;
+
+			if (!timelineInfo || i >= timelineInfo->waitSemaphoreValueCount || !timelineInfo->pWaitSemaphoreValues)
+			{
+				CCT_ASSERT_FALSE("Timeline semaphore wait {} has no value in VkTimelineSemaphoreSubmitInfo", i);
+				return VK_ERROR_VALIDATION_FAILED_EXT;
+			}
+		}
+
+		for (uint32_t i = 0; i < submitInfo.signalSemaphoreCount; ++i)
+		{
+			VKD_FROM_HANDLE(vkd::Semaphore, semaphoreObj, submitInfo.pSignalSemaphores[i]);
+			if (semaphoreObj->GetType() != VK_SEMAPHORE_TYPE_TIMELINE)
+				continue;
+
+			if (!timelineInfo || i >= timelineInfo->signalSemaphoreValueCount || !timelineInfo->pSignalSemaphoreValues)
+			{
+				CCT_ASSERT_FALSE("Timeline semaphore signal {} has no value in VkTimelineSemaphoreSubmitInfo", i);
+				return VK_ERROR_VALIDATION_FAILED_EXT;
+			}
+		}
+
+		return VK_SUCCESS;
+	}
+
+	void Queue::AddSemaphoreOperations(Submission& submission, SubmitBatch& batch, const VkSubmitInfo& submitInfo)
+	{
+		// Validated by ValidateSemaphoreOperations, timeline semaphores have their value
+		const VkTimelineSemaphoreSubmitInfo* timelineInfo = FindTimelineSubmitInfo(submitInfo);
+
+		// Waits cover the whole batch whatever their stage mask, the drain task runs a batch as a unit
+		batch.FirstWait = static_cast<UInt32>(submission.Waits.size());
+		batch.WaitCount = submitInfo.waitSemaphoreCount;
+		for (uint32_t i = 0; i < submitInfo.waitSemaphoreCount; ++i)
+		{
+			VKD_FROM_HANDLE(vkd::Semaphore, semaphoreObj, submitInfo.pWaitSemaphores[i]);
+			const UInt64 value = semaphoreObj->GetType() == VK_SEMAPHORE_TYPE_TIMELINE ? timelineInfo->pWaitSemaphoreValues[i] : static_cast<Semaphore*>(semaphoreObj)->ReserveBinaryWait();
+			submission.Waits.push_back(SemaphoreOperation{semaphoreObj, value});
+		}
+
+		batch.FirstSignal = static_cast<UInt32>(submission.Signals.size());
+		batch.SignalCount = submitInfo.signalSemaphoreCount;
+		for (uint32_t i = 0; i < submitInfo.signalSemaphoreCount; ++i)
+		{
+			VKD_FROM_HANDLE(vkd::Semaphore, semaphoreObj, submitInfo.pSignalSemaphores[i]);
+			const UInt64 value = semaphoreObj->GetType() == VK_SEMAPHORE_TYPE_TIMELINE ? timelineInfo->pSignalSemaphoreValues[i] : static_cast<Semaphore*>(semaphoreObj)->ReserveBinarySignal();
+			submission.Signals.push_back(SemaphoreOperation{semaphoreObj, value});
+		}
+	}
+
+	Queue::Submission* Queue::AcquireSubmission()
+	{
+		std::lock_guard<std::mutex> lock(m_submissionPoolMutex);
+		if (m_freeSubmissions.empty())
+			return &m_submissions.emplace_back();
+
+		Submission* submission = m_freeSubmissions.back();
+		m_freeSubmissions.pop_back();
+		return submission;
+	}
+
+	void Queue::ReleaseSubmission(Submission* submission)
+	{
+		// Clearing keeps the vectors capacity, a recycled record does not allocate again
+		submission->CommandBuffers.clear();
+		submission->Waits.clear();
+		submission->Signals.clear();
+		submission->Batches.clear();
+		submission->Fence = VK_NULL_HANDLE;
+
+		std::lock_guard<std::mutex> lock(m_submissionPoolMutex);
+		m_freeSubmissions.push_back(submission);
+	}
+
+	bool Queue::CanExecuteInline(const Submission& submission) const
+	{
+		std::size_t stepCount = 0;
+		VkDeviceSize cost = 0;
+		for (const vkd::CommandBuffer* cmdBufferObj : submission.CommandBuffers)
+		{
+			const ExecutionPlan& plan = static_cast<const CommandBuffer*>(cmdBufferObj)->GetExecutionPlan();
+			if (plan.HasOpaqueSteps())
+				return false;
+
+			stepCount += plan.GetSteps().size();
+			cost += plan.GetCost();
+			if (stepCount > InlineSubmitMaxSteps || cost > InlineSubmitMaxCost)
+				return false;
+		}
+
+		return true;
+	}
+
+	bool Queue::Execute(Submission& submission)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		auto* softwareDevice = static_cast<SoftwareDevice*>(GetOwner());
+		TaskTenant& tasks = softwareDevice->GetTaskTenant();
+		CommandCapture* capture = softwareDevice->GetCommandCapture();
+
+		// Batches run in submission order, so everything a batch waits on from an earlier
+		// batch of the same call has already executed when it starts
+		for (; m_nextBatch < submission.Batches.size(); ++m_nextBatch)
+		{
+			const SubmitBatch& batch = submission.Batches[m_nextBatch];
+			const std::span<vkd::CommandBuffer* const> cmdBuffers(submission.CommandBuffers.data() + batch.FirstCommandBuffer, batch.CommandBufferCount);
+
+			// A batch stopped at an event wait already went through its semaphore waits and capture
+			if (m_nextCommandBuffer == 0 && !m_resumePoint.IsSuspended())
+			{
+				// Submits made later on this queue stay behind in the ring meanwhile, queue order is kept.
+				// Payloads only grow, waits checked before a suspension are checked again harmlessly
+				for (UInt32 i = 0; i < batch.WaitCount; ++i)
+				{
+					const SemaphoreOperation& wait = submission.Waits[batch.FirstWait + i];
+					if (wait.Semaphore->GetCounterValue() < wait.Value && SuspendOn(*wait.Semaphore, wait.Value))
+						return false;
+				}
+
+				// Captured once everything before it executed, the referenced resources hold what this batch reads
+				if (capture)
+					capture->CaptureSubmit(cmdBuffers);
+			}
+
+			for (; m_nextCommandBuffer < cmdBuffers.size(); ++m_nextCommandBuffer)
+			{
+				vkd::CommandBuffer* cmdBufferObj = cmdBuffers[m_nextCommandBuffer];
+
+				// A resumed command buffer keeps its bound state and scratch storage
+				if (!m_resumePoint.IsSuspended())
+				{
+					m_cpuContext.Reset();
+					m_cpuContext.ResetScratch();
+				}
+
+				CommandDispatcher commandDispatcher(m_cpuContext, &tasks, m_taskPriority, &m_resumePoint);
+				while (commandDispatcher.Execute(*static_cast<CommandBuffer*>(cmdBufferObj)) == VK_NOT_READY)
+				{
+					// Set between the check and the registration, the command buffer continues right away
+					if (SuspendOn(*m_resumePoint.Event))
+						return false;
+				}
+				cmdBufferObj->MarkComplete();
+			}
+			m_nextCommandBuffer = 0;
+
+			for (UInt32 i = 0; i < batch.SignalCount; ++i)
+			{
+				const SemaphoreOperation& signal = submission.Signals[batch.FirstSignal + i];
+				signal.Semaphore->Signal(signal.Value);
+			}
+		}
+
+		if (submission.Fence)
+		{
+			VKD_FROM_HANDLE(vkd::Fence, fenceObj, submission.Fence);
+			fenceObj->Signal();
+		}
+
+		return true;
+	}
+
+	bool Queue::SuspendOn(vkd::Semaphore& semaphore, UInt64 value)
+	{
+		m_drainWaiter.Semaphore = &semaphore;
+		m_drainWaiter.Value = value;
+		m_drainWaiter.Event = nullptr;
+		return Suspend(semaphore.GetWaiters());
+	}
+
+	bool Queue::SuspendOn(vkd::Event& event)
+	{
+		m_drainWaiter.Semaphore = nullptr;
+		m_drainWaiter.Event = &event;
+		return Suspend(event.GetWaiters());
+	}
+
+	bool Queue::Suspend(SyncWaiterList& waiters)
+	{
+		m_drainWaiter.Claimed.store(false, std::memory_order_relaxed);
+		waiters.Add(m_drainWaiter);
+
+		// Satisfied between the check and the registration, the notification may have claimed the
+		// wait first, it then queues the drain again and this one must stop
+		if (m_drainWaiter.IsSatisfied() && !m_drainWaiter.Claimed.exchange(true, std::memory_order_acq_rel))
+		{
+			waiters.Remove(m_drainWaiter);
+			return false;
+		}
+
+		return true;
+	}
+
+	void Queue::ScheduleDrain()
+	{
+		m_tasks->AddTask(m_drainCounter, [this]()
+						 { Drain(); }, m_taskPriority);
+	}
+
+	void Queue::Drain()
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		// Returns once the pending count is back to zero, a later submit queues the drain again
+		do
+		{
+			if (!m_currentSubmission)
+			{
+				// The pending count only covers pushed submissions, a failed pop means an earlier
+				// slot is reserved by a producer that has not published it yet
+				while (!m_pendingRing.TryPop(m_currentSubmission))
+					std::this_thread::yield();
+				m_nextBatch = 0;
+			}
+
+			// Suspended, the semaphore signal or event set queues the drain again and it resumes from here
+			if (!Execute(*m_currentSubmission))
+				return;
+
+			ReleaseSubmission(std::exchange(m_currentSubmission, nullptr));
+
+			m_completedCount.fetch_add(1, std::memory_order_acq_rel);
+			m_completedCount.notify_all();
+		} while (m_pendingCount.fetch_sub(1, std::memory_order_acq_rel) != 1);
+	}
+
+	Queue::DrainWaiter::DrainWaiter() :
+		SyncWaiter(Callbacks)
+	{
+	}
+
+	bool Queue::DrainWaiter::IsSatisfied() const
+	{
+		if (Event)
+			return Event->GetStatus() == VK_EVENT_SET;
+		return Semaphore->GetCounterValue() >= Value;
+	}
+
+	bool Queue::DrainWaiter::IsReady(SyncWaiter& waiter)
+	{
+		DrainWaiter& self = static_cast<DrainWaiter&>(waiter);
+		return self.IsSatisfied() && !self.Claimed.exchange(true, std::memory_order_acq_rel);
+	}
+
+	void Queue::DrainWaiter::Resume(SyncWaiter& waiter)
+	{
+		static_cast<DrainWaiter&>(waiter).Owner->ScheduleDrain();
+	}
 } // namespace vkd::software
@@ -3,25 +3,59 @@
  * @brief Software renderer queue implementation
  * @date 2025-10-25
  *
- * Queue implementation for CPU-based command execution with thread pool scheduling.
+ * Queue implementation for CPU-based command execution. Submissions are executed in
+ * order by a drain task queued on the device's task tenant when the queue goes from
+ * idle to pending. Queues execute concurrently with each other, on the workers the
+ * device quota grants, and hold no thread while idle.
+ *
+ * A batch waiting on a semaphore that has not reached its value suspends the drain: the
+ * queue registers on the semaphore and returns the worker, the signal reaching the value
+ * queues the drain again. A command buffer reaching a wait on an event not set yet stops
+ * the same way and resumes from the wait once the event is set. A queue waiting on the
+ * host or on another queue therefore never holds a worker.
+ *
+ * With VKD_INLINE_SUBMIT=1, a submit small enough to cost less than the hand-off is
+ * executed by the calling thread when nothing is pending on the queue, its fence is
+ * then signaled before vkQueueSubmit returns.
+ *
+ * The VK_EXT_global_priority priority selects the thread pool lane of the queue's drain
+ * task and parallel work: realtime and high queues go first, low queues in the background lane.
  */
 
 #pragma once
 
-#include <future>
+#include <atomic>
+#include <deque>
 #include <mutex>
+#include <vector>
+
+#include <VkdUtils/MpscRing/MpscRing.hpp>
 
 #include "Vkd/Queue/Queue.hpp"
+#include "VkdSoftware/CommandDispatcher/CommandDispatcher.hpp"
+#include "VkdSoftware/CpuContext/CpuContext.hpp"
+#include "VkdUtils/SyncWaiter/SyncWaiter.hpp"
+#include "VkdUtils/TaskTenant/TaskTenant.hpp"
+
+namespace vkd
+{
+	class CommandBuffer;
+	class Event;
+	class Semaphore;
+} // namespace vkd
 
 namespace vkd::software
 {
 	class Queue : public vkd::Queue
 	{
 	public:
-		Queue() = default;
-		~Queue() override = default;
+		Queue();
+		~Queue() override;
+
+		VkResult Create(Device& owner, uint32_t queueFamilyIndex, uint32_t queueIndex, VkDeviceQueueCreateFlags flags, VkQueueGlobalPriorityEXT globalPriority) override;
 
-		VkResult Create(Device& owner, uint32_t queueFamilyIndex, uint32_t queueIndex, VkDeviceQueueCreateFlags flags) override;
+		/// Waits until what is still pending executed and the drain task returned, no submit may follow
+		void StopExecutor();
 
 	protected:
 		VkResult Submit(uint32_t submitCount, const VkSubmitInfo* pSubmits, VkFence fence) override;
@@ -29,8 +63,101 @@ namespace vkd::software
 		VkResult BindSparse(uint32_t bindInfoCount, const VkBindSparseInfo* pBindInfo, VkFence fence) override;
 
 	private:
-		// Future: Add CPU rasterization pipeline, command buffer execution, etc.
-		std::future<bool> m_previousSubmit;
-		std::mutex m_submitMutex;
+		/// Payload value a semaphore has to reach before a batch, or is raised to after it
+		struct SemaphoreOperation
+		{
+			vkd::Semaphore* Semaphore;
+			UInt64 Value;
+		};
+
+		/// One VkSubmitInfo, as ranges of the Submission vectors
+		struct SubmitBatch
+		{
+			UInt32 FirstCommandBuffer;
+			UInt32 CommandBufferCount;
+			UInt32 FirstWait;
+			UInt32 WaitCount;
+			UInt32 FirstSignal;
+			UInt32 SignalCount;
+		};
+
+		/// Every batch of a vkQueueSubmit call, executed in order by the queue drain task.
+		/// Records are recycled once executed so their storage is reused by later submits.
+		struct Submission
+		{
+			std::vector<vkd::CommandBuffer*> CommandBuffers;
+			std::vector<SemaphoreOperation> Waits;
+			std::vector<SemaphoreOperation> Signals;
+			std::vector<SubmitBatch> Batches;
+			VkFence Fence = VK_NULL_HANDLE;
+		};
+
+		/// Registered on the semaphore or the event a suspended drain waits on
+		struct DrainWaiter : SyncWaiter
+		{
+			DrainWaiter();
+
+			/// Whether the semaphore reached the value, or the event is set
+			[[nodiscard]] bool IsSatisfied() const;
+
+			/// Claims the wait once satisfied, under the waiter list lock
+			static bool IsReady(SyncWaiter& waiter);
+			static void Resume(SyncWaiter& waiter);
+
+			static constexpr SyncWaiterCallbacks Callbacks = {&IsReady, &Resume};
+
+			Queue* Owner = nullptr;
+			/// Waited on when no event is
+			vkd::Semaphore* Semaphore = nullptr;
+			UInt64 Value = 0;
+			vkd::Event* Event = nullptr;
+			/// Set by whichever of the drain or the signal continues the queue
+			std::atomic<bool> Claimed = false;
+		};
+
+		/// Timeline semaphores need a value in the chained VkTimelineSemaphoreSubmitInfo, checked before anything is marked
+		static VkResult ValidateSemaphoreOperations(const VkSubmitInfo& submitInfo);
+		void AddSemaphoreOperations(Submission& submission, SubmitBatch& batch, const VkSubmitInfo& submitInfo);
+		Submission* AcquireSubmission();
+		void ReleaseSubmission(Submission* submission);
+		bool CanExecuteInline(const Submission& submission) const;
+		/// Runs the batches from m_nextBatch on, false once suspended on a semaphore or event wait
+		bool Execute(Submission& submission);
+		/// Registers the drain on semaphore, false when the value was reached meanwhile and the drain continues
+		bool SuspendOn(vkd::Semaphore& semaphore, UInt64 value);
+		/// Registers the drain on event, false when it was set meanwhile and the drain continues
+		bool SuspendOn(vkd::Event& event);
+		bool Suspend(SyncWaiterList& waiters);
+		void ScheduleDrain();
+		void Drain();
+
+		static constexpr std::size_t SubmissionRingCapacity = 256;
+		/// Inline submits are limited to transfer ops, this many steps at most writing this many bytes
+		static constexpr std::size_t InlineSubmitMaxSteps = 32;
+		static constexpr VkDeviceSize InlineSubmitMaxCost = 64 * 1024;
+
+		/// Submissions waiting for the drain task, in vkQueueSubmit order
+		MpscRing<Submission*> m_pendingRing;
+		/// Submissions pushed and not executed yet, the submit taking it from zero queues the drain task
+		std::atomic<UInt32> m_pendingCount;
+		std::atomic<UInt64> m_submittedCount;
+		std::atomic<UInt64> m_completedCount;
+		/// Null before Create and once stopped
+		TaskTenant* m_tasks;
+		/// Drain tasks queued or running, at most one
+		TaskCounter m_drainCounter;
+		// Progress of the drain, kept while it is suspended
+		Submission* m_currentSubmission;
+		std::size_t m_nextBatch;
+		std::size_t m_nextCommandBuffer;
+		CommandDispatcher::ResumePoint m_resumePoint;
+		DrainWaiter m_drainWaiter;
+		/// Only used by the drain task, its bound state and scratch storage persist across submits
+		CpuContext m_cpuContext;
+		bool m_inlineSubmitEnabled;
+		ThreadPool::Priority m_taskPriority;
+		std::deque<Submission> m_submissions;
+		std::vector<Submission*> m_freeSubmissions;
+		std::mutex m_submissionPoolMutex;
 	};
 } // namespace vkd::software
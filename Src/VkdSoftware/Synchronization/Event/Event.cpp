@@ -0,0 +1,42 @@
+/**
+ * @file Event.cpp
+ * @brief Implementation of software renderer event
+ * @date 2026-10-16
+ */
+
+#include "VkdSoftware/Synchronization/Event/Event.hpp"
+
+namespace vkd::software
+{
+	Event::Event() :
+		m_state(0)
+	{
+	}
+
+	Event::~Event()
+	{
+		// A host thread that saw the event set may destroy it while Set still notifies
+		GetWaiters().WaitForSignalers();
+	}
+
+	VkResult Event::GetStatus()
+	{
+		return m_state.load(std::memory_order_seq_cst) ? VK_EVENT_SET : VK_EVENT_RESET;
+	}
+
+	VkResult Event::Set()
+	{
+		// Held until the last access to the event, its destructor waits for it
+		SyncWaiterList::SignalScope signalScope(GetWaiters());
+
+		m_state.store(1, std::memory_order_seq_cst);
+		GetWaiters().NotifyAll();
+		return VK_SUCCESS;
+	}
+
+	VkResult Event::Reset()
+	{
+		m_state.store(0, std::memory_order_release);
+		return VK_SUCCESS;
+	}
+} // namespace vkd::software
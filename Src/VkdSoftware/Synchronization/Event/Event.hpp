@@ -0,0 +1,33 @@
+/**
+ * @file Event.hpp
+ * @brief Software renderer event implementation
+ * @date 2026-10-16
+ *
+ * The state is an atomic flag. Waits matching a set recorded earlier in the same
+ * command buffer are resolved when the execution plan is built, a queue reaching
+ * one of the other ones while the event is not set suspends its drain on the
+ * event waiter list until Set notifies it.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include "Vkd/Synchronization/Event/Event.hpp"
+
+namespace vkd::software
+{
+	class Event : public vkd::Event
+	{
+	public:
+		Event();
+		~Event() override;
+
+		VkResult GetStatus() override;
+		VkResult Set() override;
+		VkResult Reset() override;
+
+	private:
+		std::atomic<UInt32> m_state;
+	};
+} // namespace vkd::software
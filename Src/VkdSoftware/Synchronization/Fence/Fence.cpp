@@ -6,11 +6,19 @@
 
 #include "VkdSoftware/Synchronization/Fence/Fence.hpp"
 
+#include "VkdUtils/Futex/Futex.hpp"
+
 namespace vkd::software
 {
 	Fence::Fence() :
-		m_signaled(false)
+		m_state(0)
+	{
+	}
+
+	Fence::~Fence()
 	{
+		// A thread that saw the fence signaled may destroy it while Signal still notifies
+		GetWaiters().WaitForSignalers();
 	}
 
 	VkResult Fence::Create(Device& owner, const VkFenceCreateInfo& createInfo)
@@ -18,7 +26,7 @@ namespace vkd::software
 		VKD_AUTO_PROFILER_SCOPE();
 
 		cct::EnumFlags<VkFenceCreateFlagBits> flags(createInfo.flags);
-		m_signaled = flags.Contains(VK_FENCE_CREATE_SIGNALED_BIT);
+		m_state.store(flags.Contains(VK_FENCE_CREATE_SIGNALED_BIT) ? SignaledBit : 0, std::memory_order_relaxed);
 
 		return vkd::Fence::Create(owner, createInfo);
 	}
@@ -27,54 +35,50 @@ namespace vkd::software
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		std::lock_guard _(m_mutex);
-		return m_signaled ? VK_SUCCESS : VK_NOT_READY;
+		return (m_state.load(std::memory_order_seq_cst) & SignaledBit) ? VK_SUCCESS : VK_NOT_READY;
 	}
 
 	VkResult Fence::Wait(uint64_t timeout)
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		using Clock = std::chrono::steady_clock;
-		std::unique_lock lock(m_mutex);
-
-		if (m_signaled)
+		if (m_state.load(std::memory_order_acquire) & SignaledBit)
 			return VK_SUCCESS;
 
 		if (timeout == 0)
 			return VK_TIMEOUT;
 
-		if (timeout == std::numeric_limits<uint64_t>::max())
+		const Futex::Clock::time_point deadline = Futex::GetDeadline(timeout);
+		while (true)
 		{
-			m_cv.wait(lock, [this]
-					  { return m_signaled; });
-			return VK_SUCCESS;
-		}
+			const UInt32 state = m_state.fetch_or(SleepersBit, std::memory_order_acq_rel) | SleepersBit;
+			if (state & SignaledBit)
+				return VK_SUCCESS;
 
-		const auto deadline = Clock::now() + std::chrono::nanoseconds(timeout);
-		if (!m_cv.wait_until(lock, deadline, [this]
-							 { return m_signaled; }))
-			return VK_TIMEOUT;
-
-		return VK_SUCCESS;
+			if (!Futex::Wait(m_state, state, deadline))
+				return (m_state.load(std::memory_order_acquire) & SignaledBit) ? VK_SUCCESS : VK_TIMEOUT;
+		}
 	}
 
 	VkResult Fence::Reset()
 	{
 		VKD_AUTO_PROFILER_SCOPE();
 
-		std::lock_guard _(m_mutex);
-		m_signaled = false;
+		// Sleepers are kept, the next Signal still has to wake them
+		m_state.fetch_and(~SignaledBit, std::memory_order_seq_cst);
 		return VK_SUCCESS;
 	}
 
 	VkResult Fence::Signal()
 	{
-		{
-			std::lock_guard _(m_mutex);
-			m_signaled = true;
-		}
-		m_cv.notify_all();
+		// Held until the last access to the fence, its destructor waits for it
+		SyncWaiterList::SignalScope signalScope(GetWaiters());
+
+		const UInt32 previous = m_state.exchange(SignaledBit, std::memory_order_seq_cst);
+		if (previous & SleepersBit)
+			Futex::WakeAll(m_state);
+
+		GetWaiters().NotifyAll();
 		return VK_SUCCESS;
 	}
 } // namespace vkd::software
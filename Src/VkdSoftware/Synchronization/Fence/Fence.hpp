@@ -3,13 +3,14 @@
  * @brief Software renderer fence implementation
  * @date 2025-10-25
  *
- * CPU-based fence synchronization using atomic operations.
+ * CPU-based fence synchronization using atomic operations. A thread waiting on the
+ * fence alone sleeps on its state word, threads waiting on several fences are
+ * registered in its waiter list.
  */
 
 #pragma once
 
-#include <condition_variable>
-#include <mutex>
+#include <atomic>
 
 #include "Vkd/Synchronization/Fence/Fence.hpp"
 
@@ -21,7 +22,7 @@ namespace vkd::software
 	{
 	public:
 		Fence();
-		~Fence() override = default;
+		~Fence() override;
 
 		VkResult Create(Device& owner, const VkFenceCreateInfo& createInfo) override;
 
@@ -31,8 +32,10 @@ namespace vkd::software
 		VkResult Signal() override;
 
 	private:
-		std::mutex m_mutex;
-		std::condition_variable m_cv;
-		bool m_signaled;
+		static constexpr UInt32 SignaledBit = 1 << 0;
+		/// Set by a thread about to sleep on the state word, Signal only wakes when it is set
+		static constexpr UInt32 SleepersBit = 1 << 1;
+
+		std::atomic<UInt32> m_state;
 	};
 } // namespace vkd::software
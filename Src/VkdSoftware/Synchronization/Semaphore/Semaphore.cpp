@@ -0,0 +1,66 @@
+/**
+ * @file Semaphore.cpp
+ * @brief Implementation of software renderer semaphore
+ * @date 2026-10-16
+ */
+
+#include "VkdSoftware/Synchronization/Semaphore/Semaphore.hpp"
+
+namespace vkd::software
+{
+	Semaphore::Semaphore() :
+		m_value(0),
+		m_binarySignalCount(0),
+		m_binaryWaitCount(0)
+	{
+	}
+
+	Semaphore::~Semaphore()
+	{
+		// A thread that saw the payload reached may destroy the semaphore while Signal still notifies
+		GetWaiters().WaitForSignalers();
+	}
+
+	VkResult Semaphore::Create(Device& owner, const VkSemaphoreCreateInfo& createInfo)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		VkResult result = vkd::Semaphore::Create(owner, createInfo);
+		if (result != VK_SUCCESS)
+			return result;
+
+		m_value.store(GetInitialValue(), std::memory_order_relaxed);
+		return VK_SUCCESS;
+	}
+
+	UInt64 Semaphore::GetCounterValue()
+	{
+		return m_value.load(std::memory_order_seq_cst);
+	}
+
+	VkResult Semaphore::Signal(UInt64 value)
+	{
+		VKD_AUTO_PROFILER_SCOPE();
+
+		// Held until the last access to the semaphore, its destructor waits for it
+		SyncWaiterList::SignalScope signalScope(GetWaiters());
+
+		UInt64 current = m_value.load(std::memory_order_relaxed);
+		while (current < value && !m_value.compare_exchange_weak(current, value, std::memory_order_seq_cst))
+		{
+		}
+
+		GetWaiters().NotifyAll();
+		return VK_SUCCESS;
+	}
+
+	UInt64 Semaphore::ReserveBinarySignal()
+	{
+		return m_binarySignalCount.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+
+	UInt64 Semaphore::ReserveBinaryWait()
+	{
+		return m_binaryWaitCount.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+} // namespace vkd::software
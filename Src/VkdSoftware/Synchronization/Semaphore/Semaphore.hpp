@@ -0,0 +1,41 @@
+/**
+ * @file Semaphore.hpp
+ * @brief Software renderer semaphore implementation
+ * @date 2026-10-16
+ *
+ * The payload is an atomic counter raised by queue drain tasks and host signals.
+ * Binary semaphores are lowered to the same counter: the nth wait submitted on a
+ * binary semaphore waits for the payload to reach n, which the nth signal submitted
+ * sets, so both kinds are resolved by the queues the same way.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include "Vkd/Synchronization/Semaphore/Semaphore.hpp"
+
+namespace vkd::software
+{
+	class Semaphore : public vkd::Semaphore
+	{
+	public:
+		Semaphore();
+		~Semaphore() override;
+
+		VkResult Create(Device& owner, const VkSemaphoreCreateInfo& createInfo) override;
+
+		UInt64 GetCounterValue() override;
+		VkResult Signal(UInt64 value) override;
+
+		/// Payload value a binary signal being submitted sets, submits are ordered by the application
+		UInt64 ReserveBinarySignal();
+		/// Payload value a binary wait being submitted waits for
+		UInt64 ReserveBinaryWait();
+
+	private:
+		std::atomic<UInt64> m_value;
+		std::atomic<UInt64> m_binarySignalCount;
+		std::atomic<UInt64> m_binaryWaitCount;
+	};
+} // namespace vkd::software
@@ -0,0 +1,126 @@
+/**
+ * @file Futex.cpp
+ * @brief Implementation of address-based wait and wake
+ * @date 2026-10-16
+ */
+
+#include "VkdUtils/Futex/Futex.hpp"
+
+#include <algorithm>
+#include <climits>
+
+#if defined(CCT_PLATFORM_WINDOWS)
+#define NOMINMAX
+#include <windows.h>
+#elif defined(CCT_PLATFORM_LINUX)
+#include <ctime>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#endif
+
+namespace vkd
+{
+	namespace
+	{
+#if defined(CCT_PLATFORM_LINUX)
+		long FutexCall(const std::atomic<UInt32>& word, int operation, UInt32 value, const timespec* timeout)
+		{
+			static_assert(sizeof(std::atomic<UInt32>) == sizeof(UInt32), "Futex words must be plain 32 bit integers");
+			return syscall(SYS_futex, reinterpret_cast<const UInt32*>(&word), operation | FUTEX_PRIVATE_FLAG, value, timeout, nullptr, 0);
+		}
+#elif !defined(CCT_PLATFORM_WINDOWS)
+		struct ParkingBucket
+		{
+			std::mutex Mutex;
+			std::condition_variable Condition;
+		};
+
+		ParkingBucket& GetParkingBucket(const void* address)
+		{
+			static ParkingBucket buckets[64];
+			return buckets[std::hash<const void*>{}(address) % std::size(buckets)];
+		}
+#endif
+	} // namespace
+
+	bool Futex::Wait(const std::atomic<UInt32>& word, UInt32 expected, Clock::time_point deadline)
+	{
+		const bool infinite = deadline == Clock::time_point::max();
+
+#if defined(CCT_PLATFORM_WINDOWS)
+		DWORD milliseconds = INFINITE;
+		if (!infinite)
+		{
+			const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - Clock::now()).count();
+			if (remaining <= 0)
+				return false;
+			milliseconds = static_cast<DWORD>(std::min<long long>(remaining, INFINITE - 1));
+		}
+
+		UInt32 compare = expected;
+		if (!WaitOnAddress(const_cast<std::atomic<UInt32>*>(&word), &compare, sizeof(compare), milliseconds))
+			return GetLastError() != ERROR_TIMEOUT || Clock::now() < deadline;
+		return true;
+#elif defined(CCT_PLATFORM_LINUX)
+		timespec timeout = {};
+		if (!infinite)
+		{
+			const auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - Clock::now()).count();
+			if (remaining <= 0)
+				return false;
+			timeout.tv_sec = static_cast<time_t>(remaining / 1'000'000'000);
+			timeout.tv_nsec = static_cast<long>(remaining % 1'000'000'000);
+		}
+
+		// A value that already changed or a signal interruption count as spurious wake-ups
+		FutexCall(word, FUTEX_WAIT, expected, infinite ? nullptr : &timeout);
+		return infinite || Clock::now() < deadline;
+#else
+		ParkingBucket& bucket = GetParkingBucket(&word);
+		std::unique_lock lock(bucket.Mutex);
+		if (word.load(std::memory_order_acquire) != expected)
+			return true;
+
+		if (infinite)
+		{
+			bucket.Condition.wait(lock);
+			return true;
+		}
+		return bucket.Condition.wait_until(lock, deadline) == std::cv_status::no_timeout;
+#endif
+	}
+
+	void Futex::WakeOne(std::atomic<UInt32>& word)
+	{
+#if defined(CCT_PLATFORM_WINDOWS)
+		WakeByAddressSingle(&word);
+#elif defined(CCT_PLATFORM_LINUX)
+		FutexCall(word, FUTEX_WAKE, 1, nullptr);
+#else
+		// Buckets are shared between addresses, the one woken could be waiting on another word
+		WakeAll(word);
+#endif
+	}
+
+	void Futex::WakeAll(std::atomic<UInt32>& word)
+	{
+#if defined(CCT_PLATFORM_WINDOWS)
+		WakeByAddressAll(&word);
+#elif defined(CCT_PLATFORM_LINUX)
+		FutexCall(word, FUTEX_WAKE, INT_MAX, nullptr);
+#else
+		// Taking the lock orders the wake after a waiter that checked the word and is about to sleep
+		ParkingBucket& bucket = GetParkingBucket(&word);
+		{
+			std::lock_guard lock(bucket.Mutex);
+		}
+		bucket.Condition.notify_all();
+#endif
+	}
+} // namespace vkd
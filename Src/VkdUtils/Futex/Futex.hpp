@@ -0,0 +1,45 @@
+/**
+ * @file Futex.hpp
+ * @brief Address-based wait and wake with a deadline
+ * @date 2026-10-16
+ *
+ * std::atomic::wait cannot time out, Vulkan waits can. Futex sleeps on a 32 bit word
+ * through futex on Linux and WaitOnAddress on Windows, other platforms park on a
+ * condition variable picked by hashing the address.
+ *
+ * Like the underlying primitives, a wait may return spuriously, callers re-check
+ * the condition they are waiting for.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+#include <Concerto/Core/Types/Types.hpp>
+
+namespace vkd
+{
+	using namespace cct;
+
+	class Futex
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		Futex() = delete;
+
+		/// Sleeps while word holds expected, Clock::time_point::max() waits without deadline
+		/// @return false once the deadline passed
+		static bool Wait(const std::atomic<UInt32>& word, UInt32 expected, Clock::time_point deadline);
+		static inline void Wait(const std::atomic<UInt32>& word, UInt32 expected);
+
+		static void WakeOne(std::atomic<UInt32>& word);
+		static void WakeAll(std::atomic<UInt32>& word);
+
+		/// Deadline of a Vulkan timeout in nanoseconds, UINT64_MAX meaning none
+		[[nodiscard]] static inline Clock::time_point GetDeadline(UInt64 timeoutNs);
+	};
+} // namespace vkd
+
+#include "VkdUtils/Futex/Futex.inl"
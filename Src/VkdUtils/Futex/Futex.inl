@@ -0,0 +1,28 @@
+/**
+ * @file Futex.inl
+ * @brief Inline implementations for Futex
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include <limits>
+
+#include "VkdUtils/Futex/Futex.hpp"
+
+namespace vkd
+{
+	inline void Futex::Wait(const std::atomic<UInt32>& word, UInt32 expected)
+	{
+		Wait(word, expected, Clock::time_point::max());
+	}
+
+	inline Futex::Clock::time_point Futex::GetDeadline(UInt64 timeoutNs)
+	{
+		const Clock::time_point now = Clock::now();
+		const auto maxTimeout = static_cast<UInt64>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::time_point::max() - now).count());
+		if (timeoutNs >= maxTimeout)
+			return Clock::time_point::max();
+		return now + std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(timeoutNs));
+	}
+} // namespace vkd
@@ -0,0 +1,227 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Implementation of memory-mapped file access
+ * @date 2026-10-16
+ */
+
+#include "VkdUtils/MappedFile/MappedFile.hpp"
+
+#include <utility>
+
+#if defined(CCT_PLATFORM_WINDOWS)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vkd
+{
+	namespace
+	{
+#if defined(CCT_PLATFORM_WINDOWS)
+		bool SetFileSize(void* file, std::size_t size)
+		{
+			LARGE_INTEGER distance;
+			distance.QuadPart = static_cast<LONGLONG>(size);
+			return SetFilePointerEx(file, distance, nullptr, FILE_BEGIN) && SetEndOfFile(file);
+		}
+#else
+		bool SetFileSize(int file, std::size_t size)
+		{
+			return ftruncate(file, static_cast<off_t>(size)) == 0;
+		}
+#endif
+	} // namespace
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		Close();
+
+		m_file = std::exchange(other.m_file, decltype(m_file){});
+#if defined(CCT_PLATFORM_WINDOWS)
+		m_mapping = std::exchange(other.m_mapping, nullptr);
+#else
+		other.m_file = -1;
+#endif
+		m_data = std::exchange(other.m_data, nullptr);
+		m_size = std::exchange(other.m_size, 0);
+		m_writable = std::exchange(other.m_writable, false);
+		m_open = std::exchange(other.m_open, false);
+		return *this;
+	}
+
+	bool MappedFile::Open(const std::string& path)
+	{
+		Close();
+
+#if defined(CCT_PLATFORM_WINDOWS)
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size))
+		{
+			CloseHandle(file);
+			return false;
+		}
+		m_file = file;
+		m_size = static_cast<std::size_t>(size.QuadPart);
+#else
+		int file = open(path.c_str(), O_RDONLY);
+		if (file < 0)
+			return false;
+
+		struct stat status = {};
+		if (fstat(file, &status) != 0)
+		{
+			close(file);
+			return false;
+		}
+		m_file = file;
+		m_size = static_cast<std::size_t>(status.st_size);
+#endif
+
+		m_writable = false;
+		m_open = true;
+		if (!Map())
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	bool MappedFile::Create(const std::string& path, std::size_t size)
+	{
+		Close();
+
+#if defined(CCT_PLATFORM_WINDOWS)
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+#else
+		int file = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+		if (file < 0)
+			return false;
+#endif
+		m_file = file;
+		m_writable = true;
+		m_open = true;
+
+		if (!SetFileSize(m_file, size))
+		{
+			Close();
+			return false;
+		}
+
+		m_size = size;
+		if (!Map())
+		{
+			Close();
+			return false;
+		}
+		return true;
+	}
+
+	bool MappedFile::Resize(std::size_t size)
+	{
+		if (!m_open || !m_writable)
+			return false;
+
+		Unmap();
+		if (!SetFileSize(m_file, size))
+			return false;
+
+		m_size = size;
+		return Map();
+	}
+
+	void MappedFile::Close(std::size_t size)
+	{
+		if (m_open && m_writable)
+		{
+			Unmap();
+			SetFileSize(m_file, size);
+		}
+		Close();
+	}
+
+	void MappedFile::Close()
+	{
+		if (!m_open)
+			return;
+
+		Unmap();
+#if defined(CCT_PLATFORM_WINDOWS)
+		CloseHandle(m_file);
+		m_file = nullptr;
+#else
+		close(m_file);
+		m_file = -1;
+#endif
+		m_size = 0;
+		m_writable = false;
+		m_open = false;
+	}
+
+	bool MappedFile::Map()
+	{
+		// Empty files cannot be mapped, they are simply exposed as an empty range
+		if (m_size == 0)
+			return true;
+
+#if defined(CCT_PLATFORM_WINDOWS)
+		const UInt64 size = m_size;
+		m_mapping = CreateFileMappingA(m_file, nullptr, m_writable ? PAGE_READWRITE : PAGE_READONLY, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size), nullptr);
+		if (!m_mapping)
+			return false;
+
+		m_data = static_cast<std::byte*>(MapViewOfFile(m_mapping, m_writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, m_size));
+		if (!m_data)
+		{
+			CloseHandle(m_mapping);
+			m_mapping = nullptr;
+			return false;
+		}
+#else
+		void* data = mmap(nullptr, m_size, m_writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, m_file, 0);
+		if (data == MAP_FAILED)
+			return false;
+		m_data = static_cast<std::byte*>(data);
+#endif
+		return true;
+	}
+
+	void MappedFile::Unmap()
+	{
+		if (!m_data)
+			return;
+
+#if defined(CCT_PLATFORM_WINDOWS)
+		UnmapViewOfFile(m_data);
+		CloseHandle(m_mapping);
+		m_mapping = nullptr;
+#else
+		munmap(m_data, m_size);
+#endif
+		m_data = nullptr;
+	}
+} // namespace vkd
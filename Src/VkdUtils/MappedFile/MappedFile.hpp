@@ -0,0 +1,66 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Memory-mapped file access
+ * @date 2026-10-16
+ *
+ * Maps a whole file in the address space, either read-only or writable. Writable
+ * files can be grown, the mapping is recreated so previously returned pointers
+ * must not be kept across a Resize.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <Concerto/Core/Types/Types.hpp>
+
+namespace vkd
+{
+	using namespace cct;
+
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		MappedFile(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		~MappedFile();
+
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		/// Maps an existing file read-only
+		bool Open(const std::string& path);
+		/// Creates or truncates a file and maps size bytes of it writable
+		bool Create(const std::string& path, std::size_t size);
+		/// Grows or shrinks a writable mapping, the file is resized accordingly
+		bool Resize(std::size_t size);
+		/// Unmaps and closes the file, a writable file is truncated to size bytes first
+		void Close(std::size_t size);
+		void Close();
+
+		[[nodiscard]] inline bool IsOpen() const;
+		[[nodiscard]] inline bool IsWritable() const;
+		[[nodiscard]] inline std::byte* GetData();
+		[[nodiscard]] inline const std::byte* GetData() const;
+		[[nodiscard]] inline std::size_t GetSize() const;
+
+	private:
+		bool Map();
+		void Unmap();
+
+#if defined(CCT_PLATFORM_WINDOWS)
+		void* m_file = nullptr;
+		void* m_mapping = nullptr;
+#else
+		int m_file = -1;
+#endif
+		std::byte* m_data = nullptr;
+		std::size_t m_size = 0;
+		bool m_writable = false;
+		bool m_open = false;
+	};
+} // namespace vkd
+
+#include "VkdUtils/MappedFile/MappedFile.inl"
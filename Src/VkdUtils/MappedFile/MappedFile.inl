@@ -0,0 +1,37 @@
+/**
+ * @file MappedFile.inl
+ * @brief Inline implementations for MappedFile
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include "VkdUtils/MappedFile/MappedFile.hpp"
+
+namespace vkd
+{
+	inline bool MappedFile::IsOpen() const
+	{
+		return m_open;
+	}
+
+	inline bool MappedFile::IsWritable() const
+	{
+		return m_writable;
+	}
+
+	inline std::byte* MappedFile::GetData()
+	{
+		return m_data;
+	}
+
+	inline const std::byte* MappedFile::GetData() const
+	{
+		return m_data;
+	}
+
+	inline std::size_t MappedFile::GetSize() const
+	{
+		return m_size;
+	}
+} // namespace vkd
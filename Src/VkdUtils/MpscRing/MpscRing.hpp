@@ -0,0 +1,61 @@
+/**
+ * @file MpscRing.hpp
+ * @brief Bounded lock-free multi-producer single-consumer ring
+ * @date 2026-10-16
+ *
+ * Each slot carries a sequence number telling whether it is free for the producer
+ * of a given lap or holds a value for the consumer, so producers only contend on
+ * the tail index and the consumer never takes a lock. A producer that reserved a
+ * slot but has not published it yet holds back the values pushed after it.
+ *
+ * Only one thread may pop at a time. The consumer role may move between threads
+ * provided the hand-over is synchronized by the caller.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include <Concerto/Core/Types/Types.hpp>
+
+namespace vkd
+{
+	using namespace cct;
+
+	template<typename T>
+	class MpscRing
+	{
+	public:
+		/// Capacity is rounded up to a power of two
+		explicit MpscRing(std::size_t capacity);
+		~MpscRing() = default;
+
+		MpscRing(const MpscRing&) = delete;
+		MpscRing& operator=(const MpscRing&) = delete;
+
+		/// Thread-safe, fails when the ring is full
+		bool TryPush(T value);
+		/// Consumer only, fails when the next value is not published yet
+		bool TryPop(T& value);
+
+		[[nodiscard]] inline std::size_t GetCapacity() const;
+
+	private:
+		static constexpr std::size_t CacheLineSize = 64;
+
+		struct Cell
+		{
+			std::atomic<std::size_t> Sequence;
+			T Value;
+		};
+
+		std::vector<Cell> m_cells;
+		std::size_t m_mask;
+		alignas(CacheLineSize) std::atomic<std::size_t> m_tail;
+		alignas(CacheLineSize) std::size_t m_head;
+	};
+} // namespace vkd
+
+#include "VkdUtils/MpscRing/MpscRing.inl"
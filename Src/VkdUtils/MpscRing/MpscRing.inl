@@ -0,0 +1,72 @@
+/**
+ * @file MpscRing.inl
+ * @brief Inline implementations for MpscRing
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include <bit>
+#include <utility>
+
+#include "VkdUtils/MpscRing/MpscRing.hpp"
+
+namespace vkd
+{
+	template<typename T>
+	MpscRing<T>::MpscRing(std::size_t capacity) :
+		m_cells(std::bit_ceil(capacity < 2 ? std::size_t(2) : capacity)),
+		m_mask(m_cells.size() - 1),
+		m_tail(0),
+		m_head(0)
+	{
+		for (std::size_t i = 0; i < m_cells.size(); ++i)
+			m_cells[i].Sequence.store(i, std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	bool MpscRing<T>::TryPush(T value)
+	{
+		std::size_t position = m_tail.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true)
+		{
+			cell = &m_cells[position & m_mask];
+			const std::size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+			const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+			if (difference == 0)
+			{
+				if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (difference < 0)
+				return false; // The consumer has not freed this slot yet
+			else
+				position = m_tail.load(std::memory_order_relaxed);
+		}
+
+		cell->Value = std::move(value);
+		cell->Sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	bool MpscRing<T>::TryPop(T& value)
+	{
+		Cell& cell = m_cells[m_head & m_mask];
+		if (cell.Sequence.load(std::memory_order_acquire) != m_head + 1)
+			return false;
+
+		value = std::move(cell.Value);
+		// Frees the slot for the producers of the next lap
+		cell.Sequence.store(m_head + m_mask + 1, std::memory_order_release);
+		++m_head;
+		return true;
+	}
+
+	template<typename T>
+	inline std::size_t MpscRing<T>::GetCapacity() const
+	{
+		return m_cells.size();
+	}
+} // namespace vkd
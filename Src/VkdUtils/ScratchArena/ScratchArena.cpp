@@ -0,0 +1,110 @@
+/**
+ * @file ScratchArena.cpp
+ * @brief Implementation of the linear scratch allocator
+ * @date 2026-10-16
+ */
+
+#include "VkdUtils/ScratchArena/ScratchArena.hpp"
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+namespace vkd
+{
+	ScratchArena::ScratchArena(std::size_t initialSize) :
+		m_offset(0),
+		m_previousBlocksUsed(0),
+		m_capacity(0)
+	{
+		if (initialSize != 0)
+			AddBlock(initialSize);
+	}
+
+	ScratchArena::ScratchArena(ScratchArena&& other) noexcept :
+		m_blocks(std::move(other.m_blocks)),
+		m_offset(std::exchange(other.m_offset, 0)),
+		m_previousBlocksUsed(std::exchange(other.m_previousBlocksUsed, 0)),
+		m_capacity(std::exchange(other.m_capacity, 0))
+	{
+		other.m_blocks.clear();
+	}
+
+	ScratchArena::~ScratchArena()
+	{
+		Release();
+	}
+
+	ScratchArena& ScratchArena::operator=(ScratchArena&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+			m_blocks = std::move(other.m_blocks);
+			other.m_blocks.clear();
+			m_offset = std::exchange(other.m_offset, 0);
+			m_previousBlocksUsed = std::exchange(other.m_previousBlocksUsed, 0);
+			m_capacity = std::exchange(other.m_capacity, 0);
+		}
+		return *this;
+	}
+
+	void* ScratchArena::Allocate(std::size_t size, std::size_t alignment)
+	{
+		if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > BlockAlignment)
+			return nullptr;
+
+		if (!m_blocks.empty())
+		{
+			const Block& block = m_blocks.back();
+			const std::size_t offset = (m_offset + alignment - 1) & ~(alignment - 1);
+			if (offset + size <= block.Size)
+			{
+				m_offset = offset + size;
+				return block.Data + offset;
+			}
+		}
+
+		// Blocks start aligned to BlockAlignment, the allocation goes at the start of the new one
+		const std::size_t lastSize = m_blocks.empty() ? 0 : m_blocks.back().Size;
+		AddBlock(std::max({size, lastSize * 2, MinBlockSize}));
+		m_offset = size;
+		return m_blocks.back().Data;
+	}
+
+	void ScratchArena::Reset()
+	{
+		if (m_blocks.size() > 1)
+		{
+			// Sized for everything the arena held, the same workload fits a single block next time
+			const std::size_t capacity = m_capacity;
+			Release();
+			AddBlock(capacity);
+		}
+
+		m_offset = 0;
+		m_previousBlocksUsed = 0;
+	}
+
+	void ScratchArena::AddBlock(std::size_t size)
+	{
+		if (!m_blocks.empty())
+			m_previousBlocksUsed += m_offset;
+
+		auto* data = static_cast<std::byte*>(::operator new(size, std::align_val_t{BlockAlignment}));
+		m_blocks.push_back(Block{data, size});
+		m_capacity += size;
+		m_offset = 0;
+	}
+
+	void ScratchArena::Release()
+	{
+		for (const Block& block : m_blocks)
+			::operator delete(block.Data, std::align_val_t{BlockAlignment});
+
+		m_blocks.clear();
+		m_offset = 0;
+		m_previousBlocksUsed = 0;
+		m_capacity = 0;
+	}
+} // namespace vkd
@@ -0,0 +1,70 @@
+/**
+ * @file ScratchArena.hpp
+ * @brief Linear scratch allocator reset as a whole
+ * @date 2026-10-16
+ *
+ * Allocations bump an offset in the current block, a new block twice as large is
+ * chained when it runs out. Reset releases every allocation at once and merges the
+ * blocks into a single one sized for the peak usage, so an arena serving the same
+ * workload again stops allocating after its first use.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <Concerto/Core/Types/Types.hpp>
+
+namespace vkd
+{
+	using namespace cct;
+
+	class ScratchArena
+	{
+	public:
+		static constexpr std::size_t MinBlockSize = 64 * 1024;
+		static constexpr std::size_t BlockAlignment = 64;
+
+		explicit ScratchArena(std::size_t initialSize = 0);
+		ScratchArena(const ScratchArena&) = delete;
+		ScratchArena(ScratchArena&& other) noexcept;
+		~ScratchArena();
+
+		ScratchArena& operator=(const ScratchArena&) = delete;
+		ScratchArena& operator=(ScratchArena&& other) noexcept;
+
+		/// Returns nullptr unless alignment is a power of two no larger than BlockAlignment
+		[[nodiscard]] void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+		/// Storage is left uninitialized, only meant for types needing no destruction
+		template<typename T>
+		[[nodiscard]] std::span<T> AllocateArray(std::size_t count);
+
+		/// Releases every allocation, previously returned pointers must not be used anymore
+		void Reset();
+
+		[[nodiscard]] inline std::size_t GetUsed() const;
+		[[nodiscard]] inline std::size_t GetCapacity() const;
+		[[nodiscard]] inline std::size_t GetBlockCount() const;
+
+	private:
+		struct Block
+		{
+			std::byte* Data;
+			std::size_t Size;
+		};
+
+		void AddBlock(std::size_t size);
+		void Release();
+
+		std::vector<Block> m_blocks;
+		std::size_t m_offset;
+		/// Bytes allocated from the blocks before the current one
+		std::size_t m_previousBlocksUsed;
+		std::size_t m_capacity;
+	};
+} // namespace vkd
+
+#include "VkdUtils/ScratchArena/ScratchArena.inl"
@@ -0,0 +1,38 @@
+/**
+ * @file ScratchArena.inl
+ * @brief Inline implementations for ScratchArena
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include "VkdUtils/ScratchArena/ScratchArena.hpp"
+
+namespace vkd
+{
+	template<typename T>
+	std::span<T> ScratchArena::AllocateArray(std::size_t count)
+	{
+		static_assert(std::is_trivially_destructible_v<T>, "Arena storage is released without running destructors");
+		static_assert(alignof(T) <= BlockAlignment, "Type alignment is larger than the block alignment");
+
+		if (count == 0)
+			return {};
+		return {static_cast<T*>(Allocate(count * sizeof(T), alignof(T))), count};
+	}
+
+	inline std::size_t ScratchArena::GetUsed() const
+	{
+		return m_previousBlocksUsed + m_offset;
+	}
+
+	inline std::size_t ScratchArena::GetCapacity() const
+	{
+		return m_capacity;
+	}
+
+	inline std::size_t ScratchArena::GetBlockCount() const
+	{
+		return m_blocks.size();
+	}
+} // namespace vkd
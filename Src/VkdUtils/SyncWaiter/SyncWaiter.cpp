@@ -0,0 +1,82 @@
+/**
+ * @file SyncWaiter.cpp
+ * @brief Implementation of the synchronization waiter list
+ * @date 2026-10-16
+ */
+
+#include "VkdUtils/SyncWaiter/SyncWaiter.hpp"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace vkd
+{
+	void SyncWaiterList::Add(SyncWaiter& waiter)
+	{
+		std::lock_guard lock(m_mutex);
+		m_waiters.push_back(&waiter);
+		// Sequentially consistent with the owner state: either NotifyAll sees the waiter
+		// or the waiter sees the new state when it evaluates its condition
+		m_waiterCount.fetch_add(1, std::memory_order_seq_cst);
+	}
+
+	void SyncWaiterList::Remove(SyncWaiter& waiter)
+	{
+		std::lock_guard lock(m_mutex);
+		auto it = std::find(m_waiters.begin(), m_waiters.end(), &waiter);
+		if (it == m_waiters.end())
+			return;
+
+		*it = m_waiters.back();
+		m_waiters.pop_back();
+		m_waiterCount.fetch_sub(1, std::memory_order_seq_cst);
+	}
+
+	void SyncWaiterList::NotifyAll()
+	{
+		if (m_waiterCount.load(std::memory_order_seq_cst) == 0)
+			return;
+
+		SyncWaiter* ready = nullptr;
+		{
+			// Notifying under the lock keeps a waiter from being removed, and destroyed, meanwhile
+			std::lock_guard lock(m_mutex);
+			for (std::size_t i = 0; i < m_waiters.size();)
+			{
+				SyncWaiter* waiter = m_waiters[i];
+				if (!waiter->m_callbacks)
+				{
+					waiter->Notify();
+					++i;
+					continue;
+				}
+
+				if (!waiter->m_callbacks->IsReady(*waiter))
+				{
+					++i;
+					continue;
+				}
+
+				m_waiters[i] = m_waiters.back();
+				m_waiters.pop_back();
+				m_waiterCount.fetch_sub(1, std::memory_order_seq_cst);
+				waiter->m_nextReady = ready;
+				ready = waiter;
+			}
+		}
+
+		// Resumed waiters may register again or be destroyed, neither needs the lock held
+		while (ready)
+		{
+			SyncWaiter* waiter = std::exchange(ready, ready->m_nextReady);
+			waiter->m_callbacks->Resume(*waiter);
+		}
+	}
+
+	void SyncWaiterList::WaitForSignalers() const
+	{
+		while (m_signalerCount.load(std::memory_order_acquire) != 0)
+			std::this_thread::yield();
+	}
+} // namespace vkd
@@ -0,0 +1,116 @@
+/**
+ * @file SyncWaiter.hpp
+ * @brief Waiting on several synchronization objects at once
+ * @date 2026-10-16
+ *
+ * A SyncWaiter belongs to a waiting thread and is registered in the SyncWaiterList
+ * of every object it waits on. Each notification bumps its epoch, so the thread
+ * sleeps once on its own word and wakes as soon as any of the objects changes,
+ * whatever condition it evaluates over them.
+ *
+ * The waiter registers before evaluating its condition. Objects update their state
+ * before notifying, so a change either is seen by the evaluation or wakes the waiter.
+ *
+ * A host thread seeing the new state may destroy the object while the signaling thread
+ * is still notifying. Signalers hold a SignalScope across the change and its
+ * notification, and the owner calls WaitForSignalers before it is destroyed.
+ *
+ * A waiter that is not a blocked thread, such as a suspended coroutine, is given
+ * callbacks instead. NotifyAll evaluates it under the list lock, unregisters it once
+ * it is ready, and resumes it after releasing the lock.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <mutex>
+#include <ranges>
+#include <vector>
+
+#include "VkdUtils/Futex/Futex.hpp"
+
+namespace vkd
+{
+	class SyncWaiter;
+	class SyncWaiterList;
+
+	struct SyncWaiterCallbacks
+	{
+		/// Called under the list lock on every notification, true unregisters the waiter
+		bool (*IsReady)(SyncWaiter& waiter);
+		/// Called once the waiter was unregistered, outside of the list lock
+		void (*Resume)(SyncWaiter& waiter);
+	};
+
+	class SyncWaiter
+	{
+	public:
+		SyncWaiter() = default;
+		explicit inline SyncWaiter(const SyncWaiterCallbacks& callbacks);
+		SyncWaiter(const SyncWaiter&) = delete;
+		SyncWaiter& operator=(const SyncWaiter&) = delete;
+
+		/// Epoch to pass to Wait, read before evaluating the condition
+		[[nodiscard]] inline UInt32 GetEpoch() const;
+		/// Sleeps until notified after epoch was read
+		/// @return false once the deadline passed
+		inline bool Wait(UInt32 epoch, Futex::Clock::time_point deadline) const;
+		inline void Notify();
+
+		/**
+		 * @brief Waits until condition holds, evaluated again whenever one of lists is notified.
+		 *
+		 * A single waiter is registered on every list before the first evaluation and removed
+		 * before returning, so condition may read the owners of the lists from any state.
+		 * @return false once the deadline passed with condition still false
+		 */
+		template<std::ranges::forward_range Lists, typename Condition>
+			requires std::convertible_to<std::ranges::range_reference_t<Lists>, SyncWaiterList&> && std::predicate<Condition&>
+		static bool WaitUntil(Lists&& lists, Futex::Clock::time_point deadline, Condition&& condition);
+
+	private:
+		friend class SyncWaiterList;
+
+		std::atomic<UInt32> m_epoch = 0;
+		const SyncWaiterCallbacks* m_callbacks = nullptr;
+		/// Next waiter NotifyAll resumes once the lock is released
+		SyncWaiter* m_nextReady = nullptr;
+	};
+
+	class SyncWaiterList
+	{
+	public:
+		/// Counts the calling thread as a signaler of the owner until destroyed
+		class SignalScope
+		{
+		public:
+			explicit inline SignalScope(SyncWaiterList& list);
+			inline ~SignalScope();
+			SignalScope(const SignalScope&) = delete;
+			SignalScope& operator=(const SignalScope&) = delete;
+
+		private:
+			SyncWaiterList& m_list;
+		};
+
+		SyncWaiterList() = default;
+		SyncWaiterList(const SyncWaiterList&) = delete;
+		SyncWaiterList& operator=(const SyncWaiterList&) = delete;
+
+		void Add(SyncWaiter& waiter);
+		void Remove(SyncWaiter& waiter);
+		/// Called after the owner state changed, skips locking while nobody waits
+		void NotifyAll();
+		/// Returns once no SignalScope is left, signalers only hold one while notifying
+		void WaitForSignalers() const;
+
+	private:
+		std::mutex m_mutex;
+		std::vector<SyncWaiter*> m_waiters;
+		std::atomic<UInt32> m_waiterCount = 0;
+		std::atomic<UInt32> m_signalerCount = 0;
+	};
+} // namespace vkd
+
+#include "VkdUtils/SyncWaiter/SyncWaiter.inl"
@@ -0,0 +1,76 @@
+/**
+ * @file SyncWaiter.inl
+ * @brief Inline implementations for SyncWaiter
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include "VkdUtils/SyncWaiter/SyncWaiter.hpp"
+
+namespace vkd
+{
+	inline SyncWaiter::SyncWaiter(const SyncWaiterCallbacks& callbacks) :
+		m_callbacks(&callbacks)
+	{
+	}
+
+	inline UInt32 SyncWaiter::GetEpoch() const
+	{
+		return m_epoch.load(std::memory_order_seq_cst);
+	}
+
+	inline bool SyncWaiter::Wait(UInt32 epoch, Futex::Clock::time_point deadline) const
+	{
+		return Futex::Wait(m_epoch, epoch, deadline);
+	}
+
+	inline void SyncWaiter::Notify()
+	{
+		m_epoch.fetch_add(1, std::memory_order_seq_cst);
+		Futex::WakeOne(m_epoch);
+	}
+
+	template<std::ranges::forward_range Lists, typename Condition>
+		requires std::convertible_to<std::ranges::range_reference_t<Lists>, SyncWaiterList&> && std::predicate<Condition&>
+	bool SyncWaiter::WaitUntil(Lists&& lists, Futex::Clock::time_point deadline, Condition&& condition)
+	{
+		// Whichever list gets notified wakes the waiter to evaluate again
+		SyncWaiter waiter;
+		for (SyncWaiterList& list : lists)
+			list.Add(waiter);
+
+		bool satisfied;
+		while (true)
+		{
+			const UInt32 epoch = waiter.GetEpoch();
+			satisfied = condition();
+			if (satisfied)
+				break;
+
+			if (!waiter.Wait(epoch, deadline))
+			{
+				satisfied = condition();
+				break;
+			}
+		}
+
+		for (SyncWaiterList& list : lists)
+			list.Remove(waiter);
+
+		return satisfied;
+	}
+
+	inline SyncWaiterList::SignalScope::SignalScope(SyncWaiterList& list) :
+		m_list(list)
+	{
+		// Ordered before the state change the scope covers, which the destroying thread observed
+		m_list.m_signalerCount.fetch_add(1, std::memory_order_seq_cst);
+	}
+
+	inline SyncWaiterList::SignalScope::~SignalScope()
+	{
+		// Last access to the owner, it may be destroyed right after
+		m_list.m_signalerCount.fetch_sub(1, std::memory_order_release);
+	}
+} // namespace vkd
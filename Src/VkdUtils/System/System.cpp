@@ -6,12 +6,24 @@
 
 #include "VkdUtils/System/System.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <thread>
+#include <utility>
+
 #if defined(CCT_PLATFORM_WINDOWS)
 #define NOMINMAX
 #include <windows.h>
 #elif defined(CCT_PLATFORM_LINUX)
 #include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
 
+#include <sys/syscall.h>
 #include <sys/sysinfo.h>
 #elif defined(CCT_PLATFORM_FREEBSD) || defined(CCT_PLATFORM_MACOS)
 #include <pthread.h>
@@ -82,7 +94,42 @@ namespace vkd
 #endif
 		}
 
+		std::optional<std::string> ReadFirstLine(const std::filesystem::path& path)
+		{
+			std::ifstream file(path);
+			std::string line;
+			if (!file || !std::getline(file, line))
+				return std::nullopt;
+			return line;
+		}
+
+		std::optional<UInt32> ReadUInt(const std::filesystem::path& path)
+		{
+			std::optional<std::string> line = ReadFirstLine(path);
+			if (!line)
+				return std::nullopt;
+
+			UInt32 value = 0;
+			const auto [end, error] = std::from_chars(line->data(), line->data() + line->size(), value);
+			if (error != std::errc())
+				return std::nullopt;
+			return value;
+		}
+
+		/// Lowest CPU of a sysfs CPU list file
+		std::optional<UInt32> ReadFirstCpu(const std::filesystem::path& path)
+		{
+			std::optional<std::string> line = ReadFirstLine(path);
+			if (!line)
+				return std::nullopt;
+
+			const std::vector<UInt32> cpus = System::ParseCpuList(*line);
+			if (cpus.empty())
+				return std::nullopt;
+			return cpus.front();
+		}
 	} // namespace
+
 	UInt64 System::GetTotalRamBytes()
 	{
 		if (!m_totalRamBytes.has_value())
@@ -137,4 +184,227 @@ namespace vkd
 		pthread_set_name_np(pthread_self(), name.c_str());
 #endif
 	}
+
+	void System::CpuRelax() noexcept
+	{
+#if defined(CCT_PLATFORM_WINDOWS)
+		YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+		__asm__ __volatile__("yield");
+#endif
+	}
+
+	CpuTopology System::QueryCpuTopology()
+	{
+		std::vector<UInt32> cpus;
+#if defined(CCT_PLATFORM_LINUX)
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		if (sched_getaffinity(0, sizeof(set), &set) == 0)
+		{
+			for (UInt32 cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+			{
+				if (CPU_ISSET(cpu, &set))
+					cpus.push_back(cpu);
+			}
+		}
+#endif
+		if (cpus.empty())
+		{
+			const UInt32 count = std::max(std::thread::hardware_concurrency(), 1u);
+			for (UInt32 cpu = 0; cpu < count; ++cpu)
+				cpus.push_back(cpu);
+		}
+
+#if defined(CCT_PLATFORM_LINUX)
+		return ReadCpuTopology("/sys/devices/system", cpus);
+#else
+		return ReadCpuTopology({}, cpus);
+#endif
+	}
+
+	CpuTopology System::ReadCpuTopology(const std::filesystem::path& sysfsRoot, std::span<const UInt32> cpus)
+	{
+		CpuTopology topology;
+		std::map<std::pair<UInt32, UInt32>, UInt32> coreIds;
+
+		for (UInt32 id : cpus)
+		{
+			CpuInfo cpu;
+			cpu.Id = id;
+			cpu.L2Group = id;
+			cpu.L3Group = id;
+
+			const std::filesystem::path cpuPath = sysfsRoot.empty() ? std::filesystem::path() : sysfsRoot / "cpu" / ("cpu" + std::to_string(id));
+			UInt32 physicalCore = id;
+			if (!cpuPath.empty())
+			{
+				const std::filesystem::path topologyPath = cpuPath / "topology";
+				physicalCore = ReadUInt(topologyPath / "core_id").value_or(id);
+				cpu.PackageId = ReadUInt(topologyPath / "physical_package_id").value_or(0);
+
+				if (std::optional<std::string> siblings = ReadFirstLine(topologyPath / "thread_siblings_list"))
+				{
+					const std::vector<UInt32> siblingCpus = ParseCpuList(*siblings);
+					const auto it = std::find(siblingCpus.begin(), siblingCpus.end(), id);
+					if (it != siblingCpus.end())
+						cpu.SmtIndex = static_cast<UInt32>(it - siblingCpus.begin());
+				}
+
+				std::error_code error;
+				for (const auto& entry : std::filesystem::directory_iterator(cpuPath, error))
+				{
+					const std::string name = entry.path().filename().string();
+					UInt32 node = 0;
+					if (name.size() > 4 && name.starts_with("node") && std::from_chars(name.data() + 4, name.data() + name.size(), node).ec == std::errc())
+						cpu.NumaNode = node;
+				}
+
+				for (UInt32 index = 0;; ++index)
+				{
+					const std::filesystem::path cachePath = cpuPath / "cache" / ("index" + std::to_string(index));
+					const std::optional<UInt32> level = ReadUInt(cachePath / "level");
+					if (!level)
+						break;
+
+					const std::optional<UInt32> group = ReadFirstCpu(cachePath / "shared_cpu_list");
+					if (*level == 2 && group)
+						cpu.L2Group = *group;
+					else if (*level == 3 && group)
+						cpu.L3Group = *group;
+				}
+			}
+
+			// core_id is only unique within a package
+			const auto [it, inserted] = coreIds.try_emplace({cpu.PackageId, physicalCore}, static_cast<UInt32>(coreIds.size()));
+			cpu.CoreId = it->second;
+
+			if (std::find(topology.NumaNodes.begin(), topology.NumaNodes.end(), cpu.NumaNode) == topology.NumaNodes.end())
+				topology.NumaNodes.push_back(cpu.NumaNode);
+			topology.Cpus.push_back(cpu);
+		}
+
+		std::sort(topology.Cpus.begin(), topology.Cpus.end(), [](const CpuInfo& lhs, const CpuInfo& rhs)
+				  { return lhs.Id < rhs.Id; });
+		std::sort(topology.NumaNodes.begin(), topology.NumaNodes.end());
+		if (topology.NumaNodes.empty())
+			topology.NumaNodes.push_back(0);
+		topology.CoreCount = static_cast<UInt32>(coreIds.size());
+		return topology;
+	}
+
+	std::vector<UInt32> System::ParseCpuList(std::string_view list)
+	{
+		std::vector<UInt32> cpus;
+		while (!list.empty())
+		{
+			const std::size_t comma = list.find(',');
+			std::string_view range = list.substr(0, comma);
+			list = comma == std::string_view::npos ? std::string_view() : list.substr(comma + 1);
+
+			while (!range.empty() && std::isspace(static_cast<unsigned char>(range.back())))
+				range.remove_suffix(1);
+			while (!range.empty() && std::isspace(static_cast<unsigned char>(range.front())))
+				range.remove_prefix(1);
+			if (range.empty())
+				continue;
+
+			UInt32 first = 0;
+			const char* end = range.data() + range.size();
+			auto [next, error] = std::from_chars(range.data(), end, first);
+			if (error != std::errc())
+				return {};
+
+			UInt32 last = first;
+			if (next != end)
+			{
+				if (*next != '-' || std::from_chars(next + 1, end, last).ec != std::errc() || last < first)
+					return {};
+			}
+
+			for (UInt32 cpu = first; cpu <= last; ++cpu)
+				cpus.push_back(cpu);
+		}
+
+		std::sort(cpus.begin(), cpus.end());
+		cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+		return cpus;
+	}
+
+	bool System::SetThreadAffinity(std::span<const UInt32> cpus) noexcept
+	{
+		if (cpus.empty())
+			return false;
+
+#if defined(CCT_PLATFORM_WINDOWS)
+		// Processor groups are not handled, only the CPUs of the first group can be used
+		DWORD_PTR mask = 0;
+		for (UInt32 cpu : cpus)
+		{
+			if (cpu < sizeof(DWORD_PTR) * 8)
+				mask |= DWORD_PTR(1) << cpu;
+		}
+		return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(CCT_PLATFORM_LINUX)
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		for (UInt32 cpu : cpus)
+		{
+			if (cpu < CPU_SETSIZE)
+				CPU_SET(cpu, &set);
+		}
+		return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+		return false;
+#endif
+	}
+
+	std::optional<UInt32> System::GetMemoryNumaNode(const void* address) noexcept
+	{
+#if defined(CCT_PLATFORM_LINUX) && defined(SYS_get_mempolicy)
+		// MPOL_F_NODE | MPOL_F_ADDR, from linux/mempolicy.h
+		constexpr unsigned long NodeOfAddress = (1 << 0) | (1 << 1);
+		int node = -1;
+		if (syscall(SYS_get_mempolicy, &node, nullptr, 0ul, address, NodeOfAddress) != 0 || node < 0)
+			return std::nullopt;
+		return static_cast<UInt32>(node);
+#else
+		(void)address;
+		return std::nullopt;
+#endif
+	}
+
+	std::optional<std::string> System::GetEnvironmentValue(const char* name)
+	{
+#if defined(CCT_PLATFORM_WINDOWS)
+		char* value = nullptr;
+		std::size_t length = 0;
+		if (_dupenv_s(&value, &length, name) != 0 || !value)
+			return std::nullopt;
+
+		std::string result(value);
+		std::free(value);
+		return result;
+#else
+		const char* value = std::getenv(name);
+		if (!value)
+			return std::nullopt;
+		return std::string(value);
+#endif
+	}
+
+	bool System::IsEnvironmentFlagSet(const char* name)
+	{
+		std::optional<std::string> value = GetEnvironmentValue(name);
+		if (!value)
+			return false;
+
+		std::string lowered = *value;
+		std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](unsigned char c)
+					   { return static_cast<char>(std::tolower(c)); });
+
+		return lowered == "1" || lowered == "on" || lowered == "true" || lowered == "yes";
+	}
 } // namespace vkd
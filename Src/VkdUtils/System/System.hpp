@@ -4,19 +4,49 @@
  * @date 2025-10-30
  *
  * Provides cross-platform system information retrieval, including RAM queries
- * and device memory heap size calculations for Vulkan driver memory management.
+ * and device memory heap size calculations for Vulkan driver memory management,
+ * CPU topology discovery and thread placement.
  */
 
 #pragma once
 
+#include <filesystem>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <Concerto/Core/Types/Types.hpp>
 
 namespace vkd
 {
 	using namespace cct;
+
+	struct CpuInfo
+	{
+		/// Logical CPU index, as used for affinity
+		UInt32 Id = 0;
+		/// Physical core, shared by SMT siblings and unique across packages
+		UInt32 CoreId = 0;
+		UInt32 PackageId = 0;
+		UInt32 NumaNode = 0;
+		/// 0 for the first hardware thread of its core
+		UInt32 SmtIndex = 0;
+		/// Lowest CPU id sharing the L2 and the L3 of this CPU
+		UInt32 L2Group = 0;
+		UInt32 L3Group = 0;
+	};
+
+	struct CpuTopology
+	{
+		/// CPUs the process may run on, sorted by id
+		std::vector<CpuInfo> Cpus;
+		UInt32 CoreCount = 0;
+		/// Node ids of the CPUs, sorted, a single 0 without NUMA information
+		std::vector<UInt32> NumaNodes;
+	};
+
 	class System
 	{
 	public:
@@ -30,6 +60,25 @@ namespace vkd
 
 		static UInt64 ComputeDeviceMemoryHeapSize(UInt64 totalRam) noexcept;
 		static void SetThreadName(const std::string& name) noexcept;
+		/// Spin-wait hint (pause on x86, yield on ARM), lets the sibling hardware thread run meanwhile
+		static void CpuRelax() noexcept;
+
+		/// Topology of the CPUs the process may run on. Read from sysfs on Linux, elsewhere
+		/// every CPU is reported as its own core on node 0
+		static CpuTopology QueryCpuTopology();
+		/// Topology of cpus read from a /sys/devices/system tree, missing entries get defaults
+		static CpuTopology ReadCpuTopology(const std::filesystem::path& sysfsRoot, std::span<const UInt32> cpus);
+		/// Parses a kernel CPU list like "0-3,8,10-11"
+		static std::vector<UInt32> ParseCpuList(std::string_view list);
+		/// Restricts the calling thread to cpus
+		/// @return false when unsupported or refused
+		static bool SetThreadAffinity(std::span<const UInt32> cpus) noexcept;
+		/// NUMA node backing the page of address, once it was touched
+		static std::optional<UInt32> GetMemoryNumaNode(const void* address) noexcept;
+
+		static std::optional<std::string> GetEnvironmentValue(const char* name);
+		/// True when the variable is set to 1, on, true or yes (case-insensitive)
+		static bool IsEnvironmentFlagSet(const char* name);
 
 	private:
 		std::optional<UInt64> m_totalRamBytes;
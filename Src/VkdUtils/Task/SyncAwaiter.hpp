@@ -0,0 +1,65 @@
+/**
+ * @file SyncAwaiter.hpp
+ * @brief Coroutine awaitable on a synchronization object
+ * @date 2026-10-16
+ *
+ * Suspends the awaiting coroutine until a condition over an object owning a
+ * SyncWaiterList holds, such as a fence being signaled or a timeline semaphore
+ * reaching a value. The awaiter registers in the list as a callback SyncWaiter: the
+ * notifying thread evaluates the condition and hands the coroutine to a pool worker,
+ * no thread is blocked meanwhile.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <type_traits>
+
+#include "VkdUtils/SyncWaiter/SyncWaiter.hpp"
+#include "VkdUtils/ThreadPool/ThreadPool.hpp"
+
+namespace vkd
+{
+	/// Condition must be cheap and safe to evaluate from any thread, it is called under the list lock
+	template<typename Condition>
+		requires std::predicate<Condition&>
+	class SyncAwaiter : private SyncWaiter
+	{
+	public:
+		SyncAwaiter(ThreadPool& pool, SyncWaiterList& waiters, Condition condition, ThreadPool::Priority priority);
+		SyncAwaiter(const SyncAwaiter&) = delete;
+		SyncAwaiter& operator=(const SyncAwaiter&) = delete;
+
+		bool await_ready();
+		bool await_suspend(std::coroutine_handle<> handle);
+		void await_resume() const noexcept;
+
+	private:
+		static bool IsReady(SyncWaiter& waiter);
+		static void Resume(SyncWaiter& waiter);
+
+		static constexpr SyncWaiterCallbacks Callbacks = {&IsReady, &Resume};
+		/// The condition held and one side took charge of resuming
+		static constexpr UInt32 ClaimedBit = 1u << 0;
+		/// await_suspend returned, the coroutine may be resumed from elsewhere
+		static constexpr UInt32 SuspendedBit = 1u << 1;
+		/// NotifyAll unregistered the waiter and wants the coroutine resumed
+		static constexpr UInt32 ResumedBit = 1u << 2;
+
+		ThreadPool* m_pool;
+		SyncWaiterList* m_waiters;
+		Condition m_condition;
+		ThreadPool::Priority m_priority;
+		std::coroutine_handle<> m_handle;
+		std::atomic<UInt32> m_state;
+	};
+
+	/// Suspends until condition holds, checked whenever waiters is notified, then resumes on a worker of pool
+	template<typename Condition>
+	[[nodiscard]] SyncAwaiter<std::decay_t<Condition>> WaitUntil(ThreadPool& pool, SyncWaiterList& waiters, Condition&& condition,
+																 ThreadPool::Priority priority = ThreadPool::Priority::Normal);
+} // namespace vkd
+
+#include "VkdUtils/Task/SyncAwaiter.inl"
@@ -0,0 +1,87 @@
+/**
+ * @file SyncAwaiter.inl
+ * @brief Inline implementations for SyncAwaiter
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include <utility>
+
+#include "VkdUtils/Task/SyncAwaiter.hpp"
+
+namespace vkd
+{
+	template<typename Condition>
+		requires std::predicate<Condition&>
+	SyncAwaiter<Condition>::SyncAwaiter(ThreadPool& pool, SyncWaiterList& waiters, Condition condition, ThreadPool::Priority priority) :
+		SyncWaiter(Callbacks),
+		m_pool(&pool),
+		m_waiters(&waiters),
+		m_condition(std::move(condition)),
+		m_priority(priority),
+		m_state(0)
+	{
+	}
+
+	template<typename Condition>
+		requires std::predicate<Condition&>
+	bool SyncAwaiter<Condition>::await_ready()
+	{
+		return m_condition();
+	}
+
+	template<typename Condition>
+		requires std::predicate<Condition&>
+	bool SyncAwaiter<Condition>::await_suspend(std::coroutine_handle<> handle)
+	{
+		m_handle = handle;
+		m_waiters->Add(*this);
+
+		// Registered before evaluating, a change made meanwhile is either seen here or notifies
+		if (m_condition() && !(m_state.fetch_or(ClaimedBit, std::memory_order_acq_rel) & ClaimedBit))
+		{
+			m_waiters->Remove(*this);
+			return false;
+		}
+
+		// NotifyAll may have claimed the waiter already, whichever side comes last resumes the coroutine
+		return !(m_state.fetch_or(SuspendedBit, std::memory_order_acq_rel) & ResumedBit);
+	}
+
+	template<typename Condition>
+		requires std::predicate<Condition&>
+	void SyncAwaiter<Condition>::await_resume() const noexcept
+	{
+	}
+
+	template<typename Condition>
+		requires std::predicate<Condition&>
+	bool SyncAwaiter<Condition>::IsReady(SyncWaiter& waiter)
+	{
+		SyncAwaiter& self = static_cast<SyncAwaiter&>(waiter);
+		return self.m_condition() && !(self.m_state.fetch_or(ClaimedBit, std::memory_order_acq_rel) & ClaimedBit);
+	}
+
+	template<typename Condition>
+		requires std::predicate<Condition&>
+	void SyncAwaiter<Condition>::Resume(SyncWaiter& waiter)
+	{
+		SyncAwaiter& self = static_cast<SyncAwaiter&>(waiter);
+		if (!(self.m_state.fetch_or(ResumedBit, std::memory_order_acq_rel) & SuspendedBit))
+			return; // Still in await_suspend, which continues the coroutine itself
+
+		// Read before scheduling, the coroutine and this awaiter may be gone once it runs
+		ThreadPool* pool = self.m_pool;
+		const std::coroutine_handle<> handle = self.m_handle;
+		if (!pool->TryAddTask([handle]()
+							  { handle.resume(); }, self.m_priority))
+			handle.resume();
+	}
+
+	template<typename Condition>
+	SyncAwaiter<std::decay_t<Condition>> WaitUntil(ThreadPool& pool, SyncWaiterList& waiters, Condition&& condition, ThreadPool::Priority priority)
+	{
+		return SyncAwaiter<std::decay_t<Condition>>(pool, waiters, std::forward<Condition>(condition), priority);
+	}
+} // namespace vkd
@@ -0,0 +1,78 @@
+/**
+ * @file Task.cpp
+ * @brief Implementation of detached coroutine tasks
+ * @date 2026-10-16
+ */
+
+#include "VkdUtils/Task/Task.hpp"
+
+#include <iostream>
+
+namespace vkd
+{
+	namespace
+	{
+		/// Coroutine owning itself, its frame is freed when it completes
+		struct DetachedTask
+		{
+			struct promise_type
+			{
+				DetachedTask get_return_object() noexcept
+				{
+					return DetachedTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+				}
+
+				std::suspend_always initial_suspend() const noexcept
+				{
+					return {};
+				}
+
+				std::suspend_never final_suspend() const noexcept
+				{
+					return {};
+				}
+
+				void return_void() const noexcept
+				{
+				}
+
+				void unhandled_exception() const noexcept
+				{
+					std::terminate();
+				}
+			};
+
+			std::coroutine_handle<promise_type> Handle;
+		};
+
+		DetachedTask RunDetached(Task<void> task, TaskCounter& counter)
+		{
+			try
+			{
+				co_await std::move(task);
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "[vkd::Spawn] Exception caught: " << e.what() << '\n';
+			}
+			catch (...)
+			{
+				std::cerr << "[vkd::Spawn] Unknown exception caught\n";
+			}
+
+			// The task frame is released before completion is reported, waiters may free what it references
+			task = Task<void>();
+			counter.Done();
+		}
+	} // namespace
+
+	void Spawn(ThreadPool& pool, Task<void> task, TaskCounter& counter, ThreadPool::Priority priority)
+	{
+		counter.Add();
+
+		const std::coroutine_handle<> handle = RunDetached(std::move(task), counter).Handle;
+		if (!pool.TryAddTask([handle]()
+							 { handle.resume(); }, priority))
+			handle.resume();
+	}
+} // namespace vkd
@@ -0,0 +1,144 @@
+/**
+ * @file Task.hpp
+ * @brief Coroutine task running on a ThreadPool
+ * @date 2026-10-16
+ *
+ * A Task is a lazily started coroutine. Awaiting it from another coroutine runs it and
+ * resumes the awaiting one with its result once it completed, on the thread that
+ * completed it. Spawn starts a Task<void> on a pool worker and counts it on a
+ * TaskCounter, waited for like any other counted task.
+ *
+ * Suspension points hand the thread back instead of blocking it: ResumeOn moves the
+ * coroutine to a pool worker, and SyncAwaiter suspends it until a synchronization
+ * object changes. A flow such as wait, execute, signal, release then holds no thread
+ * while it waits. A suspended coroutine must not be destroyed before it is resumed.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "VkdUtils/TaskCounter/TaskCounter.hpp"
+#include "VkdUtils/ThreadPool/ThreadPool.hpp"
+
+namespace vkd
+{
+	template<typename T = void>
+	class Task;
+
+	class TaskPromiseBase
+	{
+	public:
+		/// Resumes the awaiting coroutine, if any, in place of the completed one
+		struct FinalAwaiter
+		{
+			inline bool await_ready() const noexcept;
+			template<typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) const noexcept;
+			inline void await_resume() const noexcept;
+		};
+
+		inline std::suspend_always initial_suspend() const noexcept;
+		inline FinalAwaiter final_suspend() const noexcept;
+		inline void unhandled_exception() noexcept;
+
+		inline void SetContinuation(std::coroutine_handle<> continuation) noexcept;
+
+	protected:
+		inline void RethrowIfFailed() const;
+
+	private:
+		std::coroutine_handle<> m_continuation;
+		std::exception_ptr m_exception;
+	};
+
+	template<typename T>
+	class TaskPromise : public TaskPromiseBase
+	{
+	public:
+		Task<T> get_return_object() noexcept;
+
+		template<typename U>
+			requires std::convertible_to<U&&, T>
+		void return_value(U&& value);
+
+		/// Moves the result out, rethrows what escaped the coroutine
+		T GetResult();
+
+	private:
+		std::optional<T> m_value;
+	};
+
+	template<>
+	class TaskPromise<void> : public TaskPromiseBase
+	{
+	public:
+		inline Task<void> get_return_object() noexcept;
+		inline void return_void() const noexcept;
+		inline void GetResult() const;
+	};
+
+	template<typename T>
+	class Task
+	{
+		static_assert(!std::is_reference_v<T>, "Task results are returned by value");
+
+	public:
+		using promise_type = TaskPromise<T>;
+
+		Task() noexcept = default;
+		Task(Task&& other) noexcept;
+		Task& operator=(Task&& other) noexcept;
+		~Task();
+
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+
+		[[nodiscard]] bool IsValid() const noexcept;
+		[[nodiscard]] bool IsDone() const noexcept;
+
+		/// Runs the task, the awaiting coroutine resumes with its result once it completed
+		auto operator co_await() && noexcept;
+
+	private:
+		friend class TaskPromise<T>;
+
+		explicit Task(std::coroutine_handle<promise_type> handle) noexcept;
+
+		std::coroutine_handle<promise_type> m_handle;
+	};
+
+	/// Awaitable moving the awaiting coroutine to a worker of a pool
+	class PoolAwaiter
+	{
+	public:
+		inline PoolAwaiter(ThreadPool& pool, ThreadPool::Priority priority) noexcept;
+
+		inline bool await_ready() const noexcept;
+		/// Continues on the calling thread once the pool was asked to stop
+		inline bool await_suspend(std::coroutine_handle<> handle) const;
+		inline void await_resume() const noexcept;
+
+	private:
+		ThreadPool* m_pool;
+		ThreadPool::Priority m_priority;
+	};
+
+	[[nodiscard]] inline PoolAwaiter ResumeOn(ThreadPool& pool, ThreadPool::Priority priority = ThreadPool::Priority::Normal) noexcept;
+
+	/**
+	 * @brief Runs task on a worker of pool, counted on counter until it completed.
+	 *
+	 * The task is released before counter completes, so it may reference what the waiter
+	 * frees. Exceptions escaping it are reported like the ones of pool tasks. Once the pool
+	 * was asked to stop, the task starts on the calling thread instead.
+	 */
+	void Spawn(ThreadPool& pool, Task<void> task, TaskCounter& counter, ThreadPool::Priority priority = ThreadPool::Priority::Normal);
+} // namespace vkd
+
+#include "VkdUtils/Task/Task.inl"
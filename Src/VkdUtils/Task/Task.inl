@@ -0,0 +1,187 @@
+/**
+ * @file Task.inl
+ * @brief Inline implementations for Task
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include "VkdUtils/Task/Task.hpp"
+
+namespace vkd
+{
+	inline bool TaskPromiseBase::FinalAwaiter::await_ready() const noexcept
+	{
+		return false;
+	}
+
+	template<typename Promise>
+	std::coroutine_handle<> TaskPromiseBase::FinalAwaiter::await_suspend(std::coroutine_handle<Promise> handle) const noexcept
+	{
+		// Symmetric transfer, a chain of tasks completing in a row does not grow the stack
+		std::coroutine_handle<> continuation = handle.promise().m_continuation;
+		return continuation ? continuation : std::noop_coroutine();
+	}
+
+	inline void TaskPromiseBase::FinalAwaiter::await_resume() const noexcept
+	{
+	}
+
+	inline std::suspend_always TaskPromiseBase::initial_suspend() const noexcept
+	{
+		return {};
+	}
+
+	inline TaskPromiseBase::FinalAwaiter TaskPromiseBase::final_suspend() const noexcept
+	{
+		return {};
+	}
+
+	inline void TaskPromiseBase::unhandled_exception() noexcept
+	{
+		m_exception = std::current_exception();
+	}
+
+	inline void TaskPromiseBase::SetContinuation(std::coroutine_handle<> continuation) noexcept
+	{
+		m_continuation = continuation;
+	}
+
+	inline void TaskPromiseBase::RethrowIfFailed() const
+	{
+		if (m_exception)
+			std::rethrow_exception(m_exception);
+	}
+
+	template<typename T>
+	Task<T> TaskPromise<T>::get_return_object() noexcept
+	{
+		return Task<T>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+	}
+
+	template<typename T>
+	template<typename U>
+		requires std::convertible_to<U&&, T>
+	void TaskPromise<T>::return_value(U&& value)
+	{
+		m_value.emplace(std::forward<U>(value));
+	}
+
+	template<typename T>
+	T TaskPromise<T>::GetResult()
+	{
+		RethrowIfFailed();
+		return std::move(*m_value);
+	}
+
+	inline Task<void> TaskPromise<void>::get_return_object() noexcept
+	{
+		return Task<void>(std::coroutine_handle<TaskPromise>::from_promise(*this));
+	}
+
+	inline void TaskPromise<void>::return_void() const noexcept
+	{
+	}
+
+	inline void TaskPromise<void>::GetResult() const
+	{
+		RethrowIfFailed();
+	}
+
+	template<typename T>
+	Task<T>::Task(std::coroutine_handle<promise_type> handle) noexcept :
+		m_handle(handle)
+	{
+	}
+
+	template<typename T>
+	Task<T>::Task(Task&& other) noexcept :
+		m_handle(std::exchange(other.m_handle, nullptr))
+	{
+	}
+
+	template<typename T>
+	Task<T>& Task<T>::operator=(Task&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_handle)
+				m_handle.destroy();
+			m_handle = std::exchange(other.m_handle, nullptr);
+		}
+		return *this;
+	}
+
+	template<typename T>
+	Task<T>::~Task()
+	{
+		if (m_handle)
+			m_handle.destroy();
+	}
+
+	template<typename T>
+	bool Task<T>::IsValid() const noexcept
+	{
+		return static_cast<bool>(m_handle);
+	}
+
+	template<typename T>
+	bool Task<T>::IsDone() const noexcept
+	{
+		return m_handle && m_handle.done();
+	}
+
+	template<typename T>
+	auto Task<T>::operator co_await() && noexcept
+	{
+		struct Awaiter
+		{
+			std::coroutine_handle<promise_type> Handle;
+
+			bool await_ready() const noexcept
+			{
+				return Handle.done();
+			}
+
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept
+			{
+				Handle.promise().SetContinuation(awaiting);
+				return Handle;
+			}
+
+			T await_resume() const
+			{
+				return Handle.promise().GetResult();
+			}
+		};
+
+		return Awaiter{m_handle};
+	}
+
+	inline PoolAwaiter::PoolAwaiter(ThreadPool& pool, ThreadPool::Priority priority) noexcept :
+		m_pool(&pool),
+		m_priority(priority)
+	{
+	}
+
+	inline bool PoolAwaiter::await_ready() const noexcept
+	{
+		return false;
+	}
+
+	inline bool PoolAwaiter::await_suspend(std::coroutine_handle<> handle) const
+	{
+		// The coroutine may run on a worker before TryAddTask returns, nothing of this awaiter is read afterwards
+		return m_pool->TryAddTask([handle]()
+								  { handle.resume(); }, m_priority);
+	}
+
+	inline void PoolAwaiter::await_resume() const noexcept
+	{
+	}
+
+	inline PoolAwaiter ResumeOn(ThreadPool& pool, ThreadPool::Priority priority) noexcept
+	{
+		return PoolAwaiter(pool, priority);
+	}
+} // namespace vkd
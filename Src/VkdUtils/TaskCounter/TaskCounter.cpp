@@ -0,0 +1,32 @@
+/**
+ * @file TaskCounter.cpp
+ * @brief Implementation of TaskCounter
+ * @date 2026-10-16
+ */
+
+#include "VkdUtils/TaskCounter/TaskCounter.hpp"
+
+namespace vkd
+{
+	TaskCounter::TaskCounter(UInt32 pending) :
+		m_pending(pending)
+	{
+	}
+
+	void TaskCounter::Wait() const
+	{
+		Wait(Futex::Clock::time_point::max());
+	}
+
+	bool TaskCounter::Wait(Futex::Clock::time_point deadline) const
+	{
+		UInt32 pending = m_pending.load(std::memory_order_acquire);
+		while (pending != 0)
+		{
+			if (!Futex::Wait(m_pending, pending, deadline))
+				return m_pending.load(std::memory_order_acquire) == 0;
+			pending = m_pending.load(std::memory_order_acquire);
+		}
+		return true;
+	}
+} // namespace vkd
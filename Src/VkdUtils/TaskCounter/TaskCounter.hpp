@@ -0,0 +1,40 @@
+/**
+ * @file TaskCounter.hpp
+ * @brief Counter of pending tasks that can be waited on
+ * @date 2026-10-16
+ *
+ * Allocation-free alternative to one std::future per task: the submitter adds the
+ * tasks it hands out, each task completes once, and waiters sleep on the counter
+ * word until it drops to zero. The counter must outlive the tasks counted on it.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include "VkdUtils/Futex/Futex.hpp"
+
+namespace vkd
+{
+	class TaskCounter
+	{
+	public:
+		explicit TaskCounter(UInt32 pending = 0);
+		TaskCounter(const TaskCounter&) = delete;
+		TaskCounter& operator=(const TaskCounter&) = delete;
+
+		inline void Add(UInt32 count = 1);
+		/// Completes one task, waking the waiters on the last one
+		inline void Done();
+		[[nodiscard]] inline bool IsDone() const;
+
+		void Wait() const;
+		/// @return false once the deadline passed
+		bool Wait(Futex::Clock::time_point deadline) const;
+
+	private:
+		std::atomic<UInt32> m_pending;
+	};
+} // namespace vkd
+
+#include "VkdUtils/TaskCounter/TaskCounter.inl"
@@ -0,0 +1,28 @@
+/**
+ * @file TaskCounter.inl
+ * @brief Inline implementations for TaskCounter
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include "VkdUtils/TaskCounter/TaskCounter.hpp"
+
+namespace vkd
+{
+	inline void TaskCounter::Add(UInt32 count)
+	{
+		m_pending.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	inline void TaskCounter::Done()
+	{
+		if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			Futex::WakeAll(m_pending);
+	}
+
+	inline bool TaskCounter::IsDone() const
+	{
+		return m_pending.load(std::memory_order_acquire) == 0;
+	}
+} // namespace vkd
@@ -0,0 +1,64 @@
+/**
+ * @file TaskFunction.hpp
+ * @brief Move-only type-erased void() callable with inline storage
+ * @date 2026-10-16
+ *
+ * Unlike std::function, callables are not required to be copyable, so a task can own
+ * a promise or a unique_ptr, and callables up to InlineSize bytes are stored in place
+ * instead of on the heap. Larger or throwing-move callables fall back to a heap copy.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace vkd
+{
+	class TaskFunction
+	{
+	public:
+		static constexpr std::size_t InlineSize = 64;
+
+		/// Whether F is stored in place rather than on the heap
+		template<typename F>
+		static constexpr bool IsStoredInline = sizeof(F) <= InlineSize && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<F>;
+
+		TaskFunction() noexcept = default;
+		template<typename F>
+			requires(!std::same_as<std::decay_t<F>, TaskFunction>) && std::invocable<std::decay_t<F>&>
+		TaskFunction(F&& f);
+		~TaskFunction();
+
+		TaskFunction(TaskFunction&& other) noexcept;
+		TaskFunction& operator=(TaskFunction&& other) noexcept;
+		TaskFunction(const TaskFunction&) = delete;
+		TaskFunction& operator=(const TaskFunction&) = delete;
+
+		/// Must not be empty
+		inline void operator()();
+		inline explicit operator bool() const noexcept;
+		/// Destroys the callable, releasing what it captured
+		inline void Reset() noexcept;
+
+	private:
+		struct VTable
+		{
+			void (*Invoke)(void* storage);
+			/// Move constructs into dst and destroys src
+			void (*Relocate)(void* dst, void* src) noexcept;
+			void (*Destroy)(void* storage) noexcept;
+		};
+
+		template<typename F>
+		static const VTable InlineVTable;
+		template<typename F>
+		static const VTable HeapVTable;
+
+		alignas(std::max_align_t) std::byte m_storage[InlineSize];
+		const VTable* m_vtable = nullptr;
+	};
+} // namespace vkd
+
+#include "VkdUtils/TaskFunction/TaskFunction.inl"
@@ -0,0 +1,97 @@
+/**
+ * @file TaskFunction.inl
+ * @brief Inline implementations for TaskFunction
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "VkdUtils/TaskFunction/TaskFunction.hpp"
+
+namespace vkd
+{
+	template<typename F>
+	const TaskFunction::VTable TaskFunction::InlineVTable = {
+		[](void* storage) { (*std::launder(static_cast<F*>(storage)))(); },
+		[](void* dst, void* src) noexcept
+		{
+			F* source = std::launder(static_cast<F*>(src));
+			::new (dst) F(std::move(*source));
+			source->~F();
+		},
+		[](void* storage) noexcept { std::launder(static_cast<F*>(storage))->~F(); },
+	};
+
+	template<typename F>
+	const TaskFunction::VTable TaskFunction::HeapVTable = {
+		[](void* storage) { (**std::launder(static_cast<F**>(storage)))(); },
+		[](void* dst, void* src) noexcept { ::new (dst) F*(*std::launder(static_cast<F**>(src))); },
+		[](void* storage) noexcept { delete *std::launder(static_cast<F**>(storage)); },
+	};
+
+	template<typename F>
+		requires(!std::same_as<std::decay_t<F>, TaskFunction>) && std::invocable<std::decay_t<F>&>
+	TaskFunction::TaskFunction(F&& f)
+	{
+		using Callable = std::decay_t<F>;
+		if constexpr (IsStoredInline<Callable>)
+		{
+			::new (static_cast<void*>(m_storage)) Callable(std::forward<F>(f));
+			m_vtable = &InlineVTable<Callable>;
+		}
+		else
+		{
+			::new (static_cast<void*>(m_storage)) Callable*(new Callable(std::forward<F>(f)));
+			m_vtable = &HeapVTable<Callable>;
+		}
+	}
+
+	inline TaskFunction::~TaskFunction()
+	{
+		Reset();
+	}
+
+	inline TaskFunction::TaskFunction(TaskFunction&& other) noexcept :
+		m_vtable(other.m_vtable)
+	{
+		if (m_vtable)
+		{
+			m_vtable->Relocate(m_storage, other.m_storage);
+			other.m_vtable = nullptr;
+		}
+	}
+
+	inline TaskFunction& TaskFunction::operator=(TaskFunction&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		Reset();
+		if (other.m_vtable)
+		{
+			other.m_vtable->Relocate(m_storage, other.m_storage);
+			m_vtable = std::exchange(other.m_vtable, nullptr);
+		}
+		return *this;
+	}
+
+	inline void TaskFunction::operator()()
+	{
+		m_vtable->Invoke(m_storage);
+	}
+
+	inline TaskFunction::operator bool() const noexcept
+	{
+		return m_vtable != nullptr;
+	}
+
+	inline void TaskFunction::Reset() noexcept
+	{
+		if (m_vtable)
+			std::exchange(m_vtable, nullptr)->Destroy(m_storage);
+	}
+} // namespace vkd
@@ -0,0 +1,154 @@
+/**
+ * @file TaskGraph.cpp
+ * @brief Implementation of TaskGraph
+ * @date 2026-10-16
+ */
+
+#include "VkdUtils/TaskGraph/TaskGraph.hpp"
+
+#include <iostream>
+
+namespace vkd
+{
+	TaskGraph::TaskGraph(ThreadPool& pool) :
+		m_pool(pool),
+		m_cancelled(false),
+		m_validated(true)
+	{
+	}
+
+	TaskGraph::~TaskGraph()
+	{
+		Wait();
+	}
+
+	void TaskGraph::AddDependency(NodeId predecessor, NodeId successor)
+	{
+		m_nodes[predecessor].Successors.push_back(successor);
+		++m_nodes[successor].PredecessorCount;
+		m_validated = false;
+	}
+
+	bool TaskGraph::Run()
+	{
+		if (!m_remaining.IsDone())
+			return false;
+
+		if (!m_validated)
+		{
+			if (HasCycle())
+				return false;
+			m_validated = true;
+		}
+
+		if (m_nodes.empty())
+			return true;
+
+		m_cancelled.store(false, std::memory_order_relaxed);
+		for (Node& node : m_nodes)
+			node.PendingPredecessors.store(node.PredecessorCount, std::memory_order_relaxed);
+		m_remaining.Add(static_cast<UInt32>(m_nodes.size()));
+
+		// Roots are collected before any of them runs, a running root already updates counters
+		std::vector<NodeId> roots;
+		for (NodeId id = 0; id < m_nodes.size(); ++id)
+		{
+			if (m_nodes[id].PredecessorCount == 0)
+				roots.push_back(id);
+		}
+
+		for (NodeId root : roots)
+			Schedule(root);
+		return true;
+	}
+
+	void TaskGraph::Wait()
+	{
+		m_pool.Wait(m_remaining);
+	}
+
+	void TaskGraph::Cancel()
+	{
+		m_cancelled.store(true, std::memory_order_relaxed);
+	}
+
+	bool TaskGraph::HasCycle() const
+	{
+		// Kahn's algorithm, nodes left unvisited are on or behind a cycle
+		std::vector<UInt32> pending(m_nodes.size());
+		std::vector<NodeId> ready;
+		for (NodeId id = 0; id < m_nodes.size(); ++id)
+		{
+			pending[id] = m_nodes[id].PredecessorCount;
+			if (pending[id] == 0)
+				ready.push_back(id);
+		}
+
+		std::size_t visited = 0;
+		while (!ready.empty())
+		{
+			const NodeId id = ready.back();
+			ready.pop_back();
+			++visited;
+			for (NodeId successor : m_nodes[id].Successors)
+			{
+				if (--pending[successor] == 0)
+					ready.push_back(successor);
+			}
+		}
+
+		return visited != m_nodes.size();
+	}
+
+	void TaskGraph::Execute(NodeId id)
+	{
+		while (true)
+		{
+			Node& node = m_nodes[id];
+			if (!m_cancelled.load(std::memory_order_relaxed))
+			{
+				// The successors are released whatever happens, a throwing node would otherwise stall the run
+				try
+				{
+					node.Function();
+				}
+				catch (const std::exception& e)
+				{
+					std::cerr << "[TaskGraph] Node " << id << " threw exception: " << e.what() << '\n';
+				}
+				catch (...)
+				{
+					std::cerr << "[TaskGraph] Node " << id << " threw unknown exception\n";
+				}
+			}
+
+			bool hasContinuation = false;
+			NodeId continuation = 0;
+			for (NodeId successor : node.Successors)
+			{
+				if (m_nodes[successor].PendingPredecessors.fetch_sub(1, std::memory_order_acq_rel) != 1)
+					continue;
+
+				if (!hasContinuation)
+				{
+					hasContinuation = true;
+					continuation = successor;
+				}
+				else
+					Schedule(successor);
+			}
+
+			m_remaining.Done();
+			if (!hasContinuation)
+				return;
+			id = continuation;
+		}
+	}
+
+	void TaskGraph::Schedule(NodeId id)
+	{
+		// Once the pool stopped, the node still runs so the run completes
+		if (!m_pool.TryAddTask([this, id]() { Execute(id); }))
+			Execute(id);
+	}
+} // namespace vkd
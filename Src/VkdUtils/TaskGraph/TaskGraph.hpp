@@ -0,0 +1,82 @@
+/**
+ * @file TaskGraph.hpp
+ * @brief Dependency graph of tasks run on a ThreadPool
+ * @date 2026-10-16
+ *
+ * Nodes declare their predecessors instead of blocking on them. Each node keeps a
+ * count of unfinished predecessors, the node completing the last one schedules it,
+ * so no worker ever parks on an ordering. When a node releases several successors,
+ * the first one runs right away on the same thread as a continuation and the others
+ * are queued where idle workers can steal them.
+ *
+ * The graph is built once then run any number of times, a run must complete before
+ * the next one starts or the graph changes. Cancelling skips the nodes that have not
+ * started yet, dependencies are still released so the run completes.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+#include "VkdUtils/TaskCounter/TaskCounter.hpp"
+#include "VkdUtils/TaskFunction/TaskFunction.hpp"
+#include "VkdUtils/ThreadPool/ThreadPool.hpp"
+
+namespace vkd
+{
+	class TaskGraph
+	{
+	public:
+		using NodeId = UInt32;
+
+		explicit TaskGraph(ThreadPool& pool);
+		/// Waits for the current run
+		~TaskGraph();
+
+		TaskGraph(const TaskGraph&) = delete;
+		TaskGraph& operator=(const TaskGraph&) = delete;
+
+		template<typename F>
+			requires std::invocable<std::decay_t<F>&> && std::is_void_v<std::invoke_result_t<std::decay_t<F>&>>
+		NodeId AddNode(F&& f);
+		/// successor runs once predecessor completed
+		void AddDependency(NodeId predecessor, NodeId successor);
+
+		/// Schedules the nodes without predecessors and returns
+		/// @return false when the graph has a cycle or is still running
+		bool Run();
+		/// Runs queued tasks while waiting, like ThreadPool::Wait(const TaskCounter&)
+		void Wait();
+		/// Thread-safe, nodes of the current run that did not start yet are skipped
+		void Cancel();
+
+		[[nodiscard]] inline bool IsCancelled() const;
+		[[nodiscard]] inline bool IsDone() const;
+		[[nodiscard]] inline std::size_t GetNodeCount() const;
+
+	private:
+		struct Node
+		{
+			TaskFunction Function;
+			std::vector<NodeId> Successors;
+			UInt32 PredecessorCount = 0;
+			std::atomic<UInt32> PendingPredecessors = 0;
+		};
+
+		bool HasCycle() const;
+		/// Runs the node, then its ready successors, queuing all of them but one
+		void Execute(NodeId id);
+		void Schedule(NodeId id);
+
+		ThreadPool& m_pool;
+		// Nodes are never moved once added, their counters are atomics
+		std::deque<Node> m_nodes;
+		TaskCounter m_remaining;
+		std::atomic<bool> m_cancelled;
+		bool m_validated;
+	};
+} // namespace vkd
+
+#include "VkdUtils/TaskGraph/TaskGraph.inl"
@@ -0,0 +1,39 @@
+/**
+ * @file TaskGraph.inl
+ * @brief Inline implementations for TaskGraph
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include <utility>
+
+#include "VkdUtils/TaskGraph/TaskGraph.hpp"
+
+namespace vkd
+{
+	template<typename F>
+		requires std::invocable<std::decay_t<F>&> && std::is_void_v<std::invoke_result_t<std::decay_t<F>&>>
+	TaskGraph::NodeId TaskGraph::AddNode(F&& f)
+	{
+		Node& node = m_nodes.emplace_back();
+		node.Function = TaskFunction(std::forward<F>(f));
+		m_validated = false;
+		return static_cast<NodeId>(m_nodes.size() - 1);
+	}
+
+	inline bool TaskGraph::IsCancelled() const
+	{
+		return m_cancelled.load(std::memory_order_relaxed);
+	}
+
+	inline bool TaskGraph::IsDone() const
+	{
+		return m_remaining.IsDone();
+	}
+
+	inline std::size_t TaskGraph::GetNodeCount() const
+	{
+		return m_nodes.size();
+	}
+} // namespace vkd
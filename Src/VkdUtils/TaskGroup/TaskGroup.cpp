@@ -0,0 +1,25 @@
+/**
+ * @file TaskGroup.cpp
+ * @brief Implementation of TaskGroup
+ * @date 2026-10-16
+ */
+
+#include "VkdUtils/TaskGroup/TaskGroup.hpp"
+
+namespace vkd
+{
+	TaskGroup::TaskGroup(ThreadPool& pool) :
+		m_pool(pool)
+	{
+	}
+
+	TaskGroup::~TaskGroup()
+	{
+		Wait();
+	}
+
+	void TaskGroup::Wait()
+	{
+		m_pool.Wait(m_counter);
+	}
+} // namespace vkd
@@ -0,0 +1,44 @@
+/**
+ * @file TaskGroup.hpp
+ * @brief Scope of tasks added to a ThreadPool and waited for together
+ * @date 2026-10-16
+ *
+ * Unlike ThreadPool::Wait on every in-flight task, a group only waits for the tasks it
+ * ran, and its waiting thread executes queued tasks meanwhile. Groups can be nested
+ * inside pool tasks, a worker waiting on its group keeps the pool busy instead of
+ * blocking a thread. The destructor waits, so tasks may reference the enclosing scope.
+ */
+
+#pragma once
+
+#include "VkdUtils/TaskCounter/TaskCounter.hpp"
+#include "VkdUtils/ThreadPool/ThreadPool.hpp"
+
+namespace vkd
+{
+	class TaskGroup
+	{
+	public:
+		explicit TaskGroup(ThreadPool& pool);
+		~TaskGroup();
+
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		/// Like ThreadPool::AddTask, nothing runs once the pool was asked to stop
+		template<typename F>
+			requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
+		void Run(F&& f);
+
+		/// Returns once every task run so far completed, the group can then be reused
+		void Wait();
+
+		[[nodiscard]] inline ThreadPool& GetPool() const;
+
+	private:
+		ThreadPool& m_pool;
+		TaskCounter m_counter;
+	};
+} // namespace vkd
+
+#include "VkdUtils/TaskGroup/TaskGroup.inl"
@@ -0,0 +1,26 @@
+/**
+ * @file TaskGroup.inl
+ * @brief Inline implementations for TaskGroup
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include <utility>
+
+#include "VkdUtils/TaskGroup/TaskGroup.hpp"
+
+namespace vkd
+{
+	template<typename F>
+		requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
+	void TaskGroup::Run(F&& f)
+	{
+		m_pool.AddTask(m_counter, std::forward<F>(f));
+	}
+
+	inline ThreadPool& TaskGroup::GetPool() const
+	{
+		return m_pool;
+	}
+} // namespace vkd
@@ -0,0 +1,166 @@
+/**
+ * @file TaskTenant.cpp
+ * @brief Implementation of TaskTenant
+ * @date 2026-10-16
+ */
+
+#include "VkdUtils/TaskTenant/TaskTenant.hpp"
+
+#include <iostream>
+
+namespace vkd
+{
+	TaskTenant::TaskTenant(std::shared_ptr<ThreadPool> pool, unsigned int quota) :
+		m_pool(std::move(pool)),
+		m_quota(static_cast<unsigned int>(m_pool->GetWorkerCount()))
+	{
+		if (quota != 0 && quota < m_quota)
+			m_quota = quota;
+	}
+
+	TaskTenant::~TaskTenant()
+	{
+		std::unique_lock lock(m_mutex);
+		m_runnersCv.wait(lock, [this]()
+						 { return m_runnerCount == 0; });
+	}
+
+	void TaskTenant::Wait(const TaskCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			PendingTask task;
+			{
+				std::lock_guard lock(m_mutex);
+				const std::size_t lane = NextLaneLocked();
+				if (lane == ThreadPool::PriorityCount)
+					break; // What is left is running on other threads
+
+				task = std::move(m_queues[lane].front());
+				m_queues[lane].pop_front();
+			}
+			RunTask(task);
+		}
+
+		counter.Wait();
+	}
+
+	void TaskTenant::Enqueue(TaskFunction&& function, TaskCounter& counter, ThreadPool::Priority priority)
+	{
+		counter.Add();
+
+		bool startRunner = false;
+		{
+			std::lock_guard lock(m_mutex);
+			m_queues[static_cast<std::size_t>(priority)].push_back(PendingTask{std::move(function), &counter});
+
+			// Runners only exit with the queues empty, so at least one is left to take this task
+			if (m_runnerCount < m_quota)
+			{
+				++m_runnerCount;
+				startRunner = true;
+			}
+		}
+
+		if (startRunner)
+			StartRunner(priority, false);
+	}
+
+	void TaskTenant::StartRunner(ThreadPool::Priority priority, bool inject)
+	{
+		auto runner = [this]()
+		{
+			RunSlice(std::chrono::steady_clock::now() + SliceDuration);
+		};
+
+		const bool queued = inject ? m_pool->TryInjectTask(std::move(runner), priority) : m_pool->TryAddTask(std::move(runner), priority);
+		if (!queued)
+			RunSlice(std::chrono::steady_clock::time_point::max());
+	}
+
+	void TaskTenant::RunSlice(std::chrono::steady_clock::time_point sliceEnd)
+	{
+		while (true)
+		{
+			const bool expired = std::chrono::steady_clock::now() >= sliceEnd;
+
+			PendingTask task;
+			std::size_t lane;
+			{
+				std::lock_guard lock(m_mutex);
+				lane = expired ? HighestLaneLocked() : NextLaneLocked();
+				if (lane == ThreadPool::PriorityCount)
+				{
+					// Notified under the lock, the tenant may be destroyed as soon as it is released
+					--m_runnerCount;
+					m_runnersCv.notify_all();
+					return;
+				}
+
+				if (!expired)
+				{
+					task = std::move(m_queues[lane].front());
+					m_queues[lane].pop_front();
+				}
+			}
+
+			// Queued behind the other tenants' tasks, in the lane of the most urgent task left
+			if (expired)
+			{
+				StartRunner(static_cast<ThreadPool::Priority>(lane), true);
+				return;
+			}
+
+			RunTask(task);
+		}
+	}
+
+	std::size_t TaskTenant::NextLaneLocked()
+	{
+		// Same pacing as ThreadPool::FindTask, every StarvationInterval-th pick starts at a lower lane
+		const std::uint32_t pick = m_pickCount + 1;
+		std::size_t firstLane = 0;
+		if (pick % ThreadPool::StarvationInterval == 0)
+			firstLane = 1 + (pick / ThreadPool::StarvationInterval) % (ThreadPool::PriorityCount - 1);
+
+		for (std::size_t i = 0; i < ThreadPool::PriorityCount; ++i)
+		{
+			const std::size_t lane = i == 0 ? firstLane : (i - 1 < firstLane ? i - 1 : i);
+			if (!m_queues[lane].empty())
+			{
+				m_pickCount = pick;
+				return lane;
+			}
+		}
+
+		return ThreadPool::PriorityCount;
+	}
+
+	std::size_t TaskTenant::HighestLaneLocked() const
+	{
+		std::size_t lane = 0;
+		while (lane < ThreadPool::PriorityCount && m_queues[lane].empty())
+			++lane;
+		return lane;
+	}
+
+	void TaskTenant::RunTask(PendingTask& task)
+	{
+		try
+		{
+			task.Function();
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "[TaskTenant] Exception caught: " << e.what() << '\n';
+		}
+		catch (...)
+		{
+			std::cerr << "[TaskTenant] Unknown exception caught\n";
+		}
+
+		// Captures are released before completion is reported, waiters may free what they reference
+		task.Function.Reset();
+		task.Counter->Done();
+	}
+} // namespace vkd
@@ -0,0 +1,120 @@
+/**
+ * @file TaskTenant.hpp
+ * @brief Quota limited share of a ThreadPool
+ * @date 2026-10-16
+ *
+ * Several clients, such as the devices of a process, share one pool through a tenant
+ * each, instead of each owning workers for every CPU. Tasks added to a tenant wait in
+ * its own queue, one per priority, and are run by at most Quota workers of the pool at
+ * once: the tenant's runners. A runner takes queued tasks until its slice expired, then
+ * hands its worker back by queuing itself behind the tasks already injected. Busy
+ * tenants thereby take turns on the workers, each getting a share proportional to its
+ * quota, and a tenant flooding the pool cannot hold every worker.
+ *
+ * Inside a tenant, lanes follow the pool's rule: the highest non-empty lane first, but
+ * one pick in ThreadPool::StarvationInterval starts at a lower lane, so background tasks
+ * of a tenant still progress under a steady stream of its realtime tasks.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "VkdUtils/TaskCounter/TaskCounter.hpp"
+#include "VkdUtils/TaskFunction/TaskFunction.hpp"
+#include "VkdUtils/ThreadPool/ThreadPool.hpp"
+
+namespace vkd
+{
+	class TaskTenant
+	{
+	public:
+		/// Time a runner keeps its worker while tasks are queued, before giving other tenants a turn
+		static constexpr std::chrono::microseconds SliceDuration{500};
+
+		/// quota is the number of workers running tasks of this tenant at once, 0 or more than the pool has for all of them
+		explicit TaskTenant(std::shared_ptr<ThreadPool> pool, unsigned int quota = 0);
+		/// Waits for the runners, tasks still queued run meanwhile
+		~TaskTenant();
+
+		TaskTenant(const TaskTenant&) = delete;
+		TaskTenant& operator=(const TaskTenant&) = delete;
+
+		/**
+		 * @brief Adds a task counted on counter, run by a runner of this tenant.
+		 *
+		 * Once the pool was asked to stop, queued tasks run on the calling thread.
+		 */
+		template<typename F>
+			requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
+		void AddTask(TaskCounter& counter, F&& f, ThreadPool::Priority priority = ThreadPool::Priority::Normal);
+
+		/// Waits until every task counted on counter ran, running queued tasks of this tenant meanwhile
+		void Wait(const TaskCounter& counter);
+
+		/**
+		 * @brief Like ThreadPool::ParallelFor, on at most Quota workers besides the calling thread.
+		 *
+		 * The range is cut in a few chunks per participant, never smaller than grain unless the
+		 * whole range is, which the calling thread and the helper tasks take in turn.
+		 */
+		template<typename F>
+			requires std::invocable<F&, std::size_t, std::size_t>
+		void ParallelFor(std::size_t begin, std::size_t end, std::size_t grain, F&& f, ThreadPool::Priority priority = ThreadPool::Priority::Normal);
+
+		[[nodiscard]] inline ThreadPool& GetPool() const;
+		[[nodiscard]] inline unsigned int GetQuota() const;
+
+	private:
+		struct PendingTask
+		{
+			TaskFunction Function;
+			TaskCounter* Counter = nullptr;
+		};
+
+		template<typename F>
+		struct ParallelForState
+		{
+			F* Function;
+			std::size_t Begin;
+			std::size_t End;
+			std::size_t ChunkSize;
+			std::size_t ChunkCount;
+			std::atomic<std::size_t> NextChunk{0};
+			TaskCounter Counter{};
+
+			void RunChunks();
+		};
+
+		/// Queues a counted task and starts a runner while under quota
+		void Enqueue(TaskFunction&& function, TaskCounter& counter, ThreadPool::Priority priority);
+		/// Queues a runner on the pool, runs it on the calling thread once the pool stopped
+		void StartRunner(ThreadPool::Priority priority, bool inject);
+		/// Runs queued tasks until sliceEnd, then queues itself again while tasks are left
+		void RunSlice(std::chrono::steady_clock::time_point sliceEnd);
+		/// Lane to take the next task from, see ThreadPool::StarvationInterval, PriorityCount when
+		/// none holds tasks. Counts a pick, the caller holds m_mutex and takes the task
+		std::size_t NextLaneLocked();
+		/// Highest priority lane holding tasks, PriorityCount when none, the caller holds m_mutex
+		std::size_t HighestLaneLocked() const;
+		static void RunTask(PendingTask& task);
+
+		std::shared_ptr<ThreadPool> m_pool;
+		unsigned int m_quota;
+
+		std::mutex m_mutex;
+		std::array<std::deque<PendingTask>, ThreadPool::PriorityCount> m_queues;
+		unsigned int m_runnerCount = 0;
+		/// Tasks taken from the queues, paces the lower lane picks
+		std::uint32_t m_pickCount = 0;
+		std::condition_variable m_runnersCv;
+	};
+} // namespace vkd
+
+#include "VkdUtils/TaskTenant/TaskTenant.inl"
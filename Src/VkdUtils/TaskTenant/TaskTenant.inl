@@ -0,0 +1,72 @@
+/**
+ * @file TaskTenant.inl
+ * @brief Inline implementations for TaskTenant
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <utility>
+
+#include "VkdUtils/TaskTenant/TaskTenant.hpp"
+
+namespace vkd
+{
+	template<typename F>
+		requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
+	void TaskTenant::AddTask(TaskCounter& counter, F&& f, ThreadPool::Priority priority)
+	{
+		Enqueue(TaskFunction(std::forward<F>(f)), counter, priority);
+	}
+
+	template<typename F>
+		requires std::invocable<F&, std::size_t, std::size_t>
+	void TaskTenant::ParallelFor(std::size_t begin, std::size_t end, std::size_t grain, F&& f, ThreadPool::Priority priority)
+	{
+		if (begin >= end)
+			return;
+
+		// The calling thread takes part, a few chunks each leave room to balance uneven ones
+		const std::size_t participants = std::min<std::size_t>(m_quota, m_pool->GetWorkerCount()) + 1;
+		const std::size_t size = end - begin;
+		const std::size_t chunkSize = std::max(std::max<std::size_t>(grain, 1), (size + participants * 4 - 1) / (participants * 4));
+
+		ParallelForState<std::remove_reference_t<F>> state{
+			.Function = &f,
+			.Begin = begin,
+			.End = end,
+			.ChunkSize = chunkSize,
+			.ChunkCount = (size + chunkSize - 1) / chunkSize,
+		};
+
+		// Helpers starting once every chunk was taken return right away
+		const std::size_t helpers = std::min(participants, state.ChunkCount) - 1;
+		for (std::size_t i = 0; i < helpers; ++i)
+			AddTask(state.Counter, [&state]()
+					{ state.RunChunks(); }, priority);
+
+		state.RunChunks();
+		Wait(state.Counter);
+	}
+
+	template<typename F>
+	void TaskTenant::ParallelForState<F>::RunChunks()
+	{
+		for (std::size_t chunk = NextChunk.fetch_add(1, std::memory_order_relaxed); chunk < ChunkCount; chunk = NextChunk.fetch_add(1, std::memory_order_relaxed))
+		{
+			const std::size_t chunkBegin = Begin + chunk * ChunkSize;
+			(*Function)(chunkBegin, std::min(chunkBegin + ChunkSize, End));
+		}
+	}
+
+	inline ThreadPool& TaskTenant::GetPool() const
+	{
+		return *m_pool;
+	}
+
+	inline unsigned int TaskTenant::GetQuota() const
+	{
+		return m_quota;
+	}
+} // namespace vkd
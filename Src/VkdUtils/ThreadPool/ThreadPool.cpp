@@ -6,16 +6,29 @@
 
 #include <algorithm>
 #include <iostream>
+#include <tuple>
 
+#include "VkdUtils/Futex/Futex.hpp"
 #include "VkdUtils/System/System.hpp"
 
 namespace vkd
 {
-	ThreadPool::ThreadPool(unsigned int numThreads)
+	thread_local ThreadPool::Worker* ThreadPool::s_currentWorker = nullptr;
+
+	ThreadPool::ThreadPool(unsigned int numThreads) :
+		ThreadPool(Options{.WorkerCount = numThreads})
+	{
+	}
+
+	ThreadPool::ThreadPool(const Options& options) :
+		m_maxSpin(std::max(options.MaxSpin, std::chrono::nanoseconds::zero()))
 	{
+		const bool hasTopology = options.Topology && !options.Topology->Cpus.empty();
+
+		unsigned int numThreads = options.WorkerCount;
 		if (numThreads == 0)
 		{
-			numThreads = std::thread::hardware_concurrency();
+			numThreads = hasTopology ? static_cast<unsigned int>(options.Topology->Cpus.size()) : std::thread::hardware_concurrency();
 			if (numThreads == 0)
 			{
 				numThreads = 1;
@@ -26,60 +39,522 @@ namespace vkd
 
 		for (unsigned int i = 0; i < numThreads; ++i)
 		{
-			m_workers.emplace_back([this, i](std::stop_token st)
-								   { WorkerLoop(st, i + 1); });
+			auto worker = std::make_unique<Worker>();
+			worker->Pool = this;
+			worker->Index = i;
+			worker->RandomState = 0x9E3779B9u * (i + 1);
+			worker->SpinBudget = m_maxSpin / 4;
+			m_workers.push_back(std::move(worker));
+		}
+
+		if (hasTopology)
+		{
+			PlaceWorkers(options, numThreads);
+		}
+		else
+		{
+			m_numaNodes.push_back(0);
+			m_nodeWorkers.emplace_back(0, numThreads);
+		}
+		m_injectionQueues.resize(m_numaNodes.size() * PriorityCount);
+
+		for (unsigned int i = 0; i < numThreads; ++i)
+		{
+			m_workers[i]->Thread = std::thread([this, i]()
+											   { WorkerLoop(i); });
+		}
+	}
+
+	void ThreadPool::PlaceWorkers(const Options& options, unsigned int workerCount)
+	{
+		const CpuTopology& topology = *options.Topology;
+
+		// CPUs of each node, cores first and their SMT siblings last, neighbours sharing a cache kept together
+		std::vector<std::vector<const CpuInfo*>> nodeCpus;
+		for (const CpuInfo& cpu : topology.Cpus)
+		{
+			auto it = std::find(m_numaNodes.begin(), m_numaNodes.end(), cpu.NumaNode);
+			if (it == m_numaNodes.end())
+			{
+				m_numaNodes.push_back(cpu.NumaNode);
+				nodeCpus.emplace_back();
+				it = m_numaNodes.end() - 1;
+			}
+			nodeCpus[it - m_numaNodes.begin()].push_back(&cpu);
+		}
+		for (auto& cpus : nodeCpus)
+		{
+			std::ranges::sort(cpus, [](const CpuInfo* lhs, const CpuInfo* rhs)
+							  { return std::tie(lhs->SmtIndex, lhs->L3Group, lhs->L2Group, lhs->Id) < std::tie(rhs->SmtIndex, rhs->L3Group, rhs->L2Group, rhs->Id); });
+		}
+
+		// Interleaved over the nodes so a pool smaller than the machine still uses every memory
+		// controller, wrapping around when there are more workers than CPUs
+		std::vector<std::pair<std::size_t, const CpuInfo*>> order;
+		order.reserve(topology.Cpus.size());
+		for (std::size_t round = 0; order.size() < topology.Cpus.size(); ++round)
+		{
+			for (std::size_t node = 0; node < nodeCpus.size(); ++node)
+			{
+				if (round < nodeCpus[node].size())
+					order.emplace_back(node, nodeCpus[node][round]);
+			}
+		}
+
+		std::vector<std::pair<std::size_t, const CpuInfo*>> placements;
+		placements.reserve(workerCount);
+		for (std::size_t i = 0; i < workerCount; ++i)
+			placements.push_back(order[i % order.size()]);
+		std::ranges::stable_sort(placements, {}, &std::pair<std::size_t, const CpuInfo*>::first);
+
+		m_nodeWorkers.assign(m_numaNodes.size(), {0, 0});
+		for (std::size_t i = 0; i < workerCount; ++i)
+		{
+			const auto [node, cpu] = placements[i];
+			Worker& worker = *m_workers[i];
+			worker.NodeIndex = node;
+
+			auto& [begin, end] = m_nodeWorkers[node];
+			if (begin == end)
+				begin = i;
+			end = i + 1;
+
+			switch (options.Pinning)
+			{
+				case Affinity::None:
+					break;
+				case Affinity::NumaNode:
+					for (const CpuInfo* nodeCpu : nodeCpus[node])
+						worker.AffinityCpus.push_back(nodeCpu->Id);
+					break;
+				case Affinity::Cpu:
+					worker.AffinityCpus.push_back(cpu->Id);
+					break;
+			}
 		}
 	}
 
 	ThreadPool::~ThreadPool() noexcept
 	{
 		RequestStop();
+
+		// Workers drained every task before exiting, all nodes are back in a free list
+		auto deleteNodes = [](TaskNode* node)
+		{
+			while (node)
+				delete std::exchange(node, node->Next);
+		};
+		for (auto& worker : m_workers)
+			deleteNodes(worker->FreeNodes);
+		deleteNodes(m_freeNodes);
 	}
 
-	void ThreadPool::WorkerLoop(std::stop_token stopToken, unsigned int workerIndex)
+	bool ThreadPool::Enqueue(TaskFunction&& function, TaskCounter* counter, Priority priority, std::size_t nodeIndex, bool inject)
 	{
-		System::SetThreadName("ThreadPool Worker#" + std::to_string(workerIndex));
+		const std::size_t lane = static_cast<std::size_t>(priority);
+		Worker* worker = s_currentWorker && s_currentWorker->Pool == this ? s_currentWorker : nullptr;
+		if (worker && !inject && (nodeIndex == AnyNode || nodeIndex == worker->NodeIndex))
+		{
+			if (m_stopRequested.load(std::memory_order_acquire))
+				return false;
+
+			TaskNode* node = AcquireNode(*worker);
+			node->Function = std::move(function);
+			node->Counter = counter;
+			if (lane != NormalLane)
+				m_queuedCounts[lane].fetch_add(1, std::memory_order_relaxed);
+			worker->Deques[lane].Push(node);
+		}
+		else
+		{
+			std::lock_guard lock(m_injectionMutex);
+
+			if (m_stopRequested.load(std::memory_order_acquire))
+				return false;
+
+			// Tasks without preference are spread over the nodes
+			if (nodeIndex == AnyNode)
+				nodeIndex = m_nextInjectionNode++ % m_numaNodes.size();
+
+			TaskNode* node = AcquireNodeLocked();
+			node->Function = std::move(function);
+			node->Counter = counter;
+			node->Next = nullptr;
+
+			InjectionQueue& queue = m_injectionQueues[nodeIndex * PriorityCount + lane];
+			if (queue.Tail)
+				queue.Tail->Next = node;
+			else
+				queue.Head = node;
+			queue.Tail = node;
+			++queue.Count;
+			if (lane != NormalLane)
+				m_queuedCounts[lane].fetch_add(1, std::memory_order_relaxed);
+			m_injectedCounts[lane].fetch_add(1, std::memory_order_seq_cst);
+		}
+
+		WakeWorker();
+		return true;
+	}
+
+	void ThreadPool::WorkerLoop(unsigned int workerIndex)
+	{
+		System::SetThreadName("ThreadPool Worker#" + std::to_string(workerIndex + 1));
+
+		Worker& worker = *m_workers[workerIndex];
+		s_currentWorker = &worker;
+
+		if (!worker.AffinityCpus.empty())
+			System::SetThreadAffinity(worker.AffinityCpus);
 
 		while (true)
 		{
-			std::function<void()> task;
+			TaskNode* node = FindTask(worker);
+			if (!node && !m_stopRequested.load(std::memory_order_acquire))
+				node = WaitForTask(worker);
+
+			if (!node)
 			{
-				std::unique_lock lock(m_queueMutex);
+				// Drain what was accepted before the stop request
+				node = FindTask(worker);
+				if (!node)
+					break;
+			}
 
-				m_queueCv.wait(lock, stopToken, [this]()
-							   { return !m_taskQueue.empty() || m_stopRequested.load(std::memory_order_acquire); });
+			RunTask(&worker, node);
+		}
 
-				if (stopToken.stop_requested() && m_taskQueue.empty())
-					break;
+		s_currentWorker = nullptr;
+	}
+
+	ThreadPool::TaskNode* ThreadPool::FindTask(Worker& worker)
+	{
+		// Strict priority, but every StarvationInterval-th lookup starts at a lower lane,
+		// alternating between them, so no lane waits forever behind higher ones
+		const std::uint32_t pick = worker.PickCount + 1;
+		std::size_t firstLane = 0;
+		if (pick % StarvationInterval == 0)
+			firstLane = 1 + (pick / StarvationInterval) % (PriorityCount - 1);
+
+		for (std::size_t i = 0; i < PriorityCount; ++i)
+		{
+			const std::size_t lane = i == 0 ? firstLane : (i - 1 < firstLane ? i - 1 : i);
+			if (lane != NormalLane && m_queuedCounts[lane].load(std::memory_order_relaxed) == 0)
+				continue;
+
+			if (TaskNode* node = TakeTask(&worker, lane, worker.RandomState))
+			{
+				worker.PickCount = pick;
+				return node;
+			}
+		}
+		return nullptr;
+	}
+
+	ThreadPool::TaskNode* ThreadPool::WaitForTask(Worker& worker)
+	{
+		if (m_maxSpin == std::chrono::nanoseconds::zero())
+		{
+			TaskNode* node = nullptr;
+			while (!node && !m_stopRequested.load(std::memory_order_acquire))
+			{
+				Park();
+				node = FindTask(worker);
+			}
+			return node;
+		}
 
-				if (m_taskQueue.empty())
-				{
-					if (m_stopRequested.load(std::memory_order_acquire))
-						break;
+		const auto idleStart = std::chrono::steady_clock::now();
+		TaskNode* node = Spin(worker, idleStart);
+		while (!node && !m_stopRequested.load(std::memory_order_acquire))
+		{
+			Park();
+			node = FindTask(worker);
+		}
+
+		// Moves the budget an eighth of the way towards twice the idle period, so the spin covers
+		// the usual gaps between tasks. Periods longer than MaxSpin pull it towards zero instead,
+		// spinning through them only burns CPU.
+		if (node)
+		{
+			const std::chrono::nanoseconds idle = std::chrono::steady_clock::now() - idleStart;
+			const std::chrono::nanoseconds target = idle < m_maxSpin ? std::min(idle * 2, m_maxSpin) : std::chrono::nanoseconds::zero();
+			worker.SpinBudget += (target - worker.SpinBudget) / 8;
+		}
+		return node;
+	}
+
+	ThreadPool::TaskNode* ThreadPool::Spin(Worker& worker, std::chrono::steady_clock::time_point idleStart)
+	{
+		if (worker.SpinBudget <= std::chrono::nanoseconds::zero())
+			return nullptr;
+
+		// Pauses during the first half of the budget, then yields so other threads of the CPU can run
+		const auto yieldFrom = idleStart + worker.SpinBudget / 2;
+		const auto deadline = idleStart + worker.SpinBudget;
+		m_spinningCount.fetch_add(1, std::memory_order_seq_cst);
+
+		TaskNode* node = nullptr;
+		auto now = idleStart;
+		while (now < deadline && !m_stopRequested.load(std::memory_order_relaxed))
+		{
+			if (now < yieldFrom)
+			{
+				for (std::uint32_t i = 0; i < SpinPausesPerLookup; ++i)
+					System::CpuRelax();
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+
+			if ((node = FindTask(worker)))
+				break;
+			now = std::chrono::steady_clock::now();
+		}
+
+		m_spinningCount.fetch_sub(1, std::memory_order_seq_cst);
+
+		// Producers did not wake anyone while this worker spun, it passes the rest on
+		if (node && HasWork())
+			WakeWorker();
+		return node;
+	}
+
+	ThreadPool::TaskNode* ThreadPool::TakeTask(Worker* worker, std::size_t lane, std::uint32_t& randomState)
+	{
+		TaskNode* node = nullptr;
+		if (!worker || !worker->Deques[lane].TryPop(node))
+		{
+			node = PopInjected(worker, lane);
+			if (!node)
+				node = Steal(worker, lane, randomState);
+		}
+
+		if (node && lane != NormalLane)
+			m_queuedCounts[lane].fetch_sub(1, std::memory_order_relaxed);
+		return node;
+	}
+
+	ThreadPool::TaskNode* ThreadPool::PopInjected(Worker* worker, std::size_t lane)
+	{
+		std::atomic<size_t>& injectedCount = m_injectedCounts[lane];
+		if (injectedCount.load(std::memory_order_relaxed) == 0)
+			return nullptr;
+
+		std::lock_guard lock(m_injectionMutex);
+		if (injectedCount.load(std::memory_order_relaxed) == 0)
+			return nullptr;
+
+		// The worker's own node first, then the other nodes so no queue is left behind
+		const std::size_t nodeCount = m_numaNodes.size();
+		const std::size_t firstNode = worker ? worker->NodeIndex : 0;
+		std::size_t nodeIndex = firstNode;
+		for (std::size_t i = 0; i < nodeCount; ++i)
+		{
+			nodeIndex = (firstNode + i) % nodeCount;
+			if (m_injectionQueues[nodeIndex * PriorityCount + lane].Count != 0)
+				break;
+		}
+		InjectionQueue& queue = m_injectionQueues[nodeIndex * PriorityCount + lane];
+
+		// A worker takes a share of the queue so the other workers of the node find the rest on its deque or on the queue
+		const auto [nodeBegin, nodeEnd] = m_nodeWorkers[nodeIndex];
+		const std::size_t workerCount = std::max<std::size_t>(nodeEnd - nodeBegin, 1);
+		const std::size_t count = worker ? std::min((queue.Count + workerCount - 1) / workerCount, MaxInjectedBatch) : 1;
+		TaskNode* node = queue.Head;
+		queue.Head = node->Next;
+		for (std::size_t i = 1; i < count; ++i)
+		{
+			worker->Deques[lane].Push(queue.Head);
+			queue.Head = queue.Head->Next;
+		}
+		if (!queue.Head)
+			queue.Tail = nullptr;
+		queue.Count -= count;
+		injectedCount.fetch_sub(count, std::memory_order_relaxed);
+
+		if (count > 1)
+			WakeWorker();
+		return node;
+	}
+
+	ThreadPool::TaskNode* ThreadPool::Steal(const Worker* thief, std::size_t lane, std::uint32_t& randomState)
+	{
+		const std::size_t workerCount = m_workers.size();
+		if (thief && workerCount < 2)
+			return nullptr;
+
+		// xorshift32, picks where the victim scan starts so thieves spread over the workers
+		std::uint32_t state = randomState;
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		randomState = state;
+
+		// Victims on the thief's node first, their tasks likely touch memory local to it
+		const auto [nodeBegin, nodeEnd] = thief ? m_nodeWorkers[thief->NodeIndex] : std::pair<std::size_t, std::size_t>(0, 0);
+		const auto trySteal = [&](std::size_t begin, std::size_t end, bool skipRange) -> TaskNode*
+		{
+			const std::size_t count = end - begin;
+			if (count == 0)
+				return nullptr;
+
+			const std::size_t start = state % count;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const std::size_t victimIndex = begin + (start + i) % count;
+				if (skipRange && victimIndex >= nodeBegin && victimIndex < nodeEnd)
+					continue;
+
+				Worker& victim = *m_workers[victimIndex];
+				if (&victim == thief)
 					continue;
-				}
 
-				task = std::move(m_taskQueue.front());
-				m_taskQueue.pop_front();
+				TaskNode* node = nullptr;
+				if (victim.Deques[lane].TrySteal(node))
+					return node;
+			}
+			return nullptr;
+		};
+
+		if (TaskNode* node = trySteal(nodeBegin, nodeEnd, false))
+			return node;
+		if (nodeEnd - nodeBegin == workerCount)
+			return nullptr;
+		return trySteal(0, workerCount, true);
+	}
+
+	bool ThreadPool::HasWork() const
+	{
+		for (const auto& injectedCount : m_injectedCounts)
+		{
+			if (injectedCount.load(std::memory_order_seq_cst) != 0)
+				return true;
+		}
+
+		for (const auto& worker : m_workers)
+		{
+			for (const auto& deque : worker->Deques)
+			{
+				if (!deque.IsEmpty())
+					return true;
 			}
+		}
+		return false;
+	}
+
+	void ThreadPool::Park()
+	{
+		// Producers publish their task before reading the sleeping count, and a parking worker
+		// registers before looking for work, so one of the two always sees the other
+		const std::uint32_t epoch = m_wakeEpoch.load(std::memory_order_acquire);
+		m_sleepingCount.fetch_add(1, std::memory_order_seq_cst);
+
+		if (!HasWork() && !m_stopRequested.load(std::memory_order_seq_cst))
+			Futex::Wait(m_wakeEpoch, epoch);
+
+		m_sleepingCount.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	void ThreadPool::WakeWorker()
+	{
+		// A spinning worker takes the task, it looks for work again before parking anyway
+		if (m_spinningCount.load(std::memory_order_seq_cst) != 0 || m_sleepingCount.load(std::memory_order_seq_cst) == 0)
+			return;
+
+		m_wakeEpoch.fetch_add(1, std::memory_order_release);
+		Futex::WakeOne(m_wakeEpoch);
+	}
+
+	void ThreadPool::RunTask(Worker* worker, TaskNode* node)
+	{
+		try
+		{
+			node->Function();
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "[ThreadPool::Worker#" << (worker ? worker->Index + 1 : 0) << "] Exception caught: " << e.what() << '\n';
+		}
+		catch (...)
+		{
+			std::cerr << "[ThreadPool::Worker#" << (worker ? worker->Index + 1 : 0) << "] Unknown exception caught\n";
+		}
+
+		// Captures are released before completion is reported, waiters may free what they reference
+		TaskCounter* counter = node->Counter;
+		ReleaseNode(worker, node);
+
+		if (counter)
+			counter->Done();
+		TaskCompleted();
+	}
 
-			if (task)
+	ThreadPool::TaskNode* ThreadPool::AcquireNodeLocked()
+	{
+		if (TaskNode* node = m_freeNodes)
+		{
+			m_freeNodes = node->Next;
+			return node;
+		}
+		return new TaskNode;
+	}
+
+	ThreadPool::TaskNode* ThreadPool::AcquireNode(Worker& worker)
+	{
+		if (!worker.FreeNodes)
+		{
+			// Refills from the nodes other workers handed back, a worker that only produces
+			// tasks would otherwise allocate for each of them
+			std::lock_guard lock(m_injectionMutex);
+			for (std::size_t i = 0; i < MaxWorkerFreeNodes / 2 && m_freeNodes; ++i)
 			{
-				try
-				{
-					task();
-				}
-				catch (const std::exception& e)
-				{
-					std::cerr << "[ThreadPool::Worker#" << workerIndex << "] Exception caught: " << e.what() << '\n';
-				}
-				catch (...)
-				{
-					std::cerr << "[ThreadPool::Worker#" << workerIndex << "] Unknown exception caught\n";
-				}
-				TaskCompleted();
+				TaskNode* node = m_freeNodes;
+				m_freeNodes = node->Next;
+				node->Next = worker.FreeNodes;
+				worker.FreeNodes = node;
+				++worker.FreeNodeCount;
 			}
 		}
+
+		TaskNode* node = worker.FreeNodes;
+		if (!node)
+			return new TaskNode;
+
+		worker.FreeNodes = node->Next;
+		--worker.FreeNodeCount;
+		return node;
+	}
+
+	void ThreadPool::ReleaseNode(Worker* worker, TaskNode* node)
+	{
+		node->Function.Reset();
+		node->Counter = nullptr;
+
+		if (!worker)
+		{
+			std::lock_guard lock(m_injectionMutex);
+			node->Next = m_freeNodes;
+			m_freeNodes = node;
+			return;
+		}
+
+		node->Next = worker->FreeNodes;
+		worker->FreeNodes = node;
+		if (++worker->FreeNodeCount <= MaxWorkerFreeNodes)
+			return;
+
+		// Hands half back so producers running elsewhere can reuse them
+		std::lock_guard lock(m_injectionMutex);
+		for (std::size_t i = 0; i < MaxWorkerFreeNodes / 2; ++i)
+		{
+			TaskNode* released = worker->FreeNodes;
+			worker->FreeNodes = released->Next;
+			released->Next = m_freeNodes;
+			m_freeNodes = released;
+		}
+		worker->FreeNodeCount -= MaxWorkerFreeNodes / 2;
 	}
 
 	void ThreadPool::TaskCompleted() noexcept
@@ -107,35 +582,64 @@ namespace vkd
 		return Wait(deadline);
 	}
 
-	void ThreadPool::RequestStop() noexcept
+	bool ThreadPool::Schedule(TaskFunction&& function, TaskCounter& counter, Priority priority)
 	{
-		bool expected = false;
-		if (!m_stopRequested.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+		if (m_stopRequested.load(std::memory_order_acquire))
+			return false;
+
+		m_tasksInFlight.fetch_add(1, std::memory_order_acq_rel);
+		counter.Add();
+
+		if (!Enqueue(std::move(function), &counter, priority))
 		{
-			// Stop already requested, wait for workers to finish
-			for (auto& worker : m_workers)
-			{
-				if (worker.joinable())
-					worker.join();
-			}
-			return;
+			m_tasksInFlight.fetch_sub(1, std::memory_order_acq_rel);
+			counter.Done();
+			return false;
 		}
+		return true;
+	}
 
-		for (auto& worker : m_workers)
+	void ThreadPool::Wait(const TaskCounter& counter)
+	{
+		// Other threads only take single tasks from the injection queue and steal, their
+		// own tasks go to the injection queue
+		Worker* worker = s_currentWorker && s_currentWorker->Pool == this ? s_currentWorker : nullptr;
+		std::uint32_t randomState = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&counter) >> 4) | 1;
+
+		while (!counter.IsDone())
+		{
+			TaskNode* node = worker ? FindTask(*worker) : nullptr;
+			for (std::size_t lane = 0; !worker && !node && lane < PriorityCount; ++lane)
+				node = TakeTask(nullptr, lane, randomState);
+			if (!node)
+				break; // What is left is running on other threads
+			RunTask(worker, node);
+		}
+
+		counter.Wait();
+	}
+
+	void ThreadPool::RequestStop() noexcept
+	{
+		bool stopping;
 		{
-			worker.request_stop();
+			// Serialized with the injection so no task is queued once workers may exit
+			std::lock_guard lock(m_injectionMutex);
+			bool expected = false;
+			stopping = m_stopRequested.compare_exchange_strong(expected, true, std::memory_order_seq_cst);
 		}
 
+		if (stopping)
 		{
-			std::lock_guard lock(m_queueMutex);
-			m_queueCv.notify_all();
+			m_wakeEpoch.fetch_add(1, std::memory_order_release);
+			Futex::WakeAll(m_wakeEpoch);
 		}
 
 		// Wait for all workers to finish
 		for (auto& worker : m_workers)
 		{
-			if (worker.joinable())
-				worker.join();
+			if (worker->Thread.joinable())
+				worker->Thread.join();
 		}
 	}
 
@@ -144,4 +648,29 @@ namespace vkd
 		return m_workers.size();
 	}
 
+	const std::vector<UInt32>& ThreadPool::GetNumaNodes() const noexcept
+	{
+		return m_numaNodes;
+	}
+
+	std::size_t ThreadPool::GetNumaNodeIndex(const void* address) const noexcept
+	{
+		const std::optional<UInt32> node = System::GetMemoryNumaNode(address);
+		if (!node)
+			return AnyNode;
+
+		auto it = std::ranges::find(m_numaNodes, *node);
+		return it != m_numaNodes.end() ? static_cast<std::size_t>(it - m_numaNodes.begin()) : AnyNode;
+	}
+
+	std::pair<std::size_t, std::size_t> ThreadPool::GetNodeWorkers(std::size_t nodeIndex) const noexcept
+	{
+		return m_nodeWorkers[nodeIndex];
+	}
+
+	const std::vector<UInt32>& ThreadPool::GetWorkerCpus(std::size_t workerIndex) const noexcept
+	{
+		return m_workers[workerIndex]->AffinityCpus;
+	}
+
 } // namespace vkd
@@ -4,28 +4,95 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <concepts>
 #include <condition_variable>
-#include <deque>
-#include <functional>
+#include <cstdint>
 #include <future>
 #include <iostream>
 #include <memory>
 #include <mutex>
-#include <stop_token>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "VkdUtils/System/System.hpp"
+#include "VkdUtils/TaskCounter/TaskCounter.hpp"
+#include "VkdUtils/TaskFunction/TaskFunction.hpp"
+#include "VkdUtils/WorkStealingDeque/WorkStealingDeque.hpp"
+
 namespace vkd
 {
 
+	/**
+	 * @brief Work-stealing thread pool.
+	 *
+	 * Each worker owns a Chase-Lev deque: tasks added from a worker go to its own deque
+	 * and are run newest first, idle workers steal the oldest tasks of a random victim.
+	 * Tasks added from other threads go through a shared injection queue, from which
+	 * workers grab a share at a time. Workers with nothing to run or steal park on a futex.
+	 *
+	 * Tasks are stored as TaskFunction in nodes recycled through per-worker free lists,
+	 * so adding a task whose callable fits inline does not allocate once the pool warmed up.
+	 *
+	 * Given a CPU topology, workers are spread over the NUMA nodes, cores before SMT
+	 * siblings, grouped per node and optionally pinned. Each node has its own injection
+	 * queue and idle workers steal from their own node first.
+	 *
+	 * Tasks are queued in priority lanes, each worker deque and injection queue having one
+	 * per priority. Workers take the highest non-empty lane, except that one task pick in
+	 * StarvationInterval starts at a lower lane so background work still progresses
+	 * under a steady stream of realtime work.
+	 *
+	 * A worker running out of tasks spins before parking, pausing then yielding, so tasks
+	 * arriving shortly after are picked up without a futex wake and producers skip the wake
+	 * while a worker spins. Each worker adapts its spin time to the idle periods it sees,
+	 * up to Options::MaxSpin.
+	 */
 	class ThreadPool
 	{
 	public:
+		enum class Affinity
+		{
+			None,
+			/// Each worker may run on any CPU of its NUMA node
+			NumaNode,
+			/// Each worker is bound to a single CPU
+			Cpu,
+		};
+
+		enum class Priority
+		{
+			/// Queue execution a frame waits on
+			Realtime,
+			Normal,
+			/// Work nothing is waiting on yet, such as compilations ahead of use
+			Background,
+		};
+		static constexpr std::size_t PriorityCount = 3;
+		/// One task pick in this many starts at a lower priority lane
+		static constexpr std::uint32_t StarvationInterval = 16;
+
+		struct Options
+		{
+			/// 0 for one worker per CPU of the topology, or per hardware thread without one
+			unsigned int WorkerCount = 0;
+			/// Only read during construction, null places nothing and sees a single node
+			const CpuTopology* Topology = nullptr;
+			Affinity Pinning = Affinity::Cpu;
+			/// Upper bound of the time an idle worker spins before parking, zero parks right away
+			std::chrono::nanoseconds MaxSpin = std::chrono::microseconds(50);
+		};
+
+		/// Node index of tasks without placement preference
+		static constexpr std::size_t AnyNode = static_cast<std::size_t>(-1);
+
 		explicit ThreadPool(unsigned int numThreads = 0);
+		explicit ThreadPool(const Options& options);
 		~ThreadPool() noexcept;
 
 		ThreadPool(const ThreadPool&) = delete;
@@ -38,12 +105,54 @@ namespace vkd
 		 *
 		 * @tparam F Callable type that can be invoked with no arguments.
 		 * @param f Callable to execute.
+		 * @param priority Lane the task is queued in.
 		 *
 		 * @note This method is thread-safe. Tasks are not accepted after RequestStop().
 		 */
 		template<typename F>
 			requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
-		void AddTask(F&& f);
+		void AddTask(F&& f, Priority priority = Priority::Normal);
+
+		/**
+		 * @brief Adds a task preferably run by the workers of a NUMA node.
+		 *
+		 * @param nodeIndex Index in GetNumaNodes(), as returned by GetNumaNodeIndex(), or AnyNode.
+		 * Other workers still take the task once they have nothing else to do.
+		 */
+		template<typename F>
+			requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
+		void AddTaskOnNode(std::size_t nodeIndex, F&& f, Priority priority = Priority::Normal);
+
+		/**
+		 * @brief Adds a task like AddTask, reporting whether it was accepted.
+		 *
+		 * @return false after RequestStop(), the callable is then destroyed without running.
+		 */
+		template<typename F>
+			requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
+		bool TryAddTask(F&& f, Priority priority = Priority::Normal);
+
+		/**
+		 * @brief Adds a task like TryAddTask, through the injection queues even from a worker.
+		 *
+		 * The task is not pushed to the calling worker's deque where it would run next, it
+		 * waits behind the tasks injected before it. Lets long running work hand its worker
+		 * back, such as a TaskTenant runner at the end of its slice.
+		 */
+		template<typename F>
+			requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
+		bool TryInjectTask(F&& f, Priority priority = Priority::Normal);
+
+		/**
+		 * @brief Adds a task counted on counter, which completes once the task ran.
+		 *
+		 * The allocation-free alternative to Submit when only completion matters. The task
+		 * is counted before being queued, a task refused after RequestStop() completes
+		 * the counter right away without running.
+		 */
+		template<typename F>
+			requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
+		void AddTask(TaskCounter& counter, F&& f, Priority priority = Priority::Normal);
 
 		/**
 		 * @brief Submits a task and returns a future for its result.
@@ -55,7 +164,7 @@ namespace vkd
 		 */
 		template<typename F>
 			requires std::invocable<std::decay_t<F>>
-		auto Submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>>>;
+		auto Submit(F&& f, Priority priority = Priority::Normal) -> std::future<std::invoke_result_t<std::decay_t<F>>>;
 
 		/**
 		 * @brief Waits until all in-flight tasks complete or deadline is reached.
@@ -73,6 +182,28 @@ namespace vkd
 		 */
 		bool WaitFor(std::chrono::milliseconds timeout);
 
+		/**
+		 * @brief Waits until every task counted on counter ran.
+		 *
+		 * Called from a worker of this pool, runs queued tasks meanwhile instead of
+		 * blocking, so a task may wait on the tasks it added.
+		 */
+		void Wait(const TaskCounter& counter);
+
+		/**
+		 * @brief Calls f(chunkBegin, chunkEnd) over chunks covering [begin, end) and waits for all of them.
+		 *
+		 * The range is split in halves, the upper half being queued where idle workers can
+		 * steal it, until a few pieces per worker exist. A stolen piece is split again on
+		 * the thief, so the chunk count adapts to how much the workers are actually idle.
+		 * Chunks are never smaller than grain unless the whole range is. The calling thread runs chunks and helps
+		 * like Wait(const TaskCounter&), so it may be a worker of this pool. After
+		 * RequestStop() the chunks run on the calling thread. Queued pieces use priority.
+		 */
+		template<typename F>
+			requires std::invocable<F&, std::size_t, std::size_t>
+		void ParallelFor(std::size_t begin, std::size_t end, std::size_t grain, F&& f, Priority priority = Priority::Normal);
+
 		/**
 		 * @brief Requests graceful shutdown. No new tasks will be accepted.
 		 *
@@ -83,18 +214,135 @@ namespace vkd
 
 		size_t GetWorkerCount() const noexcept;
 
+		/// NUMA node ids the workers are grouped by, a single 0 without topology
+		[[nodiscard]] const std::vector<UInt32>& GetNumaNodes() const noexcept;
+		/// Index in GetNumaNodes() of the node backing address, AnyNode when unknown or not served
+		[[nodiscard]] std::size_t GetNumaNodeIndex(const void* address) const noexcept;
+		/// Range [first, last) of the workers serving the node at nodeIndex in GetNumaNodes()
+		[[nodiscard]] std::pair<std::size_t, std::size_t> GetNodeWorkers(std::size_t nodeIndex) const noexcept;
+		/// CPUs the worker is pinned to, empty when it is not pinned
+		[[nodiscard]] const std::vector<UInt32>& GetWorkerCpus(std::size_t workerIndex) const noexcept;
+
 	private:
-		void WorkerLoop(std::stop_token stopToken, unsigned int workerIndex);
+		template<typename F>
+		class SubmitTask;
+
+		template<typename F>
+		struct ParallelForState
+		{
+			F* Function;
+			std::size_t Grain;
+			/// Pieces a stolen range is split into again
+			std::size_t StolenSplits;
+			Priority Lane;
+			TaskCounter Counter{};
+		};
+
+		struct TaskNode
+		{
+			TaskFunction Function;
+			TaskCounter* Counter = nullptr;
+			/// Next node in the injection queue or in a free list
+			TaskNode* Next = nullptr;
+		};
+
+		struct Worker
+		{
+			const ThreadPool* Pool = nullptr;
+			unsigned int Index = 0;
+			std::size_t NodeIndex = 0;
+			/// Applied by the worker thread when it starts, empty leaves it unpinned
+			std::vector<UInt32> AffinityCpus;
+			/// One deque per priority
+			std::array<WorkStealingDeque<TaskNode*>, PriorityCount> Deques;
+			std::thread Thread;
+			std::uint32_t RandomState = 0;
+			/// Tasks picked, drives the starvation protection
+			std::uint32_t PickCount = 0;
+			/// Time spun before parking, follows the idle periods observed
+			std::chrono::nanoseconds SpinBudget{0};
+			TaskNode* FreeNodes = nullptr;
+			std::size_t FreeNodeCount = 0;
+		};
+
+		/// Upper bound of the tasks a worker moves from the injection queue to its deque at once
+		static constexpr std::size_t MaxInjectedBatch = 32;
+		/// Free nodes a worker keeps before handing half of them back to the shared list
+		static constexpr std::size_t MaxWorkerFreeNodes = 64;
+		static constexpr std::size_t NormalLane = static_cast<std::size_t>(Priority::Normal);
+		/// Pause instructions between two task lookups of a spinning worker
+		static constexpr std::uint32_t SpinPausesPerLookup = 32;
+
+		struct InjectionQueue
+		{
+			TaskNode* Head = nullptr;
+			TaskNode* Tail = nullptr;
+			std::size_t Count = 0;
+		};
+
+		/// Assigns the workers a node and their CPUs, ordered so that each node's workers are contiguous
+		void PlaceWorkers(const Options& options, unsigned int workerCount);
+
+		/// Pushes to the calling worker's deque, or to an injection queue from other threads, for another node or when inject is set
+		/// @return false once stop was requested, the task is then dropped
+		bool Enqueue(TaskFunction&& function, TaskCounter* counter, Priority priority, std::size_t nodeIndex = AnyNode, bool inject = false);
+		/// AddTask counted on counter, reporting whether the task was accepted
+		bool Schedule(TaskFunction&& function, TaskCounter& counter, Priority priority);
+
+		template<typename F>
+		void RunRange(ParallelForState<F>& state, std::size_t begin, std::size_t end, std::size_t splits);
+
+		void WorkerLoop(unsigned int workerIndex);
+		/// Highest priority task the worker can get, see StarvationInterval
+		TaskNode* FindTask(Worker& worker);
+		/// Spins then parks until a task is found, null once stop was requested
+		TaskNode* WaitForTask(Worker& worker);
+		/// Looks for tasks until the worker's spin budget since idleStart is spent
+		TaskNode* Spin(Worker& worker, std::chrono::steady_clock::time_point idleStart);
+		/// Task of lane from the worker's deque, the injection queues or other workers, worker is null outside the pool
+		TaskNode* TakeTask(Worker* worker, std::size_t lane, std::uint32_t& randomState);
+		/// Without a worker, takes a single task
+		TaskNode* PopInjected(Worker* worker, std::size_t lane);
+		/// thief is null for threads outside the pool
+		TaskNode* Steal(const Worker* thief, std::size_t lane, std::uint32_t& randomState);
+		bool HasWork() const;
+		void Park();
+		void WakeWorker();
+		/// worker is null when a thread outside the pool helps while waiting
+		void RunTask(Worker* worker, TaskNode* node);
+
+		/// Shared free list first, the caller holds m_injectionMutex
+		TaskNode* AcquireNodeLocked();
+		TaskNode* AcquireNode(Worker& worker);
+		void ReleaseNode(Worker* worker, TaskNode* node);
 
 		void TaskCompleted() noexcept;
 
-		// Thread management
-		std::vector<std::jthread> m_workers;
+		// Thread management, workers are only started once all of them exist so every deque can be stolen from
+		std::vector<std::unique_ptr<Worker>> m_workers;
+
+		// NUMA nodes served, with the range of their workers in m_workers
+		std::vector<UInt32> m_numaNodes;
+		std::vector<std::pair<std::size_t, std::size_t>> m_nodeWorkers;
 
-		// Task queue and synchronization
-		std::deque<std::function<void()>> m_taskQueue;
-		std::mutex m_queueMutex;
-		std::condition_variable_any m_queueCv;
+		// Injection queues for tasks added from outside the pool, one per node and priority at
+		// node * PriorityCount + priority, and the shared free nodes, all intrusive
+		std::vector<InjectionQueue> m_injectionQueues;
+		std::size_t m_nextInjectionNode = 0;
+		TaskNode* m_freeNodes = nullptr;
+		std::mutex m_injectionMutex;
+		std::array<std::atomic<size_t>, PriorityCount> m_injectedCounts{};
+
+		// Queued tasks per priority, a hint letting lookups skip empty lanes without probing every deque.
+		// Not kept for the normal lane, where most tasks go and which is probed anyway
+		std::array<std::atomic<size_t>, PriorityCount> m_queuedCounts{};
+
+		// Parking, a wake bumps the epoch the sleepers wait on. Spinning workers find new tasks
+		// without being woken
+		std::atomic<std::uint32_t> m_wakeEpoch{0};
+		std::atomic<std::uint32_t> m_sleepingCount{0};
+		std::atomic<std::uint32_t> m_spinningCount{0};
+		std::chrono::nanoseconds m_maxSpin{0};
 
 		// Wait synchronization
 		std::atomic<size_t> m_tasksInFlight{0};
@@ -103,6 +351,9 @@ namespace vkd
 
 		// State
 		std::atomic<bool> m_stopRequested{false};
+
+		// Worker running on the calling thread, if any, Enqueue routes its tasks to its deque
+		static thread_local Worker* s_currentWorker;
 	};
 
 } // namespace vkd
@@ -6,113 +6,201 @@ namespace vkd
 {
 
 	template<typename F>
-		requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
-	void ThreadPool::AddTask(F&& f)
+	class ThreadPool::SubmitTask
 	{
-		if (m_stopRequested.load(std::memory_order_acquire))
-			return;
+	public:
+		using ReturnType = std::invoke_result_t<F>;
 
-		m_tasksInFlight.fetch_add(1, std::memory_order_acq_rel);
+		template<typename Callable>
+		SubmitTask(std::promise<ReturnType>&& promise, Callable&& f) :
+			m_promise(std::move(promise)),
+			m_function(std::forward<Callable>(f))
+		{
+		}
+
+		SubmitTask(SubmitTask&& other) noexcept(std::is_nothrow_move_constructible_v<F>) :
+			m_promise(std::move(other.m_promise)),
+			m_function(std::move(other.m_function)),
+			m_pending(std::exchange(other.m_pending, false))
+		{
+		}
 
-		auto wrapped = [func = std::forward<F>(f), this]() mutable
+		/// Dropped without running, the pool refused it while stopping
+		~SubmitTask()
 		{
+			if (m_pending)
+				SetException(std::make_exception_ptr(std::runtime_error("ThreadPool is shutting down")));
+		}
+
+		void operator()()
+		{
+			m_pending = false;
 			try
 			{
-				func();
+				if constexpr (std::is_void_v<ReturnType>)
+				{
+					m_function();
+					m_promise.set_value();
+				}
+				else
+				{
+					m_promise.set_value(m_function());
+				}
 			}
-			catch (const std::exception& e)
+			catch (...)
 			{
-				std::cerr << "[ThreadPool] Task threw exception: " << e.what() << '\n';
+				SetException(std::current_exception());
+			}
+		}
+
+	private:
+		void SetException(std::exception_ptr exception) noexcept
+		{
+			try
+			{
+				m_promise.set_exception(std::move(exception));
 			}
 			catch (...)
 			{
-				std::cerr << "[ThreadPool] Task threw unknown exception" << '\n';
 			}
-		};
+		}
 
+		std::promise<ReturnType> m_promise;
+		F m_function;
+		bool m_pending = true;
+	};
+
+	template<typename F>
+		requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
+	void ThreadPool::AddTask(F&& f, Priority priority)
+	{
+		TryAddTask(std::forward<F>(f), priority);
+	}
+
+	template<typename F>
+		requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
+	void ThreadPool::AddTaskOnNode(std::size_t nodeIndex, F&& f, Priority priority)
+	{
+		if (m_stopRequested.load(std::memory_order_acquire))
+			return;
+
+		m_tasksInFlight.fetch_add(1, std::memory_order_acq_rel);
+
+		if (!Enqueue(TaskFunction(std::forward<F>(f)), nullptr, priority, nodeIndex < m_numaNodes.size() ? nodeIndex : AnyNode))
+			m_tasksInFlight.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	template<typename F>
+		requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
+	bool ThreadPool::TryAddTask(F&& f, Priority priority)
+	{
+		if (m_stopRequested.load(std::memory_order_acquire))
+			return false;
+
+		m_tasksInFlight.fetch_add(1, std::memory_order_acq_rel);
+
+		if (!Enqueue(TaskFunction(std::forward<F>(f)), nullptr, priority))
 		{
-			std::lock_guard lock(m_queueMutex);
+			m_tasksInFlight.fetch_sub(1, std::memory_order_acq_rel);
+			return false;
+		}
+		return true;
+	}
 
-			if (m_stopRequested.load(std::memory_order_acquire))
-			{
-				m_tasksInFlight.fetch_sub(1, std::memory_order_acq_rel);
-				return;
-			}
+	template<typename F>
+		requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
+	bool ThreadPool::TryInjectTask(F&& f, Priority priority)
+	{
+		if (m_stopRequested.load(std::memory_order_acquire))
+			return false;
 
-			m_taskQueue.emplace_back(std::move(wrapped));
+		m_tasksInFlight.fetch_add(1, std::memory_order_acq_rel);
+
+		// Queued on the worker's own node, it is still the first place its workers look after their deques
+		const std::size_t nodeIndex = s_currentWorker && s_currentWorker->Pool == this ? s_currentWorker->NodeIndex : AnyNode;
+		if (!Enqueue(TaskFunction(std::forward<F>(f)), nullptr, priority, nodeIndex, true))
+		{
+			m_tasksInFlight.fetch_sub(1, std::memory_order_acq_rel);
+			return false;
 		}
+		return true;
+	}
+
+	template<typename F>
+		requires std::invocable<std::decay_t<F>> && std::is_void_v<std::invoke_result_t<std::decay_t<F>>>
+	void ThreadPool::AddTask(TaskCounter& counter, F&& f, Priority priority)
+	{
+		if (m_stopRequested.load(std::memory_order_acquire))
+			return;
 
-		m_queueCv.notify_one();
+		Schedule(TaskFunction(std::forward<F>(f)), counter, priority);
 	}
 
 	template<typename F>
 		requires std::invocable<std::decay_t<F>>
-	auto ThreadPool::Submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>>>
+	auto ThreadPool::Submit(F&& f, Priority priority) -> std::future<std::invoke_result_t<std::decay_t<F>>>
 	{
 		using ReturnType = std::invoke_result_t<std::decay_t<F>>;
 
-		auto promise = std::make_shared<std::promise<ReturnType>>();
-		auto func = std::make_shared<std::decay_t<F>>(std::forward<F>(f));
-		std::future<ReturnType> result = promise->get_future();
+		std::promise<ReturnType> promise;
+		std::future<ReturnType> result = promise.get_future();
 
 		if (m_stopRequested.load(std::memory_order_acquire))
 		{
-			promise->set_exception(std::make_exception_ptr(std::runtime_error("ThreadPool is shutting down")));
+			promise.set_exception(std::make_exception_ptr(std::runtime_error("ThreadPool is shutting down")));
 			return result;
 		}
 
 		m_tasksInFlight.fetch_add(1, std::memory_order_acq_rel);
 
-		auto wrapped_task = [promise, func]()
-		{
-			try
-			{
-				if constexpr (std::is_void_v<ReturnType>)
-				{
-					(*func)();
-					promise->set_value();
-				}
-				else
-				{
-					promise->set_value((*func)());
-				}
-			}
-			catch (...)
-			{
-				try
-				{
-					promise->set_exception(std::current_exception());
-				}
-				catch (...)
-				{
-				}
-			}
-		};
+		// A refused task reports the shutdown through the promise when it is destroyed
+		if (!Enqueue(TaskFunction(SubmitTask<std::decay_t<F>>(std::move(promise), std::forward<F>(f))), nullptr, priority))
+			m_tasksInFlight.fetch_sub(1, std::memory_order_acq_rel);
 
-		{
-			std::lock_guard lock(m_queueMutex);
+		return result;
+	}
 
-			if (m_stopRequested.load(std::memory_order_acquire))
-			{
-				m_tasksInFlight.fetch_sub(1, std::memory_order_acq_rel);
+	template<typename F>
+		requires std::invocable<F&, std::size_t, std::size_t>
+	void ThreadPool::ParallelFor(std::size_t begin, std::size_t end, std::size_t grain, F&& f, Priority priority)
+	{
+		if (begin >= end)
+			return;
 
-				try
-				{
-					promise->set_exception(std::make_exception_ptr(std::runtime_error("ThreadPool is shutting down")));
-				}
-				catch (...)
-				{
-				}
+		ParallelForState<std::remove_reference_t<F>> state{
+			.Function = &f,
+			.Grain = std::max<std::size_t>(grain, 1),
+			.StolenSplits = m_workers.size(),
+			.Lane = priority,
+		};
 
-				return result;
-			}
+		RunRange(state, begin, end, m_workers.size() * 4);
+		Wait(state.Counter);
+	}
 
-			m_taskQueue.emplace_back(std::move(wrapped_task));
-		}
+	template<typename F>
+	void ThreadPool::RunRange(ParallelForState<F>& state, std::size_t begin, std::size_t end, std::size_t splits)
+	{
+		// Both halves keep at least a grain
+		while (end - begin >= state.Grain * 2 && splits > 1)
+		{
+			const std::size_t middle = begin + (end - begin) / 2;
+			splits /= 2;
 
-		m_queueCv.notify_one();
+			const Worker* splitter = s_currentWorker;
+			auto upperHalf = [this, &state, middle, end, splits, splitter]()
+			{
+				// Run elsewhere than where it was split, the thief was idle and shares its piece again
+				RunRange(state, middle, end, s_currentWorker != splitter ? state.StolenSplits : splits);
+			};
+
+			// Refused while stopping, the rest of the range then runs here
+			if (!Schedule(TaskFunction(std::move(upperHalf)), state.Counter, state.Lane))
+				break;
+			end = middle;
+		}
 
-		return result;
+		(*state.Function)(begin, end);
 	}
 
 } // namespace vkd
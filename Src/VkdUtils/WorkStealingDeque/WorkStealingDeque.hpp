@@ -0,0 +1,77 @@
+/**
+ * @file WorkStealingDeque.hpp
+ * @brief Unbounded lock-free Chase-Lev work-stealing deque
+ * @date 2026-10-16
+ *
+ * The owning thread pushes and pops at the bottom like a stack, any other thread
+ * steals from the top. The owner only synchronizes with thieves when both race for
+ * the last value, so a busy worker runs its own tasks without contention.
+ *
+ * The buffer doubles when full. Thieves may still be reading a replaced buffer, so
+ * replaced buffers are retired and only freed with the deque. Values are copied
+ * through atomics and must be trivially copyable, pointers in practice.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <Concerto/Core/Types/Types.hpp>
+
+namespace vkd
+{
+	using namespace cct;
+
+	template<typename T>
+	class WorkStealingDeque
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque values are copied through atomics");
+
+	public:
+		/// Initial capacity is rounded up to a power of two
+		explicit WorkStealingDeque(std::size_t capacity = 256);
+		~WorkStealingDeque() = default;
+
+		WorkStealingDeque(const WorkStealingDeque&) = delete;
+		WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+		/// Owner only
+		void Push(T value);
+		/// Owner only, pops the most recently pushed value
+		bool TryPop(T& value);
+		/// Thread-safe, takes the oldest value. Fails when empty or when losing a race for it
+		bool TrySteal(T& value);
+
+		/// Approximation when called concurrently
+		[[nodiscard]] inline bool IsEmpty() const;
+		[[nodiscard]] inline std::size_t GetCapacity() const;
+
+	private:
+		static constexpr std::size_t CacheLineSize = 64;
+
+		struct Buffer
+		{
+			explicit Buffer(std::size_t capacity);
+
+			[[nodiscard]] inline T Load(std::int64_t index) const;
+			inline void Store(std::int64_t index, T value);
+
+			std::unique_ptr<std::atomic<T>[]> Values;
+			std::size_t Mask;
+		};
+
+		Buffer* Grow(Buffer* buffer, std::int64_t top, std::int64_t bottom);
+
+		alignas(CacheLineSize) std::atomic<std::int64_t> m_top;
+		alignas(CacheLineSize) std::atomic<std::int64_t> m_bottom;
+		std::atomic<Buffer*> m_buffer;
+		std::vector<std::unique_ptr<Buffer>> m_buffers;
+	};
+} // namespace vkd
+
+#include "VkdUtils/WorkStealingDeque/WorkStealingDeque.inl"
@@ -0,0 +1,125 @@
+/**
+ * @file WorkStealingDeque.inl
+ * @brief Inline implementations for WorkStealingDeque
+ * @date 2026-10-16
+ */
+
+#pragma once
+
+#include <bit>
+
+#include "VkdUtils/WorkStealingDeque/WorkStealingDeque.hpp"
+
+namespace vkd
+{
+	template<typename T>
+	WorkStealingDeque<T>::Buffer::Buffer(std::size_t capacity) :
+		Values(std::make_unique<std::atomic<T>[]>(capacity)),
+		Mask(capacity - 1)
+	{
+	}
+
+	template<typename T>
+	inline T WorkStealingDeque<T>::Buffer::Load(std::int64_t index) const
+	{
+		return Values[static_cast<std::size_t>(index) & Mask].load(std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	inline void WorkStealingDeque<T>::Buffer::Store(std::int64_t index, T value)
+	{
+		Values[static_cast<std::size_t>(index) & Mask].store(value, std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	WorkStealingDeque<T>::WorkStealingDeque(std::size_t capacity) :
+		m_top(0),
+		m_bottom(0)
+	{
+		m_buffers.push_back(std::make_unique<Buffer>(std::bit_ceil(capacity < 2 ? std::size_t(2) : capacity)));
+		m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	void WorkStealingDeque<T>::Push(T value)
+	{
+		const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+		const std::int64_t top = m_top.load(std::memory_order_acquire);
+		Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+		if (bottom - top > static_cast<std::int64_t>(buffer->Mask))
+			buffer = Grow(buffer, top, bottom);
+
+		buffer->Store(bottom, value);
+		// Publishes the value to thieves. Sequentially consistent so that a thread pushing
+		// and then checking for sleeping workers cannot miss one that checked this deque
+		m_bottom.store(bottom + 1, std::memory_order_seq_cst);
+	}
+
+	template<typename T>
+	bool WorkStealingDeque<T>::TryPop(T& value)
+	{
+		const std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+		Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+		// Claims the bottom slot before looking at top, thieves do the opposite
+		m_bottom.store(bottom, std::memory_order_seq_cst);
+		std::int64_t top = m_top.load(std::memory_order_seq_cst);
+
+		if (top > bottom)
+		{
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		value = buffer->Load(bottom);
+		if (top == bottom)
+		{
+			// Last value, a thief may be taking it through top as well
+			const bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	template<typename T>
+	bool WorkStealingDeque<T>::TrySteal(T& value)
+	{
+		std::int64_t top = m_top.load(std::memory_order_seq_cst);
+		const std::int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+		if (top >= bottom)
+			return false;
+
+		const Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+		const T stolen = buffer->Load(top);
+		if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return false;
+
+		value = stolen;
+		return true;
+	}
+
+	template<typename T>
+	inline bool WorkStealingDeque<T>::IsEmpty() const
+	{
+		return m_top.load(std::memory_order_seq_cst) >= m_bottom.load(std::memory_order_seq_cst);
+	}
+
+	template<typename T>
+	inline std::size_t WorkStealingDeque<T>::GetCapacity() const
+	{
+		return m_buffer.load(std::memory_order_relaxed)->Mask + 1;
+	}
+
+	template<typename T>
+	typename WorkStealingDeque<T>::Buffer* WorkStealingDeque<T>::Grow(Buffer* buffer, std::int64_t top, std::int64_t bottom)
+	{
+		auto grown = std::make_unique<Buffer>((buffer->Mask + 1) * 2);
+		for (std::int64_t i = top; i < bottom; ++i)
+			grown->Store(i, buffer->Load(i));
+
+		Buffer* result = grown.get();
+		m_buffers.push_back(std::move(grown));
+		m_buffer.store(result, std::memory_order_release);
+		return result;
+	}
+} // namespace vkd
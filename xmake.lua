@@ -60,6 +60,7 @@ drivers = {
             ".",
             "Buffer",
             "BufferView",
+            "Capture",
             "CommandBuffer",
             "CommandDispatcher",
             "CommandPool",
@@ -74,7 +75,9 @@ drivers = {
             "RenderPass",
             "ShaderModule",
             "Synchronization",
+            "Synchronization/Event",
             "Synchronization/Fence",
+            "Synchronization/Semaphore",
         },
         Packages = { {"concerto-core", public = false}, {"vulkan-headers", public = true}},
         Deps = {},
@@ -94,9 +97,21 @@ target("vkd-Utils")
     local files = {
         ".",
         "Allocator",
+        "Futex",
+        "MappedFile",
         "Memory",
+        "MpscRing",
+        "ScratchArena",
+        "SyncWaiter",
         "System",
+        "Task",
+        "TaskCounter",
+        "TaskFunction",
+        "TaskGraph",
+        "TaskGroup",
+        "TaskTenant",
         "ThreadPool",
+        "WorkStealingDeque",
     }
     for _, dir in ipairs(files) do
         add_files_to_target("Src/VkdUtils/" .. dir, false)
@@ -105,6 +120,9 @@ target("vkd-Utils")
     if is_plat("mingw", "linux", "macosx", "bsd") then
         add_syslinks("pthread")
     end
+    if is_plat("windows", "mingw") then
+        add_syslinks("synchronization")
+    end
 
     -- macOS: ensure we link against the correct C++ runtime when using custom toolchain
     if is_plat("macosx") then
@@ -161,7 +179,9 @@ target("vkd")
         "RenderPass",
         "ShaderModule",
         "Synchronization",
+        "Synchronization/Event",
         "Synchronization/Fence",
+        "Synchronization/Semaphore",
     }
     for _, dir in ipairs(files) do
         add_files_to_target("Src/Vkd/" .. dir, false)
@@ -225,14 +245,37 @@ for driver_name, driver in pairs(drivers) do
     target_end()
 end
 
+-- Replays VKD_CAPTURE traces, the software driver is linked in statically to time its dispatcher directly
+target("vkd-replay")
+    set_kind("binary")
+    set_languages("c++20")
+    add_defines("VKD_SOFTWARE_BUILD", "VK_NO_PROTOTYPES")
+    add_includedirs("Src/", { public = true })
+    add_packages("concerto-core", "vulkan-headers", "vulkan-utility-libraries")
+    for _, dir in ipairs(drivers.Software.Files) do
+        -- The ICD exports are left out, the replayer calls the entry points directly
+        if dir ~= "." then
+            add_files_to_target("Src/VkdSoftware/" .. dir, false)
+        end
+    end
+    add_files("Src/VkdReplay/*.cpp")
+    add_headerfiles("Src/(VkdReplay/*.hpp)")
+    add_deps("vkd")
+
+    if is_plat("mingw", "linux", "macosx", "bsd") then
+        add_syslinks("pthread")
+    end
+target_end()
+
 if has_config("tests") then
     target("vkd-tests")
         set_languages("c++20")
         set_kind("binary")
         add_includedirs("Src", { public = true })
-        add_packages("catch2")
+        add_packages("catch2", "vulkan-headers", "vulkan-utility-libraries")
+        add_defines("VK_NO_PROTOTYPES")
         add_files("Src/Tests/**.cpp")
-        add_deps("vkd-Utils")
+        add_deps("vkd")
     target_end()
 
     target("vkd-test-app")